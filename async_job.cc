@@ -0,0 +1,131 @@
+#include "async_job.h"
+#include <exception>
+
+AsyncJob::AsyncJob(const Napi::CallbackInfo &info, ExecuteFn execute, ReleaseFn release, CompleteFn complete)
+    : Napi::AsyncWorker(info.Env(), "voicevox"),
+      deferred_(Napi::Promise::Deferred::New(info.Env())),
+      self_(Napi::Persistent(info.This().ToObject())),
+      execute_(std::move(execute)),
+      release_(std::move(release)),
+      complete_(std::move(complete))
+{
+}
+
+Napi::Promise AsyncJob::Queue(const Napi::CallbackInfo &info, ExecuteFn execute, ReleaseFn release, CompleteFn complete)
+{
+  // AsyncWorkerは完了後に自身をdeleteする
+  AsyncJob *job = new AsyncJob(info, std::move(execute), std::move(release), std::move(complete));
+  Napi::Promise promise = job->deferred_.Promise();
+  job->Napi::AsyncWorker::Queue();
+  return promise;
+}
+
+void AsyncJob::Execute()
+{
+  try
+  {
+    execute_();
+  }
+  catch (const std::exception &e)
+  {
+    SetError(e.what());
+  }
+  catch (const char *e)
+  {
+    // Windowsのload_funcは文字列を投げる
+    SetError(e);
+  }
+}
+
+void AsyncJob::OnOK()
+{
+  Napi::Env env = Env();
+  if (release_)
+    release_();
+  try
+  {
+    deferred_.Resolve(complete_ ? complete_(env) : env.Undefined());
+  }
+  catch (const Napi::Error &e)
+  {
+    deferred_.Reject(e.Value());
+  }
+}
+
+void AsyncJob::OnError(const Napi::Error &e)
+{
+  if (release_)
+    release_();
+  deferred_.Reject(e.Value());
+}
+
+ThreadJob::ThreadJob(const Napi::CallbackInfo &info, AsyncJob::ExecuteFn execute, AsyncJob::ReleaseFn release, AsyncJob::CompleteFn complete)
+    : deferred_(Napi::Promise::Deferred::New(info.Env())),
+      self_(Napi::Persistent(info.This().ToObject())),
+      execute_(std::move(execute)),
+      release_(std::move(release)),
+      complete_(std::move(complete))
+{
+}
+
+Napi::Promise ThreadJob::Start(const Napi::CallbackInfo &info, AsyncJob::ExecuteFn execute, AsyncJob::ReleaseFn release, AsyncJob::CompleteFn complete)
+{
+  // ThreadSafeFunctionの終了時に自身をdeleteする。JSの関数は呼ばないため渡さない
+  ThreadJob *job = new ThreadJob(info, std::move(execute), std::move(release), std::move(complete));
+  Napi::Promise promise = job->deferred_.Promise();
+  job->tsfn_ = Napi::ThreadSafeFunction::New(info.Env(), Napi::Function(), "voicevoxThread", 0, 1, job, ThreadJob::finalize);
+  job->thread_ = std::thread(&ThreadJob::run, job);
+  return promise;
+}
+
+void ThreadJob::run()
+{
+  try
+  {
+    execute_();
+  }
+  catch (const std::exception &e)
+  {
+    failed_ = true;
+    error_ = e.what();
+  }
+  catch (const char *e)
+  {
+    // Windowsのload_funcは文字列を投げる
+    failed_ = true;
+    error_ = e;
+  }
+  tsfn_.BlockingCall([this](Napi::Env env, Napi::Function)
+                     {
+                       if (static_cast<napi_env>(env) != nullptr)
+                         settle(env);
+                     });
+  tsfn_.Release();
+}
+
+void ThreadJob::settle(Napi::Env env)
+{
+  if (release_)
+    release_();
+  if (failed_)
+  {
+    deferred_.Reject(Napi::Error::New(env, error_).Value());
+    return;
+  }
+  try
+  {
+    deferred_.Resolve(complete_ ? complete_(env) : env.Undefined());
+  }
+  catch (const Napi::Error &e)
+  {
+    deferred_.Reject(e.Value());
+  }
+}
+
+void ThreadJob::finalize(Napi::Env, ThreadJob *job)
+{
+  if (job->thread_.joinable())
+    job->thread_.join();
+  job->self_.Reset();
+  delete job;
+}
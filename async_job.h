@@ -0,0 +1,79 @@
+/**
+ * @file async_job.h
+ *
+ * voicevox_coreの関数をlibuvのスレッドプールで実行し、結果をPromiseで返す。
+ *
+ * - `execute`はワーカースレッドで実行される。N-APIの値には触れないこと
+ * - `release`はメインスレッドで、成功・失敗に関わらず`complete`より先に必ず実行される(使用中の印を外すなど)
+ * - `complete`はメインスレッドで実行され、戻り値でPromiseを解決する
+ *
+ * 実行中は呼び出し元のJavaScriptのオブジェクト(`info.This()`)への参照を保持し、
+ * voicevox_coreが解放されないようにする。
+ *
+ * ::ThreadJob は同じ約束で、スレッドプールではなく専用のスレッドで実行する。
+ * ソケットへの書き込みなど、相手次第で長く待つ可能性がある処理でスレッドプールを塞がないために使う。
+ */
+#ifndef VOICEVOX_ASYNC_JOB
+#define VOICEVOX_ASYNC_JOB
+
+#include <napi.h>
+#include <functional>
+#include <string>
+#include <thread>
+
+class AsyncJob : public Napi::AsyncWorker
+{
+public:
+  typedef std::function<void()> ExecuteFn;
+  typedef std::function<void()> ReleaseFn;
+  typedef std::function<Napi::Value(Napi::Env)> CompleteFn;
+
+  /**
+   * ジョブを作成してキューに入れる
+   * @return ジョブの結果で解決されるPromise
+   */
+  static Napi::Promise Queue(const Napi::CallbackInfo &info, ExecuteFn execute, ReleaseFn release, CompleteFn complete);
+
+protected:
+  void Execute() override;
+  void OnOK() override;
+  void OnError(const Napi::Error &e) override;
+
+private:
+  AsyncJob(const Napi::CallbackInfo &info, ExecuteFn execute, ReleaseFn release, CompleteFn complete);
+
+  Napi::Promise::Deferred deferred_;
+  Napi::ObjectReference self_;
+  ExecuteFn execute_;
+  ReleaseFn release_;
+  CompleteFn complete_;
+};
+
+class ThreadJob
+{
+public:
+  /**
+   * 専用のスレッドを開始する。引数は::AsyncJob::Queue と同じ
+   * @return ジョブの結果で解決されるPromise
+   */
+  static Napi::Promise Start(const Napi::CallbackInfo &info, AsyncJob::ExecuteFn execute, AsyncJob::ReleaseFn release, AsyncJob::CompleteFn complete);
+
+private:
+  ThreadJob(const Napi::CallbackInfo &info, AsyncJob::ExecuteFn execute, AsyncJob::ReleaseFn release, AsyncJob::CompleteFn complete);
+
+  void run();
+  void settle(Napi::Env env);
+  static void finalize(Napi::Env env, ThreadJob *job);
+
+  Napi::Promise::Deferred deferred_;
+  Napi::ObjectReference self_;
+  AsyncJob::ExecuteFn execute_;
+  AsyncJob::ReleaseFn release_;
+  AsyncJob::CompleteFn complete_;
+  Napi::ThreadSafeFunction tsfn_;
+  std::thread thread_;
+  bool failed_ = false;
+  std::string error_;
+};
+
+#endif /* VOICEVOX_ASYNC_JOB */
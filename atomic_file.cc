@@ -0,0 +1,152 @@
+#include "atomic_file.h"
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  // 少しずつ書く場合の1回あたりのバイト数
+  const size_t CHUNK_BYTES = 64 * 1024;
+
+  /**
+   * ファイルの内容をディスクへ書き出す(置き換えた後に電源が落ちても空のファイルにならないように)
+   */
+  bool sync_file(const std::string &path)
+  {
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+      return false;
+    bool result = FlushFileBuffers(handle) != 0;
+    CloseHandle(handle);
+    return result;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    bool result = fsync(fd) == 0;
+    close(fd);
+    return result;
+#endif
+  }
+
+  /**
+   * `path`のあるディレクトリをディスクへ書き出す(置き換えたこと自体を残すため)。
+   * Windowsでは`MOVEFILE_WRITE_THROUGH`で足りる。ディレクトリのfsyncに対応しないファイルシステムもあるため、失敗しても無視する
+   */
+  void sync_parent_directory(const std::string &path)
+  {
+#ifndef _WIN32
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    fsync(fd);
+    close(fd);
+#else
+    (void)path;
+#endif
+  }
+
+  /**
+   * 一時ファイルを、既にあれば失敗するように作る
+   */
+  FILE *create_temporary(const std::string &tmp)
+  {
+    // "x"はC11で、既にあるファイルを開かない
+    return fopen(tmp.c_str(), "wbx");
+  }
+}
+
+std::string temporary_path(const std::string &path)
+{
+  static std::atomic<uint64_t> counter(0);
+#ifdef _WIN32
+  int pid = _getpid();
+#else
+  int pid = static_cast<int>(getpid());
+#endif
+  return path + "." + std::to_string(pid) + "." + std::to_string(counter.fetch_add(1)) + ".tmp";
+}
+
+bool replace_file(const std::string &from, const std::string &to, std::string &error)
+{
+  if (!sync_file(from))
+  {
+    std::remove(from.c_str());
+    error = "ファイルをディスクへ書き出せませんでした: " + from;
+    return false;
+  }
+#ifdef _WIN32
+  bool replaced = MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+  bool replaced = std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+  if (!replaced)
+  {
+    std::remove(from.c_str());
+    error = "ファイルを置き換えられませんでした: " + to;
+    return false;
+  }
+  sync_parent_directory(to);
+  return true;
+}
+
+bool write_file_atomic(const std::string &path, const char *data, size_t size, std::string &error)
+{
+  std::string tmp = temporary_path(path);
+  FILE *file = create_temporary(tmp);
+  if (file == nullptr)
+  {
+    error = "ファイルを開けませんでした: " + tmp;
+    return false;
+  }
+  bool written = fwrite(data, 1, size, file) == size;
+  written = fclose(file) == 0 && written;
+  if (!written)
+  {
+    std::remove(tmp.c_str());
+    error = "ファイルに書き込めませんでした: " + tmp;
+    return false;
+  }
+  return replace_file(tmp, path, error);
+}
+
+bool write_file_atomic(const std::string &path, const std::function<size_t(uint8_t *buffer, size_t capacity)> &fill, uint64_t &written, std::string &error)
+{
+  std::string tmp = temporary_path(path);
+  FILE *file = create_temporary(tmp);
+  if (file == nullptr)
+  {
+    error = "ファイルを開けませんでした: " + tmp;
+    return false;
+  }
+  std::vector<uint8_t> buffer(CHUNK_BYTES);
+  written = 0;
+  bool ok = true;
+  while (ok)
+  {
+    size_t size = fill(buffer.data(), buffer.size());
+    if (size == 0)
+      break;
+    ok = fwrite(buffer.data(), 1, size, file) == size;
+    written += size;
+  }
+  ok = fclose(file) == 0 && ok;
+  if (!ok)
+  {
+    std::remove(tmp.c_str());
+    error = "ファイルに書き込めませんでした: " + tmp;
+    return false;
+  }
+  return replace_file(tmp, path, error);
+}
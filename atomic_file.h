@@ -0,0 +1,43 @@
+/**
+ * @file atomic_file.h
+ *
+ * 一時ファイルへ書き込んでから置き換えることで、途中で落ちても書きかけのファイルが残らないようにする。
+ *
+ * 一時ファイルは`path`と同じディレクトリに作る(同じファイルシステム内でないと置き換えが不可分にならないため)。
+ * 名前にはプロセスIDと連番を付け、同じ`path`へ同時に書き込んでも一時ファイルを取り合わないようにする(最後に置き換えたものが残る)。
+ * 置き換えた後はディレクトリもディスクへ書き出し、電源が落ちても置き換えが失われないようにする。
+ */
+#ifndef VOICEVOX_ATOMIC_FILE
+#define VOICEVOX_ATOMIC_FILE
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * `path`を置き換えるための一時ファイルのパス。呼ぶたびに別のパスを返す
+ */
+std::string temporary_path(const std::string &path);
+
+/**
+ * 書き込み済みのファイルをディスクへ書き出してから、`from`で`to`を置き換える
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する。`from`は削除する
+ */
+bool replace_file(const std::string &from, const std::string &to, std::string &error);
+
+/**
+ * `data`を一時ファイルへ書き込み、`path`を置き換える
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する。`path`は元のまま
+ */
+bool write_file_atomic(const std::string &path, const char *data, size_t size, std::string &error);
+
+/**
+ * `fill`が0を返すまで、`fill`が書いた内容を一時ファイルへ順に書き込み、`path`を置き換える。全体をメモリに持たずに書く場合に使う
+ * @param fill `buffer`に最大`capacity`バイト書き、書いたバイト数を返す
+ * @param written 書き込んだバイト数
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する。`path`は元のまま
+ */
+bool write_file_atomic(const std::string &path, const std::function<size_t(uint8_t *buffer, size_t capacity)> &fill, uint64_t &written, std::string &error);
+
+#endif /* VOICEVOX_ATOMIC_FILE */
@@ -0,0 +1,238 @@
+#include "audio_output.h"
+#include "g711.h"
+#include "resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+  // 1回の変換で作るフレームの数の上限
+  const size_t CHUNK_FRAMES = 4096;
+
+  size_t ms_to_frames(uint32_t ms, uint32_t rate)
+  {
+    return static_cast<size_t>(static_cast<uint64_t>(ms) * rate / 1000);
+  }
+
+  /**
+   * 全チャンネルの絶対値が`threshold`以下のフレームかどうか
+   */
+  bool is_silent(const int16_t *frame, uint16_t channels, int32_t threshold)
+  {
+    for (uint16_t channel = 0; channel < channels; channel++)
+      if (std::abs(static_cast<int32_t>(frame[channel])) > threshold)
+        return false;
+    return true;
+  }
+}
+
+bool AudioOutputEncoder::open(const uint8_t *wav, size_t size, const AudioOutputSpec &spec, std::string &error)
+{
+  if (spec.format > AUDIO_OUTPUT_WAV_STREAM)
+  {
+    error = "対応していない出力形式です";
+    return false;
+  }
+  WavFormat input;
+  if (!wav_parse(wav, size, input, error))
+    return false;
+  if (input.format != WAV_FORMAT_PCM || input.bits_per_sample != 16 || input.channels == 0)
+  {
+    error = "16ビットリニアPCMのWAVではありません";
+    return false;
+  }
+  bool g711 = spec.format == AUDIO_OUTPUT_ULAW || spec.format == AUDIO_OUTPUT_ALAW;
+  uint32_t rate = spec.sample_rate;
+  if (rate == 0)
+    rate = g711 ? AUDIO_OUTPUT_G711_RATE : input.sample_rate;
+  resampler_.reset();
+  if (rate != input.sample_rate)
+  {
+    resampler_ = Resampler::get(input.sample_rate, rate);
+    if (!resampler_)
+    {
+      error = "対応していないサンプリングレートの組です: " + std::to_string(input.sample_rate) + " -> " + std::to_string(rate);
+      return false;
+    }
+  }
+  input_frames_ = input.data_size / (2 * input.channels);
+  input_channels_ = input.channels;
+  const uint8_t *data = wav + input.data_offset;
+  if (reinterpret_cast<uintptr_t>(data) % alignof(int16_t) == 0)
+  {
+    aligned_.clear();
+    input_ = reinterpret_cast<const int16_t *>(data);
+  }
+  else
+  {
+    aligned_.resize(input_frames_ * input_channels_);
+    std::memcpy(aligned_.data(), data, aligned_.size() * 2);
+    input_ = aligned_.data();
+  }
+  if (spec.trim)
+  {
+    int32_t threshold = static_cast<int32_t>(32768.0 * std::pow(10.0, spec.trim_threshold_db / 20.0));
+    size_t first = 0;
+    while (first < input_frames_ && is_silent(input_ + first * input_channels_, input_channels_, threshold))
+      first++;
+    size_t last = input_frames_;
+    while (last > first && is_silent(input_ + (last - 1) * input_channels_, input_channels_, threshold))
+      last--;
+    // 全て無音なら何も残さない
+    if (last > first)
+    {
+      size_t margin = ms_to_frames(spec.trim_margin_ms, input.sample_rate);
+      first = first > margin ? first - margin : 0;
+      last = std::min(input_frames_, last + margin);
+    }
+    input_ += first * input_channels_;
+    input_frames_ = last - first;
+  }
+  normalize_ = spec.normalize;
+  if (normalize_)
+  {
+    measured_loudness_ = loudness_measure(input_, input_frames_, input_channels_, input.sample_rate);
+    normalizer_.start(measured_loudness_, spec.target_loudness, rate);
+  }
+  output_format_ = spec.format;
+  voiced_frames_ = resampler_ ? resampler_->output_frames(input_frames_) : input_frames_;
+  pad_start_frames_ = ms_to_frames(spec.pad_start_ms, rate);
+  output_frames_ = pad_start_frames_ + voiced_frames_ + ms_to_frames(spec.pad_end_ms, rate);
+  fade_in_frames_ = std::min(ms_to_frames(spec.fade_in_ms, rate), voiced_frames_);
+  fade_out_frames_ = std::min(ms_to_frames(spec.fade_out_ms, rate), voiced_frames_);
+  next_frame_ = 0;
+  header_written_ = 0;
+  bool riff = spec.format == AUDIO_OUTPUT_WAV || spec.format == AUDIO_OUTPUT_WAV_STREAM;
+  if (spec.format == AUDIO_OUTPUT_PCM || riff)
+    format_.format = WAV_FORMAT_PCM;
+  else
+    format_.format = spec.format == AUDIO_OUTPUT_ULAW ? WAV_FORMAT_MULAW : WAV_FORMAT_ALAW;
+  format_.channels = g711 ? 1 : input.channels;
+  format_.sample_rate = rate;
+  format_.bits_per_sample = g711 ? 8 : 16;
+  format_.data_offset = riff ? WAV_HEADER_SIZE : 0;
+  format_.data_size = output_frames_ * format_.channels * (format_.bits_per_sample / 8);
+  if (spec.format == AUDIO_OUTPUT_WAV)
+    wav_write_header(header_, WAV_FORMAT_PCM, format_.channels, rate, 16, static_cast<uint32_t>(format_.data_size));
+  else if (spec.format == AUDIO_OUTPUT_WAV_STREAM)
+    wav_write_streaming_header(header_, WAV_FORMAT_PCM, format_.channels, rate, 16);
+  // 出力のヘッダが入力のヘッダに収まり、1フレームのバイト数が増えなければ、書く位置は読む位置を追い越さない
+  in_place_ = !resampler_ && output_frames_ == voiced_frames_ && format_.data_offset <= input.data_offset &&
+              format_.channels * (format_.bits_per_sample / 8) <= input_channels_ * 2u;
+  return true;
+}
+
+size_t AudioOutputEncoder::read(uint8_t *out, size_t max_bytes)
+{
+  size_t written = 0;
+  if (header_written_ < format_.data_offset)
+  {
+    written = std::min(format_.data_offset - header_written_, max_bytes);
+    std::memcpy(out, header_ + header_written_, written);
+    header_written_ += written;
+    if (header_written_ < format_.data_offset)
+      return written;
+  }
+  size_t frame_bytes = format_.channels * (format_.bits_per_sample / 8);
+  // 前後の無音と音声は別々のチャンクにする
+  size_t voiced_end = pad_start_frames_ + voiced_frames_;
+  size_t region_end = next_frame_ < pad_start_frames_ ? pad_start_frames_ : next_frame_ < voiced_end ? voiced_end : output_frames_;
+  size_t frames = std::min({region_end - next_frame_, (max_bytes - written) / frame_bytes, CHUNK_FRAMES});
+  if (frames == 0)
+    return written;
+  bool voiced = next_frame_ >= pad_start_frames_ && next_frame_ < voiced_end;
+  size_t voiced_frame = next_frame_ - pad_start_frames_;
+  samples_.resize(frames * input_channels_);
+  if (!voiced)
+    std::fill(samples_.begin(), samples_.end(), static_cast<int16_t>(0));
+  else if (resampler_)
+    resampler_->process_range(input_, input_frames_, input_channels_, voiced_frame, frames, samples_.data());
+  else
+    std::memcpy(samples_.data(), input_ + voiced_frame * input_channels_, samples_.size() * 2);
+  next_frame_ += frames;
+  if (format_.channels != input_channels_)
+  {
+    // モノラルにする(変換は線形のため、サンプリングレートの変換の後に平均しても同じ)
+    for (size_t i = 0; i < frames; i++)
+    {
+      int32_t sum = 0;
+      for (uint16_t channel = 0; channel < input_channels_; channel++)
+        sum += samples_[i * input_channels_ + channel];
+      samples_[i] = static_cast<int16_t>(sum / input_channels_);
+    }
+  }
+  size_t count = frames * format_.channels;
+  if (voiced && normalize_)
+    normalizer_.process(samples_.data(), frames, format_.channels);
+  if (voiced && (voiced_frame < fade_in_frames_ || voiced_frame + frames > voiced_frames_ - fade_out_frames_))
+    apply_fades(voiced_frame, frames);
+  uint8_t *dest = out + written;
+  if (output_format_ == AUDIO_OUTPUT_ULAW)
+    g711_encode_ulaw(samples_.data(), count, dest);
+  else if (output_format_ == AUDIO_OUTPUT_ALAW)
+    g711_encode_alaw(samples_.data(), count, dest);
+  else
+    std::memcpy(dest, samples_.data(), count * 2);
+  return written + count * (format_.bits_per_sample / 8);
+}
+
+void AudioOutputEncoder::apply_fades(size_t voiced_frame, size_t frames)
+{
+  uint16_t channels = format_.channels;
+  for (size_t i = 0; i < frames; i++)
+  {
+    size_t position = voiced_frame + i;
+    float gain = 1.0f;
+    if (position < fade_in_frames_)
+      gain = static_cast<float>(position) / fade_in_frames_;
+    size_t remaining = voiced_frames_ - position;
+    if (remaining <= fade_out_frames_)
+      gain = std::min(gain, static_cast<float>(remaining - 1) / fade_out_frames_);
+    if (gain == 1.0f)
+      continue;
+    for (uint16_t channel = 0; channel < channels; channel++)
+    {
+      int16_t &sample = samples_[i * channels + channel];
+      sample = static_cast<int16_t>(std::lrint(sample * gain));
+    }
+  }
+}
+
+bool encode_audio_output(const uint8_t *wav, size_t size, const AudioOutputSpec &spec, std::vector<uint8_t> &out, std::string &error, WavFormat *encoded_format)
+{
+  AudioOutputEncoder encoder;
+  if (!encoder.open(wav, size, spec, error))
+    return false;
+  out.resize(encoder.total_bytes());
+  size_t offset = 0;
+  while (!encoder.finished())
+    offset += encoder.read(out.data() + offset, out.size() - offset);
+  if (encoded_format != nullptr)
+    *encoded_format = encoder.format();
+  return true;
+}
+
+bool encode_audio_output_in_place(uint8_t *wav, size_t &size, const AudioOutputSpec &spec, bool &in_place, std::vector<uint8_t> &out, std::string &error, WavFormat *encoded_format)
+{
+  AudioOutputEncoder encoder;
+  if (!encoder.open(wav, size, spec, error))
+    return false;
+  in_place = encoder.fits_in_place();
+  uint8_t *dest = wav;
+  size_t total = encoder.total_bytes();
+  if (!in_place)
+  {
+    out.resize(total);
+    dest = out.data();
+  }
+  size_t offset = 0;
+  while (!encoder.finished())
+    offset += encoder.read(dest + offset, total - offset);
+  if (in_place)
+    size = total;
+  if (encoded_format != nullptr)
+    *encoded_format = encoder.format();
+  return true;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file audio_output.h
+ *
+ * 合成したWAVを、呼び出し側が指定した形式(サンプリングレート・WAVかG.711か)に変換する。
+ *
+ * 合成と同じワーカースレッドで行い、JSには変換後のバイト列だけを渡す。
+ * G.711はヘッダを付けない生のバイト列(1サンプル1バイト、モノラル)で、そのままRTPのペイロードにできる。
+ * ::AUDIO_OUTPUT_PCM はヘッダを付けない16ビットリニアPCM(チャンネル数は元のまま)。
+ *
+ * ::AudioOutputEncoder は少しずつ変換するため、ストリームやファイルへの出力で変換後の全体を持たずに済む。
+ * ラウドネスの正規化(::LoudnessNormalizer)は、開くときに元の音声全体を測り、変換したチャンクごとに利得とリミッタをかける。
+ *
+ * 後処理(無音の切り詰め・フェード・無音の追加)も同じ1回の変換で行い、途中の音声全体を作らない。
+ * 後処理は切り詰め→サンプリングレートの変換→正規化→フェード→無音の追加の順にかかる。
+ */
+#ifndef VOICEVOX_AUDIO_OUTPUT
+#define VOICEVOX_AUDIO_OUTPUT
+
+#include "loudness.h"
+#include "wav.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define AUDIO_OUTPUT_WAV 0
+#define AUDIO_OUTPUT_ULAW 1
+#define AUDIO_OUTPUT_ALAW 2
+#define AUDIO_OUTPUT_PCM 3
+// 大きさの欄を::WAV_STREAMING_SIZE にしたヘッダのWAV
+#define AUDIO_OUTPUT_WAV_STREAM 4
+// G.711でサンプリングレートを指定しなかった場合のレート
+#define AUDIO_OUTPUT_G711_RATE 8000
+// 後処理で指定できる長さ(ミリ秒)の上限
+#define AUDIO_OUTPUT_MAX_POST_MS 60000
+
+class Resampler;
+
+struct AudioOutputSpec
+{
+  /** 0の場合は変換しない(G.711では::AUDIO_OUTPUT_G711_RATE) */
+  uint32_t sample_rate = 0;
+  /** `AUDIO_OUTPUT_*` */
+  uint32_t format = AUDIO_OUTPUT_WAV;
+  /** ラウドネスを`target_loudness`(LUFS)に揃えるかどうか */
+  bool normalize = false;
+  double target_loudness = 0.0;
+  /** 前後の、全チャンネルが`trim_threshold_db`(dBFS)以下の区間を切り詰めるかどうか。`trim_margin_ms`だけは残す */
+  bool trim = false;
+  double trim_threshold_db = -50.0;
+  uint32_t trim_margin_ms = 0;
+  /** 線形のフェードイン・フェードアウトの長さ(切り詰め・追加した無音を除いた音声の両端) */
+  uint32_t fade_in_ms = 0;
+  uint32_t fade_out_ms = 0;
+  /** 前後に足す無音の長さ */
+  uint32_t pad_start_ms = 0;
+  uint32_t pad_end_ms = 0;
+
+  /**
+   * 後処理(切り詰め・フェード・無音の追加)をするかどうか
+   */
+  bool post_process() const
+  {
+    return trim || fade_in_ms != 0 || fade_out_ms != 0 || pad_start_ms != 0 || pad_end_ms != 0;
+  }
+
+  /**
+   * voicevox_coreの出力をそのまま返せるかどうか
+   */
+  bool passthrough() const
+  {
+    return sample_rate == 0 && format == AUDIO_OUTPUT_WAV && !normalize && !post_process();
+  }
+};
+
+class AudioOutputEncoder
+{
+public:
+  /**
+   * 変換を始める。`wav`は変換を終えるまで解放しないこと
+   * @return 失敗した場合は`false`を返し、`error`に理由を設定する
+   */
+  bool open(const uint8_t *wav, size_t size, const AudioOutputSpec &spec, std::string &error);
+
+  /**
+   * 出力の形式(`format`はWAVの形式番号)。`data_offset`はヘッダのバイト数(WAV以外は0)、`data_size`はヘッダを除いたバイト数
+   */
+  const WavFormat &format() const
+  {
+    return format_;
+  }
+
+  /**
+   * 出力全体のバイト数(ヘッダを含む)
+   */
+  size_t total_bytes() const
+  {
+    return format_.data_offset + format_.data_size;
+  }
+
+  /**
+   * 続きを最大`max_bytes`バイト書く。サンプルの途中では区切らないため、全チャンネルの1サンプル分より小さいと何も書かない
+   * @return 書いたバイト数
+   */
+  size_t read(uint8_t *out, size_t max_bytes);
+
+  bool finished() const
+  {
+    return header_written_ == format_.data_offset && next_frame_ == output_frames_;
+  }
+
+  /**
+   * 開いた`wav`自身に書き戻せるかどうか。
+   * 長さが変わらないか短くなる(サンプリングレートを変えず、無音を足さない)場合は、どの時点でも書く位置が読む位置より前になる
+   */
+  bool fits_in_place() const
+  {
+    return in_place_;
+  }
+
+  /**
+   * 正規化する場合の、測定した元の音声のラウドネス(LUFS、無音なら負の無限大)とかける利得(dB)
+   */
+  double measured_loudness() const
+  {
+    return measured_loudness_;
+  }
+
+  double gain_db() const
+  {
+    return normalizer_.gain_db();
+  }
+
+private:
+  /**
+   * 音声の`voiced_frame`番目からの`frames`フレーム(`samples_`)にフェードをかける
+   */
+  void apply_fades(size_t voiced_frame, size_t frames);
+
+  const int16_t *input_ = nullptr;
+  size_t input_frames_ = 0;
+  uint16_t input_channels_ = 0;
+  /** 入力が2バイト境界に無い場合の写し */
+  std::vector<int16_t> aligned_;
+  /** サンプリングレートが同じなら`nullptr` */
+  std::shared_ptr<const Resampler> resampler_;
+  uint32_t output_format_ = AUDIO_OUTPUT_WAV;
+  WavFormat format_ = {};
+  size_t output_frames_ = 0;
+  size_t next_frame_ = 0;
+  uint8_t header_[WAV_HEADER_SIZE];
+  size_t header_written_ = 0;
+  std::vector<int16_t> samples_;
+  bool normalize_ = false;
+  double measured_loudness_ = 0.0;
+  LoudnessNormalizer normalizer_;
+  /** 出力のうち、前に足す無音と音声のフレーム数 */
+  size_t pad_start_frames_ = 0;
+  size_t voiced_frames_ = 0;
+  size_t fade_in_frames_ = 0;
+  size_t fade_out_frames_ = 0;
+  bool in_place_ = false;
+};
+
+/**
+ * 16ビットリニアPCMのWAVを`spec`の形式にする。G.711では複数チャンネルを平均してモノラルにする
+ * @param encoded_format `nullptr`でなければ、`out`の形式を設定する(::AudioOutputEncoder::format と同じ)
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する
+ */
+bool encode_audio_output(const uint8_t *wav, size_t size, const AudioOutputSpec &spec, std::vector<uint8_t> &out, std::string &error, WavFormat *encoded_format = nullptr);
+
+/**
+ * ::encode_audio_output と同じ変換を、書き戻せる場合(::AudioOutputEncoder::fits_in_place)は`wav`自身に行う
+ * @param in_place 書き戻した場合は`true`にし、`size`を変換後のバイト数にする。`false`の場合は`out`に書く
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する
+ */
+bool encode_audio_output_in_place(uint8_t *wav, size_t &size, const AudioOutputSpec &spec, bool &in_place, std::vector<uint8_t> &out, std::string &error, WavFormat *encoded_format = nullptr);
+
+#endif /* VOICEVOX_AUDIO_OUTPUT */
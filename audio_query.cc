@@ -0,0 +1,297 @@
+#include "audio_query.h"
+#include "json_reader.h"
+#include <utility>
+
+namespace
+{
+  /**
+   * Moraのオブジェクトを一つ読み、`query`のモーラの配列の末尾に加える
+   */
+  bool read_mora(JsonReader &reader, AudioQuery &query, bool is_pause)
+  {
+    std::string text, consonant, vowel;
+    bool has_consonant = false;
+    double consonant_length = 0.0, vowel_length = 0.0, pitch = 0.0;
+    if (!reader.consume('{'))
+      return false;
+    if (!reader.peek('}'))
+    {
+      do
+      {
+        std::string field;
+        if (!reader.read_string(field) || !reader.consume(':'))
+          return false;
+        bool ok;
+        if (field == "text")
+          ok = reader.read_string(text);
+        else if (field == "consonant")
+          ok = reader.consume_null() || (has_consonant = reader.read_string(consonant));
+        else if (field == "consonant_length")
+          ok = reader.consume_null() || reader.read_double(consonant_length);
+        else if (field == "vowel")
+          ok = reader.read_string(vowel);
+        else if (field == "vowel_length")
+          ok = reader.read_double(vowel_length);
+        else if (field == "pitch")
+          ok = reader.read_double(pitch);
+        else
+          ok = reader.skip_value();
+        if (!ok)
+          return false;
+      } while (reader.consume(','));
+    }
+    if (!reader.consume('}'))
+      return false;
+    query.mora_text.push_back(std::move(text));
+    query.mora_consonant.push_back(std::move(consonant));
+    query.mora_vowel.push_back(std::move(vowel));
+    query.mora_has_consonant.push_back(has_consonant ? 1 : 0);
+    query.mora_consonant_length.push_back(has_consonant ? consonant_length : 0.0);
+    query.mora_vowel_length.push_back(vowel_length);
+    query.mora_pitch.push_back(pitch);
+    query.mora_is_pause.push_back(is_pause ? 1 : 0);
+    return true;
+  }
+
+  /**
+   * AccentPhraseの配列を読み、`query`のアクセント句・モーラの配列の末尾に加える
+   */
+  bool read_accent_phrases(JsonReader &reader, AudioQuery &query)
+  {
+    if (!reader.consume('['))
+      return false;
+    if (reader.consume(']'))
+      return true;
+    do
+    {
+      uint32_t accent = 0;
+      bool is_interrogative = false;
+      bool has_pause = false;
+      bool has_moras = false;
+      // `pause_mora`が`moras`より先に来ても最後に置けるよう、別に読んでおく
+      AudioQuery pause;
+      if (!reader.consume('{'))
+        return false;
+      if (!reader.peek('}'))
+      {
+        do
+        {
+          std::string field;
+          if (!reader.read_string(field) || !reader.consume(':'))
+            return false;
+          bool ok = true;
+          if (field == "moras")
+          {
+            if (has_moras || !reader.consume('['))
+              return false;
+            has_moras = true;
+            if (!reader.consume(']'))
+            {
+              do
+              {
+                if (!read_mora(reader, query, false))
+                  return false;
+              } while (reader.consume(','));
+              ok = reader.consume(']');
+            }
+          }
+          else if (field == "accent")
+            ok = reader.read_uint32(accent);
+          else if (field == "pause_mora")
+            ok = reader.consume_null() || (has_pause = read_mora(reader, pause, true));
+          else if (field == "is_interrogative")
+            ok = reader.read_bool(is_interrogative);
+          else
+            ok = reader.skip_value();
+          if (!ok)
+            return false;
+        } while (reader.consume(','));
+      }
+      if (!reader.consume('}') || !has_moras)
+        return false;
+      if (has_pause)
+      {
+        query.mora_text.push_back(std::move(pause.mora_text[0]));
+        query.mora_consonant.push_back(std::move(pause.mora_consonant[0]));
+        query.mora_vowel.push_back(std::move(pause.mora_vowel[0]));
+        query.mora_has_consonant.push_back(pause.mora_has_consonant[0]);
+        query.mora_consonant_length.push_back(pause.mora_consonant_length[0]);
+        query.mora_vowel_length.push_back(pause.mora_vowel_length[0]);
+        query.mora_pitch.push_back(pause.mora_pitch[0]);
+        query.mora_is_pause.push_back(1);
+      }
+      query.phrase_mora_end.push_back(static_cast<uint32_t>(query.mora_text.size()));
+      query.phrase_accent.push_back(accent);
+      query.phrase_has_pause.push_back(has_pause ? 1 : 0);
+      query.phrase_is_interrogative.push_back(is_interrogative ? 1 : 0);
+    } while (reader.consume(','));
+    return reader.consume(']');
+  }
+}
+
+bool AudioQuery::parse(const char *json)
+{
+  AudioQuery parsed;
+  JsonReader reader(json);
+  if (!reader.consume('{'))
+    return false;
+  bool has_accent_phrases = false;
+  if (!reader.peek('}'))
+  {
+    do
+    {
+      std::string field;
+      if (!reader.read_string(field) || !reader.consume(':'))
+        return false;
+      bool ok;
+      if (field == "accent_phrases")
+        ok = !has_accent_phrases && (has_accent_phrases = read_accent_phrases(reader, parsed));
+      else if (field == "speed_scale")
+        ok = reader.read_double(parsed.speed_scale);
+      else if (field == "pitch_scale")
+        ok = reader.read_double(parsed.pitch_scale);
+      else if (field == "intonation_scale")
+        ok = reader.read_double(parsed.intonation_scale);
+      else if (field == "volume_scale")
+        ok = reader.read_double(parsed.volume_scale);
+      else if (field == "pre_phoneme_length")
+        ok = reader.read_double(parsed.pre_phoneme_length);
+      else if (field == "post_phoneme_length")
+        ok = reader.read_double(parsed.post_phoneme_length);
+      else if (field == "output_sampling_rate")
+        ok = reader.read_uint32(parsed.output_sampling_rate);
+      else if (field == "output_stereo")
+        ok = reader.read_bool(parsed.output_stereo);
+      else if (field == "kana")
+        ok = reader.consume_null() || (parsed.has_kana = reader.read_string(parsed.kana));
+      else
+        ok = reader.skip_value();
+      if (!ok)
+        return false;
+    } while (reader.consume(','));
+  }
+  if (!reader.consume('}') || !reader.at_end() || !has_accent_phrases)
+    return false;
+  *this = std::move(parsed);
+  return true;
+}
+
+bool AudioQuery::parse_accent_phrases(const char *json)
+{
+  AudioQuery parsed;
+  JsonReader reader(json);
+  if (!read_accent_phrases(reader, parsed) || !reader.at_end())
+    return false;
+  swap_accent_phrases(parsed);
+  return true;
+}
+
+void AudioQuery::swap_accent_phrases(AudioQuery &other)
+{
+  phrase_mora_end.swap(other.phrase_mora_end);
+  phrase_accent.swap(other.phrase_accent);
+  phrase_has_pause.swap(other.phrase_has_pause);
+  phrase_is_interrogative.swap(other.phrase_is_interrogative);
+  mora_text.swap(other.mora_text);
+  mora_consonant.swap(other.mora_consonant);
+  mora_vowel.swap(other.mora_vowel);
+  mora_has_consonant.swap(other.mora_has_consonant);
+  mora_consonant_length.swap(other.mora_consonant_length);
+  mora_vowel_length.swap(other.mora_vowel_length);
+  mora_pitch.swap(other.mora_pitch);
+  mora_is_pause.swap(other.mora_is_pause);
+}
+
+std::string AudioQuery::to_json() const
+{
+  std::string out;
+  // 1モーラあたりおよそ150バイト
+  out.reserve(256 + 150 * mora_count());
+  out += "{\"accent_phrases\":";
+  append_accent_phrases_json(out);
+  out += ",\"speed_scale\":";
+  append_json_number(out, speed_scale);
+  out += ",\"pitch_scale\":";
+  append_json_number(out, pitch_scale);
+  out += ",\"intonation_scale\":";
+  append_json_number(out, intonation_scale);
+  out += ",\"volume_scale\":";
+  append_json_number(out, volume_scale);
+  out += ",\"pre_phoneme_length\":";
+  append_json_number(out, pre_phoneme_length);
+  out += ",\"post_phoneme_length\":";
+  append_json_number(out, post_phoneme_length);
+  out += ",\"output_sampling_rate\":";
+  out += std::to_string(output_sampling_rate);
+  out += ",\"output_stereo\":";
+  out += output_stereo ? "true" : "false";
+  if (has_kana)
+  {
+    out += ",\"kana\":";
+    append_json_string(out, kana);
+  }
+  out += '}';
+  return out;
+}
+
+std::string AudioQuery::accent_phrases_to_json() const
+{
+  std::string out;
+  out.reserve(2 + 150 * mora_count());
+  append_accent_phrases_json(out);
+  return out;
+}
+
+void AudioQuery::append_accent_phrases_json(std::string &out) const
+{
+  out += '[';
+  size_t begin = 0;
+  for (size_t p = 0; p < phrase_mora_end.size(); p++)
+  {
+    size_t end = phrase_mora_end[p];
+    size_t moras_end = phrase_has_pause[p] ? end - 1 : end;
+    if (p > 0)
+      out += ',';
+    out += "{\"moras\":[";
+    for (size_t i = begin; i < moras_end; i++)
+    {
+      if (i > begin)
+        out += ',';
+      append_mora_json(out, i);
+    }
+    out += "],\"accent\":";
+    out += std::to_string(phrase_accent[p]);
+    out += ",\"pause_mora\":";
+    if (phrase_has_pause[p])
+      append_mora_json(out, end - 1);
+    else
+      out += "null";
+    out += ",\"is_interrogative\":";
+    out += phrase_is_interrogative[p] ? "true" : "false";
+    out += '}';
+    begin = end;
+  }
+  out += ']';
+}
+
+void AudioQuery::append_mora_json(std::string &out, size_t i) const
+{
+  out += "{\"text\":";
+  append_json_string(out, mora_text[i]);
+  if (mora_has_consonant[i])
+  {
+    out += ",\"consonant\":";
+    append_json_string(out, mora_consonant[i]);
+    out += ",\"consonant_length\":";
+    append_json_number(out, mora_consonant_length[i]);
+  }
+  else
+    out += ",\"consonant\":null,\"consonant_length\":null";
+  out += ",\"vowel\":";
+  append_json_string(out, mora_vowel[i]);
+  out += ",\"vowel_length\":";
+  append_json_number(out, mora_vowel_length[i]);
+  out += ",\"pitch\":";
+  append_json_number(out, mora_pitch[i]);
+  out += '}';
+}
@@ -0,0 +1,84 @@
+/**
+ * @file audio_query.h
+ *
+ * ネイティブ側で保持するAudioQuery。
+ *
+ * モーラの値を項目ごとの配列(struct of arrays)で持ち、音高・長さの書き換えやvoicevox_coreの`replace_*`をJSONを介さずに繰り返せるようにする。
+ * JSONにするのは、voicevox_coreに渡すときと、JS側で取り出すときだけ。
+ *
+ * モーラはアクセント句の順に並べ、アクセント句の句読点のモーラ(`pause_mora`)はそのアクセント句のモーラの最後に置く。
+ *
+ * メインスレッドからのみ触ること。
+ */
+#ifndef VOICEVOX_AUDIO_QUERY
+#define VOICEVOX_AUDIO_QUERY
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct AudioQuery
+{
+  double speed_scale = 1.0;
+  double pitch_scale = 0.0;
+  double intonation_scale = 1.0;
+  double volume_scale = 1.0;
+  double pre_phoneme_length = 0.1;
+  double post_phoneme_length = 0.1;
+  uint32_t output_sampling_rate = 24000;
+  bool output_stereo = false;
+  bool has_kana = false;
+  std::string kana;
+
+  // アクセント句ごと
+  /** そのアクセント句のモーラの終わり(句読点のモーラを含む)。始まりは一つ前のアクセント句の終わり */
+  std::vector<uint32_t> phrase_mora_end;
+  std::vector<uint32_t> phrase_accent;
+  std::vector<uint8_t> phrase_has_pause;
+  std::vector<uint8_t> phrase_is_interrogative;
+
+  // モーラごと
+  std::vector<std::string> mora_text;
+  std::vector<std::string> mora_consonant;
+  std::vector<std::string> mora_vowel;
+  /** 子音が無い(`consonant`が`null`)場合は0 */
+  std::vector<uint8_t> mora_has_consonant;
+  std::vector<double> mora_consonant_length;
+  std::vector<double> mora_vowel_length;
+  std::vector<double> mora_pitch;
+  /** 句読点のモーラかどうか */
+  std::vector<uint8_t> mora_is_pause;
+
+  /**
+   * AudioQueryのJSONを読み込む
+   * @return 解釈できなかった場合は`false`を返し、元の内容のまま
+   */
+  bool parse(const char *json);
+
+  /**
+   * アクセント句の配列のJSONを読み込み、アクセント句だけを置き換える
+   * @return 解釈できなかった場合は`false`を返し、元の内容のまま
+   */
+  bool parse_accent_phrases(const char *json);
+
+  std::string to_json() const;
+  std::string accent_phrases_to_json() const;
+
+  size_t mora_count() const
+  {
+    return mora_text.size();
+  }
+
+  size_t accent_phrase_count() const
+  {
+    return phrase_mora_end.size();
+  }
+
+private:
+  void swap_accent_phrases(AudioQuery &other);
+  void append_accent_phrases_json(std::string &out) const;
+  void append_mora_json(std::string &out, size_t i) const;
+};
+
+#endif /* VOICEVOX_AUDIO_QUERY */
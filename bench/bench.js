@@ -0,0 +1,186 @@
+/**
+ * バインディング毎のマイクロベンチマーク
+ *
+ * 各バインディングを繰り返し呼び出し、ops/secとレイテンシの分位点をJSONで出力する。
+ * `--core`を省略した場合はbench/binding.gyp(`npm run build:stub`)でビルドしたスタブ(bench/voicevox_core_stub.cc)を使う。
+ *
+ * @example
+ * ```sh
+ * node bench/bench.js --iterations 2000 --out bench_output.json
+ * VOICEVOX_STUB_SYNTHESIS_US=0 node bench/bench.js --cases tts,synthesis
+ * node bench/bench.js --core /path/to/libvoicevox_core.so --dict /path/to/open_jtalk_dic --model /path/to/0.vvm
+ * ```
+ */
+const { parseArgs, setup, teardown, check, summarize, environment, writeReport } = require("./common");
+
+const args = parseArgs(process.argv.slice(2), {
+  core: "",
+  dict: "open_jtalk_dic",
+  model: "0.vvm",
+  threads: 0,
+  style: 0,
+  text: "こんにちは、音声合成の世界へようこそ",
+  iterations: 1000,
+  warmup: 50,
+  cases: "",
+  out: "",
+});
+
+/**
+ * @typedef {{ stubOnly?: boolean, prepare?: (ctx: any, total: number) => any, run: (ctx: any, state: any, i: number) => void, cleanup?: (ctx: any, state: any) => void }} BenchCase
+ * @type {{ [name: string]: BenchCase }}
+ */
+const CASES = {
+  tts: {
+    run: (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerTtsV0_16(ctx.synthesizer, args.text, args.style, false).resultCode, "tts"),
+  },
+  // createAudioQueryでAquesTalk風記法を記録してから、同じテキストでttsする
+  ttsKanaCache: {
+    prepare: (ctx) => {
+      ctx.core.kanaCacheSetCapacity(1024);
+      audioQuery(ctx);
+    },
+    run: (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerTtsV0_16(ctx.synthesizer, args.text, args.style, false).resultCode, "ttsKanaCache"),
+    cleanup: (ctx) => ctx.core.kanaCacheSetCapacity(0),
+  },
+  ttsFromKana: {
+    prepare: (ctx) => audioQuery(ctx).kana,
+    run: (ctx, kana) => check(ctx.core, ctx.core.voicevoxSynthesizerTtsFromKanaV0_16(ctx.synthesizer, kana, args.style, false).resultCode, "ttsFromKana"),
+  },
+  // テキスト解析の結果を保持しない場合(毎回解析する)
+  createAudioQuery: {
+    prepare: (ctx) => ctx.core.accentPhraseCacheSetCapacity(0),
+    run: (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerCreateAudioQueryV0_16(ctx.synthesizer, args.text, args.style).resultCode, "createAudioQuery"),
+    cleanup: (ctx) => ctx.core.accentPhraseCacheSetCapacity(1024),
+  },
+  // 同じテキストを10スタイルで順に作る(2回目以降は解析を省き、replace_mora_dataのみ)
+  createAudioQueryStyles: {
+    stubOnly: true,
+    run: (ctx, state, i) => check(ctx.core, ctx.core.voicevoxSynthesizerCreateAudioQueryV0_16(ctx.synthesizer, args.text, i % 10).resultCode, "createAudioQueryStyles"),
+  },
+  // AudioQueryをJSで持ち、音高を一つ書き換えてから音素長を作り直して合成する(毎回JSONを往復する)
+  audioQueryEditJson: {
+    prepare: (ctx) => audioQuery(ctx),
+    run: (ctx, query, i) => {
+      query.accent_phrases[0].moras[0].pitch = 5 + (i % 3) * 0.1;
+      const { result, resultCode } = ctx.core.voicevoxSynthesizerReplacePhonemeLengthV0_16(ctx.synthesizer, JSON.stringify(query.accent_phrases), args.style);
+      check(ctx.core, resultCode, "audioQueryEditJson");
+      query.accent_phrases = JSON.parse(result);
+      check(ctx.core, ctx.core.voicevoxSynthesizerSynthesisV0_16(ctx.synthesizer, JSON.stringify(query), args.style, false).resultCode, "audioQueryEditJson");
+    },
+  },
+  // 同じ操作をネイティブ側で保持するAudioQueryで行う(JSONにするのは合成時のみ)
+  audioQueryEditHandle: {
+    prepare: (ctx) => {
+      check(ctx.core, ctx.core.voicevoxSynthesizerCreateAudioQueryHandleV0_16(ctx.synthesizer, args.text, args.style, 0).resultCode, "audioQueryEditHandle");
+      return 0;
+    },
+    run: (ctx, query, i) => {
+      ctx.core.voicevoxAudioQuerySetMoraPitchV0_16(query, 0, 5 + (i % 3) * 0.1);
+      check(ctx.core, ctx.core.voicevoxSynthesizerAudioQueryReplaceV0_16(ctx.synthesizer, query, args.style, 1).resultCode, "audioQueryEditHandle");
+      // 計測を同期で行うため、voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16と同じくJSONにしてから合成する
+      const { result } = ctx.core.voicevoxAudioQueryToJsonV0_16(query);
+      check(ctx.core, ctx.core.voicevoxSynthesizerSynthesisV0_16(ctx.synthesizer, result, args.style, false).resultCode, "audioQueryEditHandle");
+    },
+    cleanup: (ctx, query) => ctx.core.voicevoxAudioQueryDeleteV0_16(query),
+  },
+  synthesis: {
+    prepare: (ctx) => JSON.stringify(audioQuery(ctx)),
+    run: (ctx, json) => check(ctx.core, ctx.core.voicevoxSynthesizerSynthesisV0_16(ctx.synthesizer, json, args.style, false).resultCode, "synthesis"),
+  },
+  // voicevox_decodeはv0.16のcoreには無いため、スタブでのみ計測する
+  decode: {
+    stubOnly: true,
+    prepare: () => ({ f0: new Array(100).fill(5.5), phoneme: new Array(100 * 45).fill(0) }),
+    run: (ctx, { f0, phoneme }) => check(ctx.core, ctx.core.voicevoxDecodeV0_14(f0, phoneme, args.style).resultCode, "decode"),
+  },
+  userDictAddWord: {
+    prepare: (ctx) => newUserDict(ctx),
+    run: (ctx, dict, i) => check(ctx.core, ctx.core.voicevoxUserDictAddWordV0_16(dict, `単語${i}`, "タンゴ", 1, 5, 0).resultCode, "userDictAddWord"),
+    cleanup: (ctx, dict) => ctx.core.voicevoxUserDictDeleteV0_16(dict),
+  },
+  userDictUpdateWord: {
+    prepare: (ctx) => {
+      const dict = newUserDict(ctx);
+      const { result } = ctx.core.voicevoxUserDictAddWordV0_16(dict, "単語", "タンゴ", 1, 5, 0);
+      return { dict, uuid: result };
+    },
+    run: (ctx, { dict, uuid }, i) => check(ctx.core, ctx.core.voicevoxUserDictUpdateWordV0_16(dict, `単語${i}`, "タンゴ", 1, 5, 0, uuid).resultCode, "userDictUpdateWord"),
+    cleanup: (ctx, { dict }) => ctx.core.voicevoxUserDictDeleteV0_16(dict),
+  },
+  userDictRemoveWord: {
+    prepare: (ctx, total) => {
+      const dict = newUserDict(ctx);
+      const uuids = [];
+      for (let i = 0; i < total; i++) uuids.push(ctx.core.voicevoxUserDictAddWordV0_16(dict, `単語${i}`, "タンゴ", 1, 5, 0).result);
+      return { dict, uuids };
+    },
+    run: (ctx, { dict, uuids }, i) => check(ctx.core, ctx.core.voicevoxUserDictRemoveWordV0_16(dict, uuids[i]).resultCode, "userDictRemoveWord"),
+    cleanup: (ctx, { dict }) => ctx.core.voicevoxUserDictDeleteV0_16(dict),
+  },
+  userDictToJson: {
+    prepare: (ctx) => {
+      const dict = newUserDict(ctx);
+      for (let i = 0; i < 1000; i++) ctx.core.voicevoxUserDictAddWordV0_16(dict, `単語${i}`, "タンゴ", 1, 5, 0);
+      return dict;
+    },
+    run: (ctx, dict) => check(ctx.core, ctx.core.voicevoxUserDictToJsonV0_16(dict).resultCode, "userDictToJson"),
+    cleanup: (ctx, dict) => ctx.core.voicevoxUserDictDeleteV0_16(dict),
+  },
+  userDictFindWordsByPrefix: {
+    prepare: (ctx) => {
+      const dict = newUserDict(ctx);
+      for (let i = 0; i < 1000; i++) ctx.core.voicevoxUserDictAddWordV0_16(dict, `単語${i}`, "タンゴ", 1, 5, 0);
+      return dict;
+    },
+    run: (ctx, dict, i) => ctx.core.voicevoxUserDictFindWordsByPrefixV0_16(dict, `単語${i % 100}`, 20),
+    cleanup: (ctx, dict) => ctx.core.voicevoxUserDictDeleteV0_16(dict),
+  },
+};
+
+let userDictCounter = 0;
+function newUserDict(ctx) {
+  const name = userDictCounter++;
+  ctx.core.voicevoxUserDictNewV0_16(name);
+  return name;
+}
+
+function audioQuery(ctx) {
+  const { result, resultCode } = ctx.core.voicevoxSynthesizerCreateAudioQueryV0_16(ctx.synthesizer, args.text, args.style);
+  check(ctx.core, resultCode, "createAudioQuery");
+  return JSON.parse(result);
+}
+
+function runCase(ctx, benchCase) {
+  const total = args.warmup + args.iterations;
+  const state = benchCase.prepare ? benchCase.prepare(ctx, total) : undefined;
+  for (let i = 0; i < args.warmup; i++) benchCase.run(ctx, state, i);
+  const samples = new Array(args.iterations);
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < args.iterations; i++) {
+    const t0 = process.hrtime.bigint();
+    benchCase.run(ctx, state, args.warmup + i);
+    samples[i] = Number(process.hrtime.bigint() - t0);
+  }
+  const elapsed = Number(process.hrtime.bigint() - start);
+  if (benchCase.cleanup) benchCase.cleanup(ctx, state);
+  return { opsPerSec: Math.round((args.iterations / elapsed) * 1e9 * 100) / 100, ...summarize(samples) };
+}
+
+function main() {
+  const ctx = setup(args);
+  const names = args.cases === "" ? Object.keys(CASES) : args.cases.split(",");
+  const results = {};
+  for (const name of names) {
+    const benchCase = CASES[name];
+    if (benchCase === undefined) throw new Error(`不明なケースです: ${name}`);
+    if (benchCase.stubOnly && !ctx.stub) continue;
+    results[name] = runCase(ctx, benchCase);
+    const r = results[name];
+    process.stderr.write(`${name.padEnd(20)} ${String(r.opsPerSec).padStart(12)} ops/s  p50 ${r.p50Us}us  p99 ${r.p99Us}us\n`);
+  }
+  writeReport(args.out, { schema: "voicevox.js-bench/1", environment: environment(ctx, args), results });
+  teardown(ctx);
+}
+
+main();
@@ -0,0 +1,24 @@
+{
+    "targets": [
+        {
+            "target_name": "voicevox_core_stub",
+            "type": "shared_library",
+            "product_dir": "<(PRODUCT_DIR)",
+            "cflags!": ["-fno-exceptions"],
+            "cflags_cc!": ["-fno-exceptions"],
+            "sources": ["voicevox_core_stub.cc"],
+            "conditions": [
+                [
+                    "OS=='mac'",
+                    {
+                        "xcode_settings": {
+                            "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+                            "CLANG_CXX_LIBRARY": "libc++",
+                            "MACOSX_DEPLOYMENT_TARGET": "10.7",
+                        },
+                    },
+                ],
+            ],
+        }
+    ]
+}
@@ -0,0 +1,135 @@
+/**
+ * ベンチマーク・負荷試験ツールの共通処理
+ */
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { VoicevoxCore } = require("../voicevox_core");
+
+const STUB_ENV = ["VOICEVOX_STUB_ANALYSIS_US", "VOICEVOX_STUB_SYNTHESIS_US", "VOICEVOX_STUB_DICT_US", "VOICEVOX_STUB_WAV_BYTES", "VOICEVOX_STUB_SPIN"];
+
+/**
+ * `--name value`形式の引数を解析する
+ * @param {Array<string>} argv
+ * @param {{ [name: string]: string | number | boolean }} defaults
+ */
+function parseArgs(argv, defaults) {
+  const args = { ...defaults };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (!arg.startsWith("--")) throw new Error(`不明な引数です: ${arg}`);
+    const name = arg.slice(2).replace(/-([a-z])/g, (_, c) => c.toUpperCase());
+    if (!(name in defaults)) throw new Error(`不明なオプションです: ${arg}`);
+    if (typeof defaults[name] === "boolean") {
+      args[name] = true;
+      continue;
+    }
+    const value = argv[++i];
+    if (value === undefined) throw new Error(`${arg}に値がありません`);
+    args[name] = typeof defaults[name] === "number" ? Number(value) : value;
+  }
+  return args;
+}
+
+/**
+ * bench/binding.gypでビルドしたスタブのパスを探す
+ * @returns {string}
+ */
+function findStubCore() {
+  const names = ["libvoicevox_core_stub.so", "libvoicevox_core_stub.dylib"];
+  for (const dir of ["build/Release", "build/Debug", "build/Release/lib.target", "build/Debug/lib.target"]) {
+    for (const name of names) {
+      const candidate = path.join(__dirname, dir, name);
+      if (fs.existsSync(candidate)) return candidate;
+    }
+  }
+  throw new Error("スタブのvoicevox_coreが見つかりません。`npm run build:stub`でビルドするか--coreで指定してください");
+}
+
+/**
+ * voicevox_coreを読み込み、OpenJtalkRc・音声モデル・シンセサイザを用意する
+ * @param {{ core: string, dict: string, model: string, threads: number }} args
+ */
+function setup(args) {
+  const corePath = args.core === "" ? findStubCore() : path.resolve(args.core);
+  const stub = args.core === "";
+  const core = new VoicevoxCore(corePath);
+  check(core, core.voicevoxOpenJtalkRcNewV0_16(args.dict, 0).resultCode, "voicevoxOpenJtalkRcNewV0_16");
+  check(core, core.voicevoxVoiceModelNewFromPathV0_16(args.model, 0).resultCode, "voicevoxVoiceModelNewFromPathV0_16");
+  check(core, core.voicevoxSynthesizerNewV0_16(0, 0, 1, args.threads).resultCode, "voicevoxSynthesizerNewV0_16");
+  check(core, core.voicevoxSynthesizerLoadVoiceModelV0_16(0, 0).resultCode, "voicevoxSynthesizerLoadVoiceModelV0_16");
+  return { core, corePath, stub, synthesizer: 0 };
+}
+
+/**
+ * 後始末
+ * @param {{ core: VoicevoxCore }} ctx
+ */
+function teardown(ctx) {
+  ctx.core.voicevoxSynthesizerDeleteV0_16(0);
+  ctx.core.voicevoxVoiceModelDeleteV0_16(0);
+  ctx.core.voicevoxOpenJtalkRcDeleteV0_16(0);
+}
+
+function check(core, resultCode, name) {
+  if (resultCode !== 0) throw new Error(`${name}: ${core.voicevoxErrorResultToMessageV0_12(resultCode).result}`);
+}
+
+/**
+ * ナノ秒単位の計測値から統計値を求める
+ * @param {Array<number>} samples ナノ秒
+ */
+function summarize(samples) {
+  const sorted = Float64Array.from(samples).sort();
+  const total = sorted.reduce((a, b) => a + b, 0);
+  const pick = (p) => (sorted.length === 0 ? 0 : sorted[Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1)]);
+  const us = (ns) => Math.round(ns / 10) / 100;
+  return {
+    count: sorted.length,
+    meanUs: us(sorted.length === 0 ? 0 : total / sorted.length),
+    minUs: us(sorted.length === 0 ? 0 : sorted[0]),
+    p50Us: us(pick(50)),
+    p90Us: us(pick(90)),
+    p99Us: us(pick(99)),
+    p999Us: us(pick(99.9)),
+    maxUs: us(sorted.length === 0 ? 0 : sorted[sorted.length - 1]),
+  };
+}
+
+/**
+ * 結果を比較できるよう、実行環境の情報をまとめる
+ * @param {{ core: VoicevoxCore, corePath: string, stub: boolean }} ctx
+ * @param {object} args
+ */
+function environment(ctx, args) {
+  const stubConfig = {};
+  for (const name of STUB_ENV) if (process.env[name] !== undefined) stubConfig[name] = process.env[name];
+  return {
+    date: new Date().toISOString(),
+    voicevoxJs: require("../package.json").version,
+    coreVersion: ctx.core.voicevoxGetVersionV0_14().result,
+    corePath: ctx.corePath,
+    stub: ctx.stub,
+    stubConfig,
+    node: process.version,
+    v8: process.versions.v8,
+    platform: process.platform,
+    arch: process.arch,
+    cpu: os.cpus()[0]?.model ?? "unknown",
+    cpuCount: os.cpus().length,
+    args,
+  };
+}
+
+/**
+ * JSONを出力する。`out`が空の場合は標準出力に書く
+ * @param {string} out
+ * @param {object} report
+ */
+function writeReport(out, report) {
+  const json = JSON.stringify(report, null, 2) + "\n";
+  if (out === "") process.stdout.write(json);
+  else fs.writeFileSync(out, json);
+}
+
+module.exports = { parseArgs, findStubCore, setup, teardown, check, summarize, environment, writeReport };
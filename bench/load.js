@@ -0,0 +1,129 @@
+/**
+ * オープンループ負荷試験
+ *
+ * ポアソン到着でTTSリクエストを発行し、到着レートを段階的に上げながら
+ * 実効スループット・待ち時間・応答時間の分位点をステップ毎にJSONで出力する。
+ * リクエストは完了を待たずに予定時刻で到着させるため、処理が追いつかなくなると待ち時間として現れる。
+ * 各ワーカー(worker_threads)はそれぞれ専用のシンセサイザを持つ(bench/openloop.js)。
+ *
+ * @example
+ * ```sh
+ * node bench/load.js --rates 50,100,200,400 --duration 5 --workers 2 --out load_output.json
+ * node bench/load.js --core /path/to/libvoicevox_core.so --dict /path/to/open_jtalk_dic --model /path/to/0.vvm --rates 1,2,4,8
+ * ```
+ */
+const path = require("node:path");
+const { isMainThread, workerData } = require("node:worker_threads");
+const { VoicevoxCore } = require("../voicevox_core");
+const { parseArgs, findStubCore, summarize, environment, writeReport } = require("./common");
+const { serveWorker, startWorkers, closeWorkers, runOpenLoop } = require("./openloop");
+
+if (isMainThread) {
+  main().catch((e) => {
+    console.error(e);
+    process.exit(1);
+  });
+} else {
+  serveWorker(workerData, (ctx) => ctx.core.voicevoxSynthesizerTtsV0_16(ctx.synthesizer, workerData.text, workerData.style, false).resultCode);
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2), {
+    core: "",
+    dict: "open_jtalk_dic",
+    model: "0.vvm",
+    threads: 0,
+    style: 0,
+    text: "こんにちは、音声合成の世界へようこそ",
+    workers: 1,
+    rates: "10,20,50,100,200",
+    duration: 10,
+    seed: 1,
+    maxP99Ms: 0,
+    out: "",
+  });
+  const rates = args.rates.split(",").map(Number);
+  if (rates.some((rate) => !(rate > 0))) throw new Error(`--ratesが不正です: ${args.rates}`);
+  if (!(args.workers >= 1)) throw new Error(`--workersが不正です: ${args.workers}`);
+
+  // ワーカーは別スレッドでcoreを読み込むため、パスを解決してから渡す
+  const corePath = args.core === "" ? findStubCore() : path.resolve(args.core);
+  const workers = await startWorkers(__filename, { ...args, core: corePath }, args.workers);
+
+  const steps = [];
+  for (const rate of rates) {
+    const step = await runStep(workers, rate, args);
+    steps.push(step);
+    process.stderr.write(
+      `offered ${String(step.offeredRps).padStart(8)} rps  achieved ${String(step.achievedRps).padStart(8)} rps  ` +
+        `wait p99 ${step.queueWait.p99Us}us  e2e p50 ${step.endToEnd.p50Us}us  p99 ${step.endToEnd.p99Us}us\n`
+    );
+    if (args.maxP99Ms > 0 && step.endToEnd.p99Us > args.maxP99Ms * 1000) break;
+  }
+  await closeWorkers(workers);
+
+  const core = new VoicevoxCore(corePath);
+  const env = environment({ core, corePath, stub: args.core === "" }, args);
+  writeReport(args.out, { schema: "voicevox.js-load/1", environment: env, steps });
+}
+
+/**
+ * 同じシードからは同じ到着時刻列が得られるよう、乱数は自前で生成する
+ * @param {number} seed
+ */
+function mulberry32(seed) {
+  let a = seed >>> 0;
+  return () => {
+    a = (a + 0x6d2b79f5) >>> 0;
+    let t = a;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * ポアソン到着の予定時刻(ナノ秒)を求める
+ * @param {number} rate 1秒あたりのリクエスト数
+ * @param {number} duration 秒
+ * @param {number} seed
+ */
+function arrivals(rate, duration, seed) {
+  const random = mulberry32(seed);
+  const times = [];
+  for (let t = -Math.log(1 - random()) / rate; t < duration; t += -Math.log(1 - random()) / rate) times.push(t * 1e9);
+  return times;
+}
+
+/**
+ * 1ステップ分の負荷をかける
+ *
+ * 待ち時間は予定時刻から処理開始までとし、タイマーの遅れも含める。
+ */
+async function runStep(workers, rate, args) {
+  const schedule = arrivals(rate, args.duration, args.seed);
+  const { starts, ends, resultCodes } = await runOpenLoop(workers, schedule, () => null);
+  const queueWait = new Array(schedule.length);
+  const service = new Array(schedule.length);
+  const endToEnd = new Array(schedule.length);
+  let last = 0;
+  let errors = 0;
+  for (let i = 0; i < schedule.length; i++) {
+    queueWait[i] = Math.max(0, starts[i] - schedule[i]);
+    service[i] = ends[i] - starts[i];
+    endToEnd[i] = Math.max(0, ends[i] - schedule[i]);
+    last = Math.max(last, ends[i]);
+    if (resultCodes[i] !== 0) errors++;
+  }
+  const round = (n) => Math.round(n * 100) / 100;
+  return {
+    rate,
+    requests: schedule.length,
+    errors,
+    offeredRps: round(schedule.length / args.duration),
+    achievedRps: round(last === 0 ? 0 : schedule.length / (last / 1e9)),
+    queueWait: summarize(queueWait),
+    service: summarize(service),
+    endToEnd: summarize(endToEnd),
+  };
+}
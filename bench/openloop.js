@@ -0,0 +1,128 @@
+/**
+ * オープンループでリクエストを発行する共通処理(負荷試験・再生で使う)
+ *
+ * 各ワーカー(worker_threads)はそれぞれ専用のシンセサイザを持ち、
+ * `{ index, payload }`を受け取って処理し、`{ index, start, end, resultCode }`を返す。
+ */
+const { Worker, parentPort } = require("node:worker_threads");
+const { setup, teardown } = require("./common");
+
+/**
+ * ワーカー側の処理を登録する
+ * @param {object} args `setup`に渡す引数
+ * @param {(ctx: any, payload: any) => number | Promise<number>} handler 結果コード(非同期の場合はそのPromise)を返す。終了時刻は解決した時点とする
+ */
+function serveWorker(args, handler) {
+  const ctx = setup(args);
+  parentPort.on("message", (message) => {
+    if (message === "close") {
+      teardown(ctx);
+      parentPort.close();
+      return;
+    }
+    const start = process.hrtime.bigint();
+    const resultCode = handler(ctx, message.payload);
+    const reply = (resultCode) => parentPort.postMessage({ index: message.index, start, end: process.hrtime.bigint(), resultCode });
+    if (!(resultCode instanceof Promise)) return reply(resultCode);
+    // rejectされた場合は同期の場合と同じくワーカーを異常終了させる
+    resultCode.then(reply, (e) =>
+      process.nextTick(() => {
+        throw e;
+      })
+    );
+  });
+  parentPort.postMessage("ready");
+}
+
+/**
+ * ワーカーを起動し、準備ができるまで待つ
+ * @param {string} filename ワーカーとして実行するファイル
+ * @param {object} workerData
+ * @param {number} count
+ * @returns {Promise<Array<Worker>>}
+ */
+function startWorkers(filename, workerData, count) {
+  const start = () =>
+    new Promise((resolve, reject) => {
+      const w = new Worker(filename, { workerData });
+      w.once("error", reject);
+      w.once("message", (message) => {
+        if (message === "ready") resolve(w);
+      });
+    });
+  return Promise.all(Array.from({ length: count }, start));
+}
+
+/**
+ * ワーカーを終了させる
+ * @param {Array<Worker>} workers
+ */
+async function closeWorkers(workers) {
+  for (const w of workers) w.postMessage("close");
+  await Promise.all(workers.map((w) => new Promise((resolve) => w.once("exit", resolve))));
+}
+
+/**
+ * 予定時刻にリクエストを到着させ、空いているワーカーへ順に割り当てる
+ *
+ * 予定時刻を過ぎたリクエストは待ち行列に積む。時刻はすべて開始時点からのナノ秒。
+ * @param {Array<Worker>} workers
+ * @param {Array<number>} schedule 到着予定時刻(昇順)
+ * @param {(index: number) => any} payload ワーカーへ渡す内容
+ * @returns {Promise<{ starts: Float64Array, ends: Float64Array, resultCodes: Int32Array }>} ワーカーが異常終了した場合はreject
+ */
+function runOpenLoop(workers, schedule, payload) {
+  const starts = new Float64Array(schedule.length);
+  const ends = new Float64Array(schedule.length);
+  const resultCodes = new Int32Array(schedule.length);
+  return new Promise((resolve, reject) => {
+    if (schedule.length === 0) return resolve({ starts, ends, resultCodes });
+    const origin = process.hrtime.bigint() + 10_000_000n;
+    const elapsed = () => Number(process.hrtime.bigint() - origin);
+    const queue = [];
+    let head = 0;
+    let next = 0;
+    let done = 0;
+    const idle = [...workers];
+
+    const onMessage = function ({ index, start, end, resultCode }) {
+      starts[index] = Number(start - origin);
+      ends[index] = Number(end - origin);
+      resultCodes[index] = resultCode;
+      idle.push(this);
+      dispatch();
+      if (++done === schedule.length) {
+        cleanup();
+        resolve({ starts, ends, resultCodes });
+      }
+    };
+    const onError = (e) => {
+      cleanup();
+      reject(e);
+    };
+    const onExit = (code) => onError(new Error(`ワーカーが終了しました: ${code}`));
+    const cleanup = () => {
+      for (const w of workers) w.off("message", onMessage).off("error", onError).off("exit", onExit);
+    };
+    for (const w of workers) w.on("message", onMessage).on("error", onError).on("exit", onExit);
+
+    function dispatch() {
+      while (head < queue.length && idle.length > 0) {
+        const index = queue[head++];
+        idle.pop().postMessage({ index, payload: payload(index) });
+      }
+    }
+    function pump() {
+      const now = elapsed();
+      while (next < schedule.length && schedule[next] <= now) queue.push(next++);
+      dispatch();
+      if (next === schedule.length) return;
+      const wait = (schedule[next] - elapsed()) / 1e6;
+      if (wait < 1) setImmediate(pump);
+      else setTimeout(pump, Math.floor(wait));
+    }
+    pump();
+  });
+}
+
+module.exports = { serveWorker, startWorkers, closeWorkers, runOpenLoop };
@@ -0,0 +1,299 @@
+/**
+ * 記録した呼び出しの再生
+ *
+ * `captureStart`/`captureStop`で記録したファイル(形式はcapture.hを参照)を読み込み、
+ * 記録時と同じ間隔(`--speed`で倍率を指定)でオープンループに呼び出しを発行する。
+ * 記録時のレイテンシと再生時のレイテンシを、バインディング毎に比較してJSONで出力する。
+ * スレッドプール版などで記録した呼び出しは、記録したオプション(出力形式・ラウドネス・後処理など)で同じ版を呼び出す。
+ * AudioQueryを受け取る版はその都度記録したJSONからAudioQueryを作るため、その分だけ再生時のレイテンシが長くなる。
+ * ファイルへの書き込みは一時ディレクトリに、ファイルディスクリプタへの書き込みは`os.devNull`に行う。ストリームは全て読み出すまでを計る。
+ *
+ * @example
+ * ```sh
+ * node bench/replay.js --capture capture.bin --core /path/to/libvoicevox_core.so --dict /path/to/open_jtalk_dic --model /path/to/0.vvm
+ * node bench/replay.js --capture capture.bin --speed 2 --workers 2 --out replay_output.json
+ * ```
+ */
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
+const { isMainThread, workerData, threadId } = require("node:worker_threads");
+const { VoicevoxCore } = require("../voicevox_core");
+const { parseArgs, findStubCore, summarize, environment, writeReport } = require("./common");
+const { serveWorker, startWorkers, closeWorkers, runOpenLoop } = require("./openloop");
+
+/**
+ * capture.hの`CaptureBinding`とバインディングの対応
+ * @type {{ [binding: number]: { name: string, call: (core: any, synthesizer: number, record: CaptureRecord) => number } }}
+ */
+const BINDINGS = {
+  1: { name: "tts", call: (core, s, r) => core.voicevoxSynthesizerTtsV0_16(s, r.input, r.styleId, r.enableInterrogativeUpspeak).resultCode },
+  2: { name: "ttsFromKana", call: (core, s, r) => core.voicevoxSynthesizerTtsFromKanaV0_16(s, r.input, r.styleId, r.enableInterrogativeUpspeak).resultCode },
+  3: { name: "synthesis", call: (core, s, r) => core.voicevoxSynthesizerSynthesisV0_16(s, r.input, r.styleId, r.enableInterrogativeUpspeak).resultCode },
+  4: { name: "createAudioQuery", call: (core, s, r) => core.voicevoxSynthesizerCreateAudioQueryV0_16(s, r.input, r.styleId).resultCode },
+  5: { name: "createAudioQueryFromKana", call: (core, s, r) => core.voicevoxSynthesizerCreateAudioQueryFromKanaV0_16(s, r.input, r.styleId).resultCode },
+  6: { name: "createAccentPhrases", call: (core, s, r) => core.voicevoxSynthesizerCreateAccentPhrasesV0_16(s, r.input, r.styleId).resultCode },
+  7: { name: "createAccentPhrasesFromKana", call: (core, s, r) => core.voicevoxSynthesizerCreateAccentPhrasesFromKanaV0_16(s, r.input, r.styleId).resultCode },
+  8: { name: "replaceMoraData", call: (core, s, r) => core.voicevoxSynthesizerReplaceMoraDataV0_16(s, r.input, r.styleId).resultCode },
+  9: { name: "replacePhonemeLength", call: (core, s, r) => core.voicevoxSynthesizerReplacePhonemeLengthV0_16(s, r.input, r.styleId).resultCode },
+  10: { name: "replaceMoraPitch", call: (core, s, r) => core.voicevoxSynthesizerReplaceMoraPitchV0_16(s, r.input, r.styleId).resultCode },
+};
+
+/**
+ * capture.hの`CaptureVariant`(同期版以外)とバインディングの対応。`tts`(1)と`synthesis`(3)のみ
+ * @type {{ [variant: number]: { suffix: string, call: (core: any, synthesizer: number, record: CaptureRecord) => Promise<number> } }}
+ */
+const VARIANTS = {
+  1: {
+    suffix: "Async",
+    call: async (core, s, r) => {
+      const o = r.options;
+      if (r.binding === 1) return (await core.voicevoxSynthesizerTtsAsyncV0_16(s, r.input, r.styleId, r.enableInterrogativeUpspeak, o.outputSamplingRate, o.outputFormat, o.targetLoudness, o.postProcess)).resultCode;
+      return withAudioQuery(core, r, async (q) => (await core.voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16(s, q, r.styleId, r.enableInterrogativeUpspeak, o.outputSamplingRate, o.outputFormat, o.targetLoudness, o.postProcess)).resultCode);
+    },
+  },
+  2: {
+    suffix: "Frames",
+    call: (core, s, r) => {
+      const o = r.options;
+      return withAudioQuery(core, r, async (q) => (await core.voicevoxSynthesizerSynthesisFramesAsyncV0_16(s, q, r.styleId, r.enableInterrogativeUpspeak, o.outputSamplingRate, o.outputFormat, o.frameMs, o.framesPerBatch, o.pace, () => {}, o.targetLoudness, o.postProcess)).resultCode);
+    },
+  },
+  3: {
+    suffix: "ToFile",
+    call: (core, s, r) => {
+      const o = r.options;
+      const file = path.join(workerData.tmpDir, `${threadId}.out`);
+      return withAudioQuery(core, r, async (q) => (await core.voicevoxSynthesizerSynthesisToFileAsyncV0_16(s, q, r.styleId, r.enableInterrogativeUpspeak, o.outputSamplingRate, o.outputFormat, file, o.patchWavHeader, o.targetLoudness, o.postProcess)).resultCode);
+    },
+  },
+  4: {
+    suffix: "ToFd",
+    call: (core, s, r) => {
+      const o = r.options;
+      devNull ??= fs.openSync(os.devNull, "w");
+      return withAudioQuery(core, r, async (q) => (await core.voicevoxSynthesizerSynthesisToFdAsyncV0_16(s, q, r.styleId, r.enableInterrogativeUpspeak, o.outputSamplingRate, o.outputFormat, devNull, 0, o.patchWavHeader, o.targetLoudness, o.postProcess)).resultCode);
+    },
+  },
+  5: {
+    suffix: "Stream",
+    call: (core, s, r) => {
+      const o = r.options;
+      return withAudioQuery(
+        core,
+        r,
+        (q) =>
+          new Promise((resolve, reject) => {
+            // 読み出せなくなるまで読み、終わったらストリームを破棄する
+            const drain = () => {
+              try {
+                for (;;) {
+                  const read = core.voicevoxPcmStreamReadV0_16(0, 64 * 1024);
+                  if (read.ended) {
+                    core.voicevoxPcmStreamDeleteV0_16(0);
+                    return resolve(read.resultCode);
+                  }
+                  if (read.result === null) return;
+                }
+              } catch (e) {
+                core.voicevoxPcmStreamDeleteV0_16(0);
+                reject(e);
+              }
+            };
+            core.voicevoxSynthesizerSynthesisStreamV0_16(s, q, r.styleId, r.enableInterrogativeUpspeak, o.outputSamplingRate, o.outputFormat, o.ringBytes, 0, drain, o.targetLoudness, o.postProcess);
+            drain();
+          })
+      );
+    },
+  },
+};
+
+/** `VARIANTS[4]`が書き込む`os.devNull`(ワーカー毎に1つ) */
+let devNull = null;
+
+/**
+ * @typedef {{ outputSamplingRate: number, outputFormat: number, targetLoudness?: number, postProcess?: object, frameMs: number, framesPerBatch: number, pace: boolean, patchWavHeader: boolean, ringBytes: number }} CaptureOptions
+ * @typedef {{ binding: number, variant: number, enableInterrogativeUpspeak: boolean, styleId: number, resultCode: number, arrivalNs: number, latencyNs: number, options: CaptureOptions, input: string }} CaptureRecord
+ */
+
+if (isMainThread) {
+  main().catch((e) => {
+    console.error(e);
+    process.exit(1);
+  });
+} else {
+  serveWorker(workerData, (ctx, record) => (record.variant === 0 ? BINDINGS[record.binding] : VARIANTS[record.variant]).call(ctx.core, ctx.synthesizer, record));
+}
+
+/**
+ * 記録したJSONからAudioQuery(ポインタ名0)を作って`f`に渡し、終わったら解放する
+ * @param {any} core
+ * @param {CaptureRecord} record
+ * @param {(audioQuery: number) => Promise<number>} f
+ */
+async function withAudioQuery(core, record, f) {
+  core.voicevoxAudioQueryNewV0_16(record.input, 0);
+  try {
+    return await f(0);
+  } finally {
+    core.voicevoxAudioQueryDeleteV0_16(0);
+  }
+}
+
+/**
+ * 再生できる記録かどうか
+ * @param {CaptureRecord} record
+ */
+function replayable(record) {
+  if (BINDINGS[record.binding] === undefined) return false;
+  if (record.variant === 0) return true;
+  return VARIANTS[record.variant] !== undefined && (record.binding === 3 || (record.binding === 1 && record.variant === 1));
+}
+
+/**
+ * 記録の集計名(`tts`、`synthesisFrames`など)
+ * @param {CaptureRecord} record
+ */
+function bindingName(record) {
+  return BINDINGS[record.binding].name + (record.variant === 0 ? "" : VARIANTS[record.variant].suffix);
+}
+
+/**
+ * 記録ファイルを読み込む
+ *
+ * 到着時刻が記録の期間(記録開始から最後に完了した呼び出しまで)を超えるレコードは、記録開始より前に呼び出されたもの
+ * (古い版では到着時刻が負になって折り返している)として除き、`outOfSpan`に数える。
+ * @param {string} file
+ * @returns {{ version: number, startedAt: string, records: Array<CaptureRecord>, outOfSpan: number }}
+ */
+function readCapture(file) {
+  const buf = fs.readFileSync(file);
+  if (buf.length < 24 || buf.toString("latin1", 0, 8) !== "VVCAPTUR") throw new Error(`記録ファイルではありません: ${file}`);
+  const version = buf.readUInt32LE(8);
+  if (version !== 1 && version !== 2) throw new Error(`対応していない記録ファイルのバージョンです: ${version}`);
+  const startedAt = new Date(Number(buf.readBigUInt64LE(16) / 1_000_000n)).toISOString();
+  // バージョン1にはオプションが無い(全て同期版)
+  const fixed = version === 1 ? 32 : 88;
+  const raw = [];
+  let offset = 24;
+  // 書き込み途中で終了した場合に備え、末尾の不完全なレコードは無視する
+  while (offset + 4 <= buf.length) {
+    const length = buf.readUInt32LE(offset);
+    if (length < fixed || offset + 4 + length > buf.length) break;
+    const p = offset + 4;
+    const inputLength = buf.readUInt32LE(p + fixed - 4);
+    raw.push({ p, arrival: buf.readBigUInt64LE(p + 12), latency: buf.readBigUInt64LE(p + 20), input: buf.toString("utf8", p + fixed, p + fixed + inputLength) });
+    offset = p + length;
+  }
+  // 完了時刻(到着時刻 + レイテンシ)は折り返していても正しい
+  const completion = (r) => (r.arrival + r.latency) & 0xffff_ffff_ffff_ffffn;
+  const span = raw.reduce((max, r) => (completion(r) > max ? completion(r) : max), 0n);
+  const records = [];
+  for (const { p, arrival, latency, input } of raw) {
+    if (arrival > span) continue;
+    records.push({
+      binding: buf.readUInt8(p),
+      variant: version === 1 ? 0 : buf.readUInt8(p + 2),
+      enableInterrogativeUpspeak: (buf.readUInt8(p + 1) & 0x01) !== 0,
+      styleId: buf.readUInt32LE(p + 4),
+      resultCode: buf.readInt32LE(p + 8),
+      arrivalNs: Number(arrival),
+      latencyNs: Number(latency),
+      options: version === 1 ? readOptions(Buffer.alloc(88), 0) : readOptions(buf, p),
+      input,
+    });
+  }
+  return { version, startedAt, records, outOfSpan: raw.length - records.length };
+}
+
+/**
+ * レコードのオプション(capture.hを参照)を、バインディングに渡す形にする
+ * @param {Buffer} buf
+ * @param {number} p レコードの先頭(`length`の直後)
+ * @returns {CaptureOptions}
+ */
+function readOptions(buf, p) {
+  const flags = buf.readUInt8(p + 3);
+  const postProcess = {};
+  if (flags & 0x02) postProcess.trim = { thresholdDb: buf.readDoubleLE(p + 44), marginMs: buf.readUInt32LE(p + 52) };
+  const ms = { fadeInMs: 56, fadeOutMs: 60, padStartMs: 64, padEndMs: 68 };
+  for (const [name, at] of Object.entries(ms)) {
+    const value = buf.readUInt32LE(p + at);
+    if (value !== 0) postProcess[name] = value;
+  }
+  return {
+    outputSamplingRate: buf.readUInt32LE(p + 28),
+    outputFormat: buf.readUInt32LE(p + 32),
+    targetLoudness: flags & 0x01 ? buf.readDoubleLE(p + 36) : undefined,
+    postProcess: Object.keys(postProcess).length === 0 ? undefined : postProcess,
+    frameMs: buf.readUInt32LE(p + 72),
+    framesPerBatch: buf.readUInt32LE(p + 76),
+    pace: (flags & 0x04) !== 0,
+    patchWavHeader: (flags & 0x08) !== 0,
+    ringBytes: buf.readUInt32LE(p + 80),
+  };
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2), {
+    capture: "",
+    core: "",
+    dict: "open_jtalk_dic",
+    model: "0.vvm",
+    threads: 0,
+    workers: 1,
+    speed: 1,
+    out: "",
+  });
+  if (args.capture === "") throw new Error("--captureで記録ファイルを指定してください");
+  if (!(args.speed > 0)) throw new Error(`--speedが不正です: ${args.speed}`);
+
+  const capture = readCapture(args.capture);
+  const records = capture.records.filter(replayable);
+  if (records.length === 0) throw new Error("再生できる記録がありません");
+  // 非同期の呼び出しは完了時に記録されるため、ファイル内では到着順に並んでいない
+  records.sort((a, b) => a.arrivalNs - b.arrivalNs);
+  const first = records[0].arrivalNs;
+  const schedule = records.map((r) => (r.arrivalNs - first) / args.speed);
+
+  const corePath = args.core === "" ? findStubCore() : path.resolve(args.core);
+  const tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), "voicevox-replay-"));
+  const workers = await startWorkers(__filename, { ...args, core: corePath, tmpDir }, args.workers);
+  const { starts, ends, resultCodes } = await runOpenLoop(workers, schedule, (i) => records[i]);
+  await closeWorkers(workers);
+  fs.rmSync(tmpDir, { recursive: true, force: true });
+
+  const groups = {};
+  for (let i = 0; i < records.length; i++) {
+    const name = bindingName(records[i]);
+    const g = (groups[name] ??= { original: [], replay: [], queueWait: [], resultCodeMismatches: 0 });
+    g.original.push(records[i].latencyNs);
+    g.replay.push(ends[i] - starts[i]);
+    g.queueWait.push(Math.max(0, starts[i] - schedule[i]));
+    if (resultCodes[i] !== records[i].resultCode) g.resultCodeMismatches++;
+  }
+  const round = (n) => Math.round(n * 100) / 100;
+  const results = {};
+  for (const [name, g] of Object.entries(groups)) {
+    const original = summarize(g.original);
+    const replay = summarize(g.replay);
+    results[name] = {
+      original,
+      replay,
+      queueWait: summarize(g.queueWait),
+      deltaP50Us: round(replay.p50Us - original.p50Us),
+      deltaP99Us: round(replay.p99Us - original.p99Us),
+      resultCodeMismatches: g.resultCodeMismatches,
+    };
+    process.stderr.write(`${name.padEnd(28)} p50 ${original.p50Us}us -> ${replay.p50Us}us  p99 ${original.p99Us}us -> ${replay.p99Us}us\n`);
+  }
+
+  const core = new VoicevoxCore(corePath);
+  const env = environment({ core, corePath, stub: args.core === "" }, args);
+  writeReport(args.out, {
+    schema: "voicevox.js-replay/1",
+    environment: env,
+    capture: { file: path.resolve(args.capture), version: capture.version, startedAt: capture.startedAt, records: capture.records.length, outOfSpan: capture.outOfSpan, replayed: records.length },
+    results,
+  });
+}
@@ -0,0 +1,169 @@
+/**
+ * 長時間の呼び出しによるメモリリークの検出
+ *
+ * 複数のバインディング(ポインタの作成・解放の組を含む)を繰り返し呼び出し、
+ * 一定間隔でRSS・mallocの確保量・V8ヒープを記録する。
+ * ウォームアップ後の記録から1呼び出しあたりの増加量(最小二乗法の傾き)を求め、閾値を超えた場合は終了コード1で終わる。
+ * 既定ではスタブを遅延なしで使うため、数百万回でも短時間で終わる。
+ *
+ * @example
+ * ```sh
+ * node bench/soak.js --iterations 5000000 --out soak_output.json
+ * ```
+ */
+const v8 = require("node:v8");
+const vm = require("node:vm");
+const { parseArgs, setup, teardown, check, environment, writeReport } = require("./common");
+
+const args = parseArgs(process.argv.slice(2), {
+  core: "",
+  dict: "open_jtalk_dic",
+  model: "0.vvm",
+  threads: 0,
+  style: 0,
+  text: "こんにちは、音声合成の世界へようこそ",
+  iterations: 2_000_000,
+  warmup: 100_000,
+  sampleEvery: 20_000,
+  maxNativeBytesPerIteration: 1,
+  maxHeapBytesPerIteration: 1,
+  maxRssBytesPerIteration: 8,
+  out: "",
+});
+
+// スタブの遅延は計測の邪魔になるので、指定がなければ0にする
+if (args.core === "") {
+  for (const name of ["VOICEVOX_STUB_ANALYSIS_US", "VOICEVOX_STUB_SYNTHESIS_US", "VOICEVOX_STUB_DICT_US"]) {
+    if (process.env[name] === undefined) process.env[name] = "0";
+  }
+}
+
+v8.setFlagsFromString("--expose-gc");
+const gc = vm.runInNewContext("gc");
+
+/**
+ * 1周分の呼び出し。ポインタ名は0を常駐用、1を作成・解放の確認用に使う
+ * @type {Array<(ctx: any, state: any) => void>}
+ */
+const MIX = [
+  (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerTtsV0_16(0, args.text, args.style, false).resultCode, "tts"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxSynthesizerTtsFromKanaV0_16(0, state.kana, args.style, false).resultCode, "ttsFromKana"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxSynthesizerSynthesisV0_16(0, state.audioQuery, args.style, false).resultCode, "synthesis"),
+  (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerCreateAudioQueryV0_16(0, args.text, args.style).resultCode, "createAudioQuery"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxSynthesizerCreateAudioQueryFromKanaV0_16(0, state.kana, args.style).resultCode, "createAudioQueryFromKana"),
+  (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerCreateAccentPhrasesV0_16(0, args.text, args.style).resultCode, "createAccentPhrases"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxSynthesizerCreateAccentPhrasesFromKanaV0_16(0, state.kana, args.style).resultCode, "createAccentPhrasesFromKana"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxSynthesizerReplaceMoraDataV0_16(0, state.accentPhrases, args.style).resultCode, "replaceMoraData"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxSynthesizerReplacePhonemeLengthV0_16(0, state.accentPhrases, args.style).resultCode, "replacePhonemeLength"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxSynthesizerReplaceMoraPitchV0_16(0, state.accentPhrases, args.style).resultCode, "replaceMoraPitch"),
+  (ctx) => ctx.core.voicevoxSynthesizerCreateMetasJsonV0_16(0),
+  (ctx) => ctx.core.voicevoxSynthesizerIsLoadedVoiceModelV0_16(0, ctx.modelId),
+  (ctx) => ctx.core.voicevoxErrorResultToMessageV0_12(1),
+  (ctx) => ctx.core.voicevoxGetVersionV0_14(),
+  (ctx) => check(ctx.core, ctx.core.voicevoxOpenJtalkRcNewV0_16(args.dict, 1).resultCode, "openJtalkRcNew"),
+  (ctx) => ctx.core.voicevoxOpenJtalkRcDeleteV0_16(1),
+  (ctx) => check(ctx.core, ctx.core.voicevoxVoiceModelNewFromPathV0_16(args.model, 1).resultCode, "voiceModelNewFromPath"),
+  (ctx) => ctx.core.voicevoxVoiceModelIdV0_16(1),
+  (ctx) => ctx.core.voicevoxVoiceModelGetMetasJsonV0_16(1),
+  (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerNewV0_16(0, 1, 1, args.threads).resultCode, "synthesizerNew"),
+  (ctx) => check(ctx.core, ctx.core.voicevoxSynthesizerLoadVoiceModelV0_16(1, 1).resultCode, "synthesizerLoadVoiceModel"),
+  (ctx) => ctx.core.voicevoxSynthesizerDeleteV0_16(1),
+  (ctx) => ctx.core.voicevoxVoiceModelDeleteV0_16(1),
+  (ctx) => ctx.core.voicevoxUserDictNewV0_16(1),
+  (ctx, state) => {
+    const { resultCode, result } = ctx.core.voicevoxUserDictAddWordV0_16(1, "単語", "タンゴ", 1, 5, 0);
+    check(ctx.core, resultCode, "userDictAddWord");
+    state.uuid = result;
+  },
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxUserDictUpdateWordV0_16(1, "語", "ゴ", 1, 5, 0, state.uuid).resultCode, "userDictUpdateWord"),
+  (ctx) => check(ctx.core, ctx.core.voicevoxUserDictToJsonV0_16(1).resultCode, "userDictToJson"),
+  (ctx) => check(ctx.core, ctx.core.voicevoxOpenJtalkRcUseUserDictV0_16(0, 1).resultCode, "openJtalkRcUseUserDict"),
+  (ctx, state) => check(ctx.core, ctx.core.voicevoxUserDictRemoveWordV0_16(1, state.uuid).resultCode, "userDictRemoveWord"),
+  (ctx) => ctx.core.voicevoxUserDictDeleteV0_16(1),
+];
+
+function sample(ctx, iteration) {
+  gc();
+  const memory = process.memoryUsage();
+  return {
+    iteration,
+    rss: memory.rss,
+    nativeHeap: ctx.core.nativeHeapUsage().result,
+    heapUsed: memory.heapUsed,
+    external: memory.external,
+  };
+}
+
+/**
+ * 最小二乗法による傾き(1呼び出しあたりのバイト数)
+ * @param {Array<{ iteration: number }>} samples
+ * @param {string} key
+ */
+function slope(samples, key) {
+  const n = samples.length;
+  if (n < 2) return 0;
+  const meanX = samples.reduce((a, s) => a + s.iteration, 0) / n;
+  const meanY = samples.reduce((a, s) => a + s[key], 0) / n;
+  let sxy = 0;
+  let sxx = 0;
+  for (const s of samples) {
+    sxy += (s.iteration - meanX) * (s[key] - meanY);
+    sxx += (s.iteration - meanX) ** 2;
+  }
+  return Math.round((sxy / sxx) * 1000) / 1000;
+}
+
+function main() {
+  const ctx = setup(args);
+  const { result: audioQuery } = ctx.core.voicevoxSynthesizerCreateAudioQueryV0_16(0, args.text, args.style);
+  const { result: accentPhrases } = ctx.core.voicevoxSynthesizerCreateAccentPhrasesV0_16(0, args.text, args.style);
+  ctx.core.voicevoxVoiceModelNewFromPathV0_16(args.model, 2);
+  ctx.modelId = ctx.core.voicevoxVoiceModelIdV0_16(2).result;
+  ctx.core.voicevoxVoiceModelDeleteV0_16(2);
+  const state = { audioQuery, accentPhrases, kana: JSON.parse(audioQuery).kana, uuid: "" };
+
+  const samples = [];
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < args.iterations; ) {
+    for (let j = 0; j < MIX.length && i < args.iterations; j++, i++) {
+      MIX[j](ctx, state);
+      if ((i + 1) % args.sampleEvery === 0) {
+        const s = sample(ctx, i + 1);
+        samples.push(s);
+        const mb = (n) => (n / 1048576).toFixed(1);
+        process.stderr.write(`${String(s.iteration).padStart(10)}  rss ${mb(s.rss)}MiB  native ${mb(s.nativeHeap)}MiB  heap ${mb(s.heapUsed)}MiB\n`);
+      }
+    }
+  }
+  const elapsedSec = Number(process.hrtime.bigint() - start) / 1e9;
+
+  const measured = samples.filter((s) => s.iteration > args.warmup);
+  const growth = {
+    rssBytesPerIteration: slope(measured, "rss"),
+    nativeBytesPerIteration: ctx.core.nativeHeapUsage().result < 0 ? null : slope(measured, "nativeHeap"),
+    heapBytesPerIteration: slope(measured, "heapUsed"),
+    externalBytesPerIteration: slope(measured, "external"),
+  };
+  const failures = [];
+  if (growth.nativeBytesPerIteration !== null && growth.nativeBytesPerIteration > args.maxNativeBytesPerIteration) failures.push("native");
+  if (growth.heapBytesPerIteration > args.maxHeapBytesPerIteration) failures.push("heap");
+  if (growth.rssBytesPerIteration > args.maxRssBytesPerIteration) failures.push("rss");
+
+  writeReport(args.out, {
+    schema: "voicevox.js-soak/1",
+    environment: environment(ctx, args),
+    elapsedSec,
+    callsPerSec: Math.round(args.iterations / elapsedSec),
+    growth,
+    passed: failures.length === 0,
+    failures,
+    samples,
+  });
+  teardown(ctx);
+  if (failures.length > 0) {
+    process.stderr.write(`増加量が閾値を超えました: ${failures.join(", ")} ${JSON.stringify(growth)}\n`);
+    process.exitCode = 1;
+  }
+}
+
+main();
@@ -0,0 +1,829 @@
+/**
+ * ベンチマーク用のlibvoicevox_core互換スタブ。
+ *
+ * voicevox_core.h と同じC ABIの関数をエクスポートし、モデルや辞書を読み込まずに
+ * 一定の遅延と出力サイズで応答する。`Voicevox`から通常のvoicevox_coreと同様にdlopenして使う。
+ *
+ * 環境変数(読み込み時に一度だけ参照する)
+ * - `VOICEVOX_STUB_ANALYSIS_US` テキスト解析(AudioQuery, AccentPhrase生成)の遅延(マイクロ秒)
+ * - `VOICEVOX_STUB_SYNTHESIS_US` 音声合成(synthesis, tts, decode)の遅延(マイクロ秒)
+ * - `VOICEVOX_STUB_DICT_US` 辞書構築(OpenJtalkRc構築, ユーザー辞書の適用)の遅延(マイクロ秒)
+ * - `VOICEVOX_STUB_WAV_BYTES` 出力WAVのPCM部分のバイト数
+ * - `VOICEVOX_STUB_SPIN` 1の場合、遅延をsleepではなくビジーループで再現する
+ */
+#include "../voicevox_core.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define VOICEVOX_STUB_EXPORT extern "C" __declspec(dllexport)
+#else
+#define VOICEVOX_STUB_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+namespace
+{
+  // voicevox_coreの結果コード(voicevox_core.d.ts VoicevoxResultCodeV0_16)
+  const int32_t RESULT_OK = 0;
+  const int32_t RESULT_MODEL_NOT_FOUND_ERROR = 7;
+  const int32_t RESULT_LOAD_USER_DICT_ERROR = 20;
+  const int32_t RESULT_SAVE_USER_DICT_ERROR = 21;
+  const int32_t RESULT_USER_DICT_WORD_NOT_FOUND_ERROR = 22;
+  const int32_t RESULT_INVALID_USER_DICT_WORD_ERROR = 24;
+  const int32_t RESULT_MODEL_ALREADY_LOADED_ERROR = 18;
+
+  const uint32_t SAMPLING_RATE = 24000;
+
+  uint64_t env_u64(const char *name, uint64_t fallback)
+  {
+    const char *value = std::getenv(name);
+    if (value == NULL || *value == '\0')
+      return fallback;
+    return std::strtoull(value, NULL, 10);
+  }
+
+  struct StubConfig
+  {
+    uint64_t analysis_us = env_u64("VOICEVOX_STUB_ANALYSIS_US", 200);
+    uint64_t synthesis_us = env_u64("VOICEVOX_STUB_SYNTHESIS_US", 1000);
+    uint64_t dict_us = env_u64("VOICEVOX_STUB_DICT_US", 5000);
+    uint64_t wav_bytes = env_u64("VOICEVOX_STUB_WAV_BYTES", SAMPLING_RATE * 2) & ~static_cast<uint64_t>(1);
+    bool spin = env_u64("VOICEVOX_STUB_SPIN", 0) != 0;
+  };
+
+  const StubConfig &config()
+  {
+    static const StubConfig instance;
+    return instance;
+  }
+
+  void delay(uint64_t us)
+  {
+    if (us == 0)
+      return;
+    if (!config().spin)
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(us));
+      return;
+    }
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+    volatile uint64_t sink = 0;
+    while (std::chrono::steady_clock::now() < until)
+      sink = sink + 1;
+  }
+
+  char *dup_string(const std::string &str)
+  {
+    char *out = static_cast<char *>(std::malloc(str.size() + 1));
+    std::memcpy(out, str.c_str(), str.size() + 1);
+    return out;
+  }
+
+  std::string json_escape(const std::string &str)
+  {
+    std::string out;
+    out.reserve(str.size() + 2);
+    for (char c : str)
+    {
+      switch (c)
+      {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        out += c;
+      }
+    }
+    return out;
+  }
+
+  // UTF-8の1文字ずつに分割する
+  std::vector<std::string> split_utf8(const std::string &str)
+  {
+    std::vector<std::string> chars;
+    size_t i = 0;
+    while (i < str.size())
+    {
+      unsigned char c = static_cast<unsigned char>(str[i]);
+      size_t len = c < 0x80 ? 1 : c < 0xE0 ? 2
+                              : c < 0xF0   ? 3
+                                           : 4;
+      if (i + len > str.size())
+        len = str.size() - i;
+      chars.push_back(str.substr(i, len));
+      i += len;
+    }
+    return chars;
+  }
+
+  // 半角の表記を全角に変換する(voicevox_coreのユーザー辞書と同じ正規化)
+  std::string to_zenkaku(const std::string &surface)
+  {
+    std::string out;
+    for (unsigned char c : surface)
+    {
+      uint32_t cp;
+      if (c == ' ')
+        cp = 0x3000;
+      else if (c >= 0x21 && c <= 0x7E)
+        cp = c + 0xFEE0;
+      else
+      {
+        out += static_cast<char>(c);
+        continue;
+      }
+      out += static_cast<char>(0xE0 | (cp >> 12));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+  }
+
+  // モーラ列からAccentPhraseとAquesTalk風記法を組み立てる(4モーラごとに1句)
+  void build_accent_phrases(const std::vector<std::string> &moras, VoicevoxStyleId style_id, std::string &accent_phrases, std::string &kana)
+  {
+    const size_t phrase_size = 4;
+    double pitch = 5.0 + static_cast<double>(style_id % 10) * 0.1;
+    accent_phrases = "[";
+    kana.clear();
+    for (size_t begin = 0; begin < moras.size(); begin += phrase_size)
+    {
+      size_t end = begin + phrase_size < moras.size() ? begin + phrase_size : moras.size();
+      if (begin != 0)
+      {
+        accent_phrases += ",";
+        kana += "/";
+      }
+      accent_phrases += "{\"moras\":[";
+      for (size_t i = begin; i < end; i++)
+      {
+        if (i != begin)
+          accent_phrases += ",";
+        char numbers[128];
+        std::snprintf(numbers, sizeof(numbers), "\"consonant\":\"k\",\"consonant_length\":0.05,\"vowel\":\"a\",\"vowel_length\":0.1,\"pitch\":%.2f", pitch);
+        accent_phrases += "{\"text\":\"" + json_escape(moras[i]) + "\"," + numbers + "}";
+        kana += moras[i];
+        if (i == begin)
+          kana += "'";
+      }
+      accent_phrases += "],\"accent\":1,\"pause_mora\":null,\"is_interrogative\":false}";
+    }
+    accent_phrases += "]";
+  }
+
+  std::vector<std::string> kana_to_moras(const std::string &kana)
+  {
+    std::vector<std::string> moras;
+    for (const std::string &c : split_utf8(kana))
+    {
+      if (c == "'" || c == "/" || c == "," || c == "_" || c == "?")
+        continue;
+      moras.push_back(c);
+    }
+    return moras;
+  }
+
+  std::string build_audio_query(const std::vector<std::string> &moras, VoicevoxStyleId style_id)
+  {
+    std::string accent_phrases, kana;
+    build_accent_phrases(moras, style_id, accent_phrases, kana);
+    return "{\"accent_phrases\":" + accent_phrases +
+           ",\"speed_scale\":1.0,\"pitch_scale\":0.0,\"intonation_scale\":1.0,\"volume_scale\":1.0,\"pre_phoneme_length\":0.1,\"post_phoneme_length\":0.1,\"output_sampling_rate\":24000,\"output_stereo\":false,\"kana\":\"" +
+           json_escape(kana) + "\"}";
+  }
+
+  void write_u32(uint8_t *dst, uint32_t value)
+  {
+    for (int i = 0; i < 4; i++)
+      dst[i] = static_cast<uint8_t>(value >> (i * 8));
+  }
+
+  void write_u16(uint8_t *dst, uint16_t value)
+  {
+    dst[0] = static_cast<uint8_t>(value);
+    dst[1] = static_cast<uint8_t>(value >> 8);
+  }
+
+  // 24kHz/16bit/モノラルのサイン波WAVを生成する
+  std::vector<uint8_t> make_template_wav()
+  {
+    uint64_t data_bytes = config().wav_bytes;
+    std::vector<uint8_t> wav(44 + data_bytes);
+    std::memcpy(wav.data(), "RIFF", 4);
+    write_u32(wav.data() + 4, static_cast<uint32_t>(36 + data_bytes));
+    std::memcpy(wav.data() + 8, "WAVEfmt ", 8);
+    write_u32(wav.data() + 16, 16);
+    write_u16(wav.data() + 20, 1);
+    write_u16(wav.data() + 22, 1);
+    write_u32(wav.data() + 24, SAMPLING_RATE);
+    write_u32(wav.data() + 28, SAMPLING_RATE * 2);
+    write_u16(wav.data() + 32, 2);
+    write_u16(wav.data() + 34, 16);
+    std::memcpy(wav.data() + 36, "data", 4);
+    write_u32(wav.data() + 40, static_cast<uint32_t>(data_bytes));
+    for (uint64_t i = 0; i < data_bytes / 2; i++)
+    {
+      double sample = std::sin(2.0 * M_PI * 220.0 * static_cast<double>(i) / SAMPLING_RATE) * 8000.0;
+      write_u16(wav.data() + 44 + i * 2, static_cast<uint16_t>(static_cast<int16_t>(sample)));
+    }
+    return wav;
+  }
+
+  // 呼び出し毎の生成コストを計測に含めないよう、雛形をコピーして返す
+  void make_wav(uintptr_t *output_wav_length, uint8_t **output_wav)
+  {
+    static const std::vector<uint8_t> wav_template = make_template_wav();
+    uint8_t *wav = static_cast<uint8_t *>(std::malloc(wav_template.size()));
+    std::memcpy(wav, wav_template.data(), wav_template.size());
+    *output_wav_length = static_cast<uintptr_t>(wav_template.size());
+    *output_wav = wav;
+  }
+
+  struct StubWord
+  {
+    std::string surface;
+    std::string pronunciation;
+    uintptr_t accent_type;
+    int32_t word_type;
+    uint32_t priority;
+  };
+
+  typedef std::array<uint8_t, 16> Uuid;
+}
+
+struct OpenJtalkRc
+{
+  std::string dic_dir;
+  std::atomic<uint64_t> user_dict_words{0};
+};
+
+struct VoicevoxVoiceModel
+{
+  std::string id;
+  std::string metas;
+};
+
+struct VoicevoxSynthesizer
+{
+  std::mutex mutex;
+  std::set<std::string> loaded;
+};
+
+struct VoicevoxUserDict
+{
+  std::mutex mutex;
+  std::map<Uuid, StubWord> words;
+};
+
+namespace
+{
+  Uuid new_uuid()
+  {
+    static std::mutex mutex;
+    static std::mt19937_64 engine(std::random_device{}());
+    std::lock_guard<std::mutex> lock(mutex);
+    Uuid uuid;
+    uint64_t a = engine(), b = engine();
+    for (int i = 0; i < 8; i++)
+    {
+      uuid[i] = static_cast<uint8_t>(a >> (i * 8));
+      uuid[i + 8] = static_cast<uint8_t>(b >> (i * 8));
+    }
+    uuid[6] = (uuid[6] & 0x0F) | 0x40;
+    uuid[8] = (uuid[8] & 0x3F) | 0x80;
+    return uuid;
+  }
+
+  std::string uuid_to_string(const Uuid &uuid)
+  {
+    char str[37];
+    std::snprintf(str, sizeof(str), "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+                  uuid[0], uuid[1], uuid[2], uuid[3], uuid[4], uuid[5], uuid[6], uuid[7],
+                  uuid[8], uuid[9], uuid[10], uuid[11], uuid[12], uuid[13], uuid[14], uuid[15]);
+    return str;
+  }
+
+  bool uuid_from_string(const std::string &str, Uuid &uuid)
+  {
+    std::string hex;
+    for (char c : str)
+      if (c != '-')
+        hex += c;
+    if (hex.size() != 32)
+      return false;
+    for (int i = 0; i < 16; i++)
+      uuid[i] = static_cast<uint8_t>(std::strtoul(hex.substr(i * 2, 2).c_str(), NULL, 16));
+    return true;
+  }
+
+  const char *WORD_TYPES[] = {"PROPER_NOUN", "COMMON_NOUN", "VERB", "ADJECTIVE", "SUFFIX"};
+
+  std::string user_dict_json(const std::map<Uuid, StubWord> &words)
+  {
+    std::string json = "{";
+    bool first = true;
+    for (const auto &entry : words)
+    {
+      if (!first)
+        json += ",";
+      first = false;
+      const StubWord &word = entry.second;
+      char numbers[160];
+      std::snprintf(numbers, sizeof(numbers), "\"accent_type\":%zu,\"word_type\":\"%s\",\"priority\":%u,\"mora_count\":%zu",
+                    static_cast<size_t>(word.accent_type), WORD_TYPES[word.word_type], word.priority, split_utf8(word.pronunciation).size());
+      json += "\"" + uuid_to_string(entry.first) + "\":{\"surface\":\"" + json_escape(word.surface) + "\",\"pronunciation\":\"" + json_escape(word.pronunciation) + "\"," + numbers + "}";
+    }
+    return json + "}";
+  }
+
+  // user_dict_jsonで出力した形式のみを読み込む簡易パーサ
+  bool parse_user_dict_json(const std::string &json, std::map<Uuid, StubWord> &words)
+  {
+    size_t pos = 0;
+    auto skip = [&]()
+    {
+      while (pos < json.size() && std::strchr(" \t\r\n:,", json[pos]) != NULL)
+        pos++;
+    };
+    auto read_string = [&](std::string &out) -> bool
+    {
+      skip();
+      if (pos >= json.size() || json[pos] != '"')
+        return false;
+      out.clear();
+      for (pos++; pos < json.size() && json[pos] != '"'; pos++)
+      {
+        if (json[pos] == '\\' && pos + 1 < json.size())
+          pos++;
+        out += json[pos];
+      }
+      pos++;
+      return true;
+    };
+    skip();
+    if (pos >= json.size() || json[pos++] != '{')
+      return false;
+    while (true)
+    {
+      skip();
+      if (pos < json.size() && json[pos] == '}')
+        return true;
+      std::string key;
+      Uuid uuid;
+      if (!read_string(key) || !uuid_from_string(key, uuid))
+        return false;
+      skip();
+      if (pos >= json.size() || json[pos++] != '{')
+        return false;
+      StubWord word{"", "", 0, 0, 5};
+      while (true)
+      {
+        skip();
+        if (pos < json.size() && json[pos] == '}')
+        {
+          pos++;
+          break;
+        }
+        std::string field, value;
+        if (!read_string(field))
+          return false;
+        skip();
+        if (pos < json.size() && json[pos] == '"')
+          read_string(value);
+        else
+          while (pos < json.size() && std::strchr(",}", json[pos]) == NULL)
+            value += json[pos++];
+        if (field == "surface")
+          word.surface = value;
+        else if (field == "pronunciation")
+          word.pronunciation = value;
+        else if (field == "accent_type")
+          word.accent_type = std::strtoul(value.c_str(), NULL, 10);
+        else if (field == "priority")
+          word.priority = static_cast<uint32_t>(std::strtoul(value.c_str(), NULL, 10));
+        else if (field == "word_type")
+          for (int i = 0; i < 5; i++)
+            if (value == WORD_TYPES[i])
+              word.word_type = i;
+      }
+      words[uuid] = word;
+    }
+  }
+
+  bool valid_word(const VoicevoxUserDictWord *word)
+  {
+    return word->surface != NULL && word->pronunciation != NULL && *word->surface != '\0' && *word->pronunciation != '\0' &&
+           word->priority <= 10 && word->word_type >= 0 && word->word_type <= 4;
+  }
+
+  StubWord to_stub_word(const VoicevoxUserDictWord *word)
+  {
+    return StubWord{to_zenkaku(word->surface), word->pronunciation, word->accent_type, word->word_type, word->priority};
+  }
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_open_jtalk_rc_new(const char *open_jtalk_dic_dir, OpenJtalkRc **out_open_jtalk)
+{
+  delay(config().dict_us);
+  OpenJtalkRc *open_jtalk = new OpenJtalkRc();
+  open_jtalk->dic_dir = open_jtalk_dic_dir;
+  *out_open_jtalk = open_jtalk;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_open_jtalk_rc_use_user_dict(const OpenJtalkRc *open_jtalk, const VoicevoxUserDict *user_dict)
+{
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  size_t count;
+  {
+    std::lock_guard<std::mutex> lock(dict->mutex);
+    count = dict->words.size();
+  }
+  delay(config().dict_us);
+  const_cast<OpenJtalkRc *>(open_jtalk)->user_dict_words = count;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT void voicevox_open_jtalk_rc_delete(OpenJtalkRc *open_jtalk)
+{
+  delete open_jtalk;
+}
+
+VOICEVOX_STUB_EXPORT VoicevoxInitializeOptions voicevox_make_default_initialize_options()
+{
+  return VoicevoxInitializeOptions{VOICEVOX_ACCELERATION_MODE_AUTO, 0};
+}
+
+VOICEVOX_STUB_EXPORT const char *voicevox_get_version()
+{
+  return "0.16.0-stub";
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_voice_model_new_from_path(const char *path, VoicevoxVoiceModel **out_model)
+{
+  VoicevoxVoiceModel *model = new VoicevoxVoiceModel();
+  model->id = uuid_to_string(new_uuid());
+  model->metas = "[{\"name\":\"stub\",\"styles\":[{\"id\":0,\"name\":\"ノーマル\"}],\"version\":\"0.16.0\",\"speaker_uuid\":\"" + model->id + "\"}]";
+  (void)path;
+  *out_model = model;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT const char *voicevox_voice_model_id(const VoicevoxVoiceModel *model)
+{
+  return model->id.c_str();
+}
+
+VOICEVOX_STUB_EXPORT const char *voicevox_voice_model_get_metas_json(const VoicevoxVoiceModel *model)
+{
+  return model->metas.c_str();
+}
+
+VOICEVOX_STUB_EXPORT void voicevox_voice_model_delete(VoicevoxVoiceModel *model)
+{
+  delete model;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_new(const OpenJtalkRc *open_jtalk, VoicevoxInitializeOptions options, VoicevoxSynthesizer **out_synthesizer)
+{
+  (void)open_jtalk;
+  (void)options;
+  *out_synthesizer = new VoicevoxSynthesizer();
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT void voicevox_synthesizer_delete(VoicevoxSynthesizer *synthesizer)
+{
+  delete synthesizer;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_load_voice_model(const VoicevoxSynthesizer *synthesizer, const VoicevoxVoiceModel *model)
+{
+  VoicevoxSynthesizer *synth = const_cast<VoicevoxSynthesizer *>(synthesizer);
+  std::lock_guard<std::mutex> lock(synth->mutex);
+  if (!synth->loaded.insert(model->id).second)
+    return RESULT_MODEL_ALREADY_LOADED_ERROR;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_unload_voice_model(const VoicevoxSynthesizer *synthesizer, const char *model_id)
+{
+  VoicevoxSynthesizer *synth = const_cast<VoicevoxSynthesizer *>(synthesizer);
+  std::lock_guard<std::mutex> lock(synth->mutex);
+  if (synth->loaded.erase(model_id) == 0)
+    return RESULT_MODEL_NOT_FOUND_ERROR;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT bool voicevox_synthesizer_is_gpu_mode(const VoicevoxSynthesizer *synthesizer)
+{
+  (void)synthesizer;
+  return false;
+}
+
+VOICEVOX_STUB_EXPORT bool voicevox_synthesizer_is_loaded_voice_model(const VoicevoxSynthesizer *synthesizer, const char *model_id)
+{
+  VoicevoxSynthesizer *synth = const_cast<VoicevoxSynthesizer *>(synthesizer);
+  std::lock_guard<std::mutex> lock(synth->mutex);
+  return synth->loaded.count(model_id) != 0;
+}
+
+VOICEVOX_STUB_EXPORT char *voicevox_synthesizer_create_metas_json(const VoicevoxSynthesizer *synthesizer)
+{
+  (void)synthesizer;
+  return dup_string("[{\"name\":\"stub\",\"styles\":[{\"id\":0,\"name\":\"ノーマル\"}],\"version\":\"0.16.0\",\"speaker_uuid\":\"00000000-0000-4000-8000-000000000000\"}]");
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_create_supported_devices_json(char **output_supported_devices_json)
+{
+  *output_supported_devices_json = dup_string("{\"cpu\":true,\"cuda\":false,\"dml\":false}");
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_create_audio_query_from_kana(const VoicevoxSynthesizer *synthesizer, const char *kana, VoicevoxStyleId style_id, char **output_audio_query_json)
+{
+  (void)synthesizer;
+  delay(config().analysis_us / 4);
+  *output_audio_query_json = dup_string(build_audio_query(kana_to_moras(kana), style_id));
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_create_audio_query(const VoicevoxSynthesizer *synthesizer, const char *text, VoicevoxStyleId style_id, char **output_audio_query_json)
+{
+  (void)synthesizer;
+  delay(config().analysis_us);
+  *output_audio_query_json = dup_string(build_audio_query(split_utf8(text), style_id));
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_create_accent_phrases_from_kana(const VoicevoxSynthesizer *synthesizer, const char *kana, VoicevoxStyleId style_id, char **output_accent_phrases_json)
+{
+  (void)synthesizer;
+  delay(config().analysis_us / 4);
+  std::string accent_phrases, out_kana;
+  build_accent_phrases(kana_to_moras(kana), style_id, accent_phrases, out_kana);
+  *output_accent_phrases_json = dup_string(accent_phrases);
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_create_accent_phrases(const VoicevoxSynthesizer *synthesizer, const char *text, VoicevoxStyleId style_id, char **output_accent_phrases_json)
+{
+  (void)synthesizer;
+  delay(config().analysis_us);
+  std::string accent_phrases, kana;
+  build_accent_phrases(split_utf8(text), style_id, accent_phrases, kana);
+  *output_accent_phrases_json = dup_string(accent_phrases);
+  return RESULT_OK;
+}
+
+// 音高・音素長の再生成は入力をそのまま返す
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_replace_mora_data(const VoicevoxSynthesizer *synthesizer, const char *accent_phrases_json, VoicevoxStyleId style_id, char **output_accent_phrases_json)
+{
+  (void)synthesizer;
+  (void)style_id;
+  delay(config().analysis_us / 4);
+  *output_accent_phrases_json = dup_string(accent_phrases_json);
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_replace_phoneme_length(const VoicevoxSynthesizer *synthesizer, const char *accent_phrases_json, VoicevoxStyleId style_id, char **output_accent_phrases_json)
+{
+  return voicevox_synthesizer_replace_mora_data(synthesizer, accent_phrases_json, style_id, output_accent_phrases_json);
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_replace_mora_pitch(const VoicevoxSynthesizer *synthesizer, const char *accent_phrases_json, VoicevoxStyleId style_id, char **output_accent_phrases_json)
+{
+  return voicevox_synthesizer_replace_mora_data(synthesizer, accent_phrases_json, style_id, output_accent_phrases_json);
+}
+
+VOICEVOX_STUB_EXPORT VoicevoxSynthesisOptions voicevox_make_default_synthesis_options()
+{
+  return VoicevoxSynthesisOptions{true};
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_synthesis(const VoicevoxSynthesizer *synthesizer, const char *audio_query_json, VoicevoxStyleId style_id, VoicevoxSynthesisOptions options, uintptr_t *output_wav_length, uint8_t **output_wav)
+{
+  (void)synthesizer;
+  (void)audio_query_json;
+  (void)style_id;
+  (void)options;
+  delay(config().synthesis_us);
+  make_wav(output_wav_length, output_wav);
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT VoicevoxTtsOptions voicevox_make_default_tts_options()
+{
+  return VoicevoxTtsOptions{true};
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_tts_from_kana(const VoicevoxSynthesizer *synthesizer, const char *kana, VoicevoxStyleId style_id, VoicevoxTtsOptions options, uintptr_t *output_wav_length, uint8_t **output_wav)
+{
+  (void)synthesizer;
+  (void)kana;
+  (void)style_id;
+  (void)options;
+  delay(config().analysis_us / 4 + config().synthesis_us);
+  make_wav(output_wav_length, output_wav);
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_synthesizer_tts(const VoicevoxSynthesizer *synthesizer, const char *text, VoicevoxStyleId style_id, VoicevoxTtsOptions options, uintptr_t *output_wav_length, uint8_t **output_wav)
+{
+  (void)synthesizer;
+  (void)text;
+  (void)style_id;
+  (void)options;
+  delay(config().analysis_us + config().synthesis_us);
+  make_wav(output_wav_length, output_wav);
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT void voicevox_json_free(char *json)
+{
+  std::free(json);
+}
+
+VOICEVOX_STUB_EXPORT void voicevox_wav_free(uint8_t *wav)
+{
+  std::free(wav);
+}
+
+VOICEVOX_STUB_EXPORT const char *voicevox_error_result_to_message(int32_t result_code)
+{
+  switch (result_code)
+  {
+  case RESULT_OK:
+    return "エラーが発生しませんでした";
+  case RESULT_MODEL_NOT_FOUND_ERROR:
+    return "モデルが見つかりませんでした";
+  case RESULT_MODEL_ALREADY_LOADED_ERROR:
+    return "モデルは既に読み込まれています";
+  case RESULT_LOAD_USER_DICT_ERROR:
+    return "ユーザー辞書を読み込めませんでした";
+  case RESULT_SAVE_USER_DICT_ERROR:
+    return "ユーザー辞書を書き込めませんでした";
+  case RESULT_USER_DICT_WORD_NOT_FOUND_ERROR:
+    return "ユーザー辞書に単語が見つかりませんでした";
+  case RESULT_INVALID_USER_DICT_WORD_ERROR:
+    return "ユーザー辞書の単語のバリデーションに失敗しました";
+  default:
+    return "不明なエラー(スタブ)";
+  }
+}
+
+VOICEVOX_STUB_EXPORT VoicevoxUserDictWord voicevox_user_dict_word_make(const char *surface, const char *pronunciation)
+{
+  return VoicevoxUserDictWord{surface, pronunciation, 0, VOICEVOX_USER_DICT_WORD_TYPE_COMMON_NOUN, 5};
+}
+
+VOICEVOX_STUB_EXPORT VoicevoxUserDict *voicevox_user_dict_new()
+{
+  return new VoicevoxUserDict();
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_user_dict_load(const VoicevoxUserDict *user_dict, const char *dict_path)
+{
+  std::FILE *file = std::fopen(dict_path, "rb");
+  if (file == NULL)
+    return RESULT_LOAD_USER_DICT_ERROR;
+  std::string json;
+  char chunk[65536];
+  size_t read;
+  while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    json.append(chunk, read);
+  std::fclose(file);
+  std::map<Uuid, StubWord> words;
+  if (!parse_user_dict_json(json, words))
+    return RESULT_LOAD_USER_DICT_ERROR;
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  std::lock_guard<std::mutex> lock(dict->mutex);
+  for (auto &entry : words)
+    dict->words[entry.first] = entry.second;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_user_dict_add_word(const VoicevoxUserDict *user_dict, const VoicevoxUserDictWord *word, uint8_t (*output_word_uuid)[16])
+{
+  if (!valid_word(word))
+    return RESULT_INVALID_USER_DICT_WORD_ERROR;
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  Uuid uuid = new_uuid();
+  {
+    std::lock_guard<std::mutex> lock(dict->mutex);
+    dict->words[uuid] = to_stub_word(word);
+  }
+  std::memcpy(*output_word_uuid, uuid.data(), 16);
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_user_dict_update_word(const VoicevoxUserDict *user_dict, const uint8_t (*word_uuid)[16], const VoicevoxUserDictWord *word)
+{
+  if (!valid_word(word))
+    return RESULT_INVALID_USER_DICT_WORD_ERROR;
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  Uuid uuid;
+  std::memcpy(uuid.data(), *word_uuid, 16);
+  std::lock_guard<std::mutex> lock(dict->mutex);
+  auto found = dict->words.find(uuid);
+  if (found == dict->words.end())
+    return RESULT_USER_DICT_WORD_NOT_FOUND_ERROR;
+  found->second = to_stub_word(word);
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_user_dict_remove_word(const VoicevoxUserDict *user_dict, const uint8_t (*word_uuid)[16])
+{
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  Uuid uuid;
+  std::memcpy(uuid.data(), *word_uuid, 16);
+  std::lock_guard<std::mutex> lock(dict->mutex);
+  if (dict->words.erase(uuid) == 0)
+    return RESULT_USER_DICT_WORD_NOT_FOUND_ERROR;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_user_dict_to_json(const VoicevoxUserDict *user_dict, char **output_json)
+{
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  std::lock_guard<std::mutex> lock(dict->mutex);
+  *output_json = dup_string(user_dict_json(dict->words));
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_user_dict_import(const VoicevoxUserDict *user_dict, const VoicevoxUserDict *other_dict)
+{
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  VoicevoxUserDict *other = const_cast<VoicevoxUserDict *>(other_dict);
+  if (dict == other)
+    return RESULT_OK;
+  std::map<Uuid, StubWord> words;
+  {
+    std::lock_guard<std::mutex> lock(other->mutex);
+    words = other->words;
+  }
+  std::lock_guard<std::mutex> lock(dict->mutex);
+  for (auto &entry : words)
+    dict->words[entry.first] = entry.second;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT int32_t voicevox_user_dict_save(const VoicevoxUserDict *user_dict, const char *path)
+{
+  VoicevoxUserDict *dict = const_cast<VoicevoxUserDict *>(user_dict);
+  std::string json;
+  {
+    std::lock_guard<std::mutex> lock(dict->mutex);
+    json = user_dict_json(dict->words);
+  }
+  std::FILE *file = std::fopen(path, "wb");
+  if (file == NULL)
+    return RESULT_SAVE_USER_DICT_ERROR;
+  bool ok = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+  ok = std::fclose(file) == 0 && ok;
+  return ok ? RESULT_OK : RESULT_SAVE_USER_DICT_ERROR;
+}
+
+VOICEVOX_STUB_EXPORT void voicevox_user_dict_delete(VoicevoxUserDict *user_dict)
+{
+  delete user_dict;
+}
+
+// v0.14のAPI(voicevoxDecodeV0_14)の計測用
+VOICEVOX_STUB_EXPORT int32_t voicevox_decode(uintptr_t length, uintptr_t phoneme_size, float *f0, float *phoneme_vector, uint32_t speaker_id, uintptr_t *output_decode_data_length, float **output_decode_data)
+{
+  (void)phoneme_size;
+  (void)phoneme_vector;
+  (void)speaker_id;
+  delay(config().synthesis_us);
+  uintptr_t out_length = length * 256;
+  float *data = static_cast<float *>(std::malloc(sizeof(float) * (out_length == 0 ? 1 : out_length)));
+  for (uintptr_t i = 0; i < out_length; i++)
+    data[i] = f0[i / 256] * 0.0001f;
+  *output_decode_data_length = out_length;
+  *output_decode_data = data;
+  return RESULT_OK;
+}
+
+VOICEVOX_STUB_EXPORT void voicevox_decode_data_free(float *decode_data)
+{
+  std::free(decode_data);
+}
@@ -7,6 +7,23 @@
             "sources": [
                 "voicevox.cc",
                 "voicevox_core.cc",
+                "capture.cc",
+                "perf_counters.cc",
+                "async_job.cc",
+                "json_reader.cc",
+                "audio_query.cc",
+                "wav.cc",
+                "resampler.cc",
+                "loudness.cc",
+                "g711.cc",
+                "audio_output.cc",
+                "frame_stream.cc",
+                "pcm_stream.cc",
+                "buffer_pool.cc",
+                "user_dict_index.cc",
+                "user_dict_snapshot.cc",
+                "atomic_file.cc",
+                "fd_output.cc",
                 "addon.cc"
             ],
             "include_dirs": ["<!@(node -p \"require('node-addon-api').include\")"],
@@ -14,7 +31,7 @@
                 [
                     "OS=='win'",
                     {
-                        "defines": ["_HAS_EXCEPTIONS=1"],
+                        "defines": ["_HAS_EXCEPTIONS=1", "NOMINMAX"],
                         "msvs_settings": {
                             "VCCLCompilerTool": {"ExceptionHandling": 1},
                         },
@@ -0,0 +1,142 @@
+#include "buffer_pool.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+  size_t class_bytes(size_t class_index)
+  {
+    return static_cast<size_t>(BUFFER_POOL_MIN_CLASS_BYTES) << class_index;
+  }
+}
+
+BufferPool::~BufferPool()
+{
+  // JS側に渡している領域はLeaseがこのプールを参照しているため、ここに来るのは全て戻った後
+  for (auto &slabs : idle_)
+    for (uint8_t *slab : slabs)
+      std::free(slab);
+}
+
+void BufferPool::set_capacity(size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  trim();
+}
+
+Napi::Buffer<uint8_t> BufferPool::copy(Napi::Env env, const uint8_t *data, size_t size)
+{
+  size_t class_index = 0;
+  uint8_t *slab = acquire(size, class_index);
+  if (slab == nullptr)
+    return Napi::Buffer<uint8_t>::Copy(env, data, size);
+  std::memcpy(slab, data, size);
+  Lease *lease = new Lease{shared_from_this(), class_index};
+  // 回収を促すため、V8に外部のメモリとして知らせる(finalizeで戻す)
+  Napi::MemoryManagement::AdjustExternalMemory(env, static_cast<int64_t>(class_bytes(class_index)));
+  return Napi::Buffer<uint8_t>::NewOrCopy(env, slab, size, BufferPool::finalize, lease);
+}
+
+bool BufferPool::release(Napi::Buffer<uint8_t> buffer)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (buffer.ByteOffset() != 0 || outstanding_.count(buffer.Data()) == 0)
+      return false;
+  }
+  // 切り離すとBackingStoreが解放され、finalizeで領域が戻る
+  buffer.ArrayBuffer().Detach();
+  std::lock_guard<std::mutex> lock(mutex_);
+  released_++;
+  return true;
+}
+
+BufferPoolStats BufferPool::stats()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  BufferPoolStats stats;
+  stats.capacity = capacity_;
+  stats.idle_bytes = idle_bytes_;
+  stats.idle_slabs = idle_slabs_;
+  stats.outstanding_bytes = outstanding_bytes_;
+  stats.outstanding_slabs = outstanding_.size();
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.oversize = oversize_;
+  stats.released = released_;
+  return stats;
+}
+
+void BufferPool::finalize(Napi::Env env, uint8_t *slab, Lease *lease)
+{
+  Napi::MemoryManagement::AdjustExternalMemory(env, -static_cast<int64_t>(class_bytes(lease->class_index)));
+  lease->pool->give_back(slab, lease->class_index);
+  delete lease;
+}
+
+uint8_t *BufferPool::acquire(size_t size, size_t &class_index)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0 || size == 0)
+    return nullptr;
+  class_index = 0;
+  while (class_index < BUFFER_POOL_CLASSES && class_bytes(class_index) < size)
+    class_index++;
+  if (class_index == BUFFER_POOL_CLASSES)
+  {
+    oversize_++;
+    return nullptr;
+  }
+  uint8_t *slab;
+  std::vector<uint8_t *> &slabs = idle_[class_index];
+  if (!slabs.empty())
+  {
+    slab = slabs.back();
+    slabs.pop_back();
+    idle_bytes_ -= class_bytes(class_index);
+    idle_slabs_--;
+    hits_++;
+  }
+  else
+  {
+    slab = static_cast<uint8_t *>(std::malloc(class_bytes(class_index)));
+    if (slab == nullptr)
+      return nullptr;
+    misses_++;
+  }
+  outstanding_.insert(slab);
+  outstanding_bytes_ += class_bytes(class_index);
+  return slab;
+}
+
+void BufferPool::give_back(uint8_t *slab, size_t class_index)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  outstanding_.erase(slab);
+  outstanding_bytes_ -= class_bytes(class_index);
+  if (idle_bytes_ + class_bytes(class_index) > capacity_)
+  {
+    std::free(slab);
+    return;
+  }
+  idle_[class_index].push_back(slab);
+  idle_bytes_ += class_bytes(class_index);
+  idle_slabs_++;
+}
+
+void BufferPool::trim()
+{
+  // 大きい区分から解放する
+  for (size_t class_index = BUFFER_POOL_CLASSES; class_index-- > 0 && idle_bytes_ > capacity_;)
+  {
+    std::vector<uint8_t *> &slabs = idle_[class_index];
+    while (!slabs.empty() && idle_bytes_ > capacity_)
+    {
+      std::free(slabs.back());
+      slabs.pop_back();
+      idle_bytes_ -= class_bytes(class_index);
+      idle_slabs_--;
+    }
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file buffer_pool.h
+ *
+ * 合成結果のBufferに使う領域を、大きさの区分(4KiBから2MiBまでの2のべき乗)ごとに使い回す。
+ *
+ * 結果は区分の領域に写し、その領域を指す外部のBufferとして返す。Bufferが回収されるか、
+ * ::BufferPool::release で手放されると領域は区分に戻り、次の結果に使われる(戻った領域の合計が上限を超える分は解放する)。
+ * 上限を0(既定)にすると使い回さず、これまでどおり`Napi::Buffer::Copy`で作る。
+ *
+ * 手放したBufferは下にあるArrayBufferを切り離すため、JS側からは長さ0に見え、使い回された後の内容は見えない。
+ * 外部のBufferが使えない環境(Electronなど)では複製され、領域はすぐに戻る。
+ *
+ * 作成・手放すのはメインスレッドから。領域が戻るのは回収のタイミングによるため、内部は排他する。
+ */
+#ifndef VOICEVOX_BUFFER_POOL
+#define VOICEVOX_BUFFER_POOL
+
+#include <napi.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+// 最も小さい区分のバイト数と、区分の数(4KiB, 8KiB, ..., 2MiB)
+#define BUFFER_POOL_MIN_CLASS_BYTES 4096
+#define BUFFER_POOL_CLASSES 10
+
+struct BufferPoolStats
+{
+  /** 戻った領域を保持するバイト数の上限 */
+  size_t capacity;
+  /** 戻って保持している領域のバイト数と数 */
+  size_t idle_bytes;
+  size_t idle_slabs;
+  /** JS側にBufferとして渡している領域のバイト数と数 */
+  size_t outstanding_bytes;
+  size_t outstanding_slabs;
+  /** 戻った領域を使えた数 */
+  uint64_t hits;
+  /** 新しく確保した数 */
+  uint64_t misses;
+  /** 最も大きい区分を超えるため使い回さなかった数 */
+  uint64_t oversize;
+  /** ::BufferPool::release で手放された数 */
+  uint64_t released;
+};
+
+class BufferPool : public std::enable_shared_from_this<BufferPool>
+{
+public:
+  BufferPool() = default;
+  BufferPool(const BufferPool &) = delete;
+  BufferPool &operator=(const BufferPool &) = delete;
+  ~BufferPool();
+
+  /**
+   * 戻った領域を保持するバイト数の上限を変える。超えた分はすぐに解放する
+   */
+  void set_capacity(size_t capacity);
+
+  /**
+   * `data`を写したBufferを作る。上限が0の場合や区分に収まらない場合は`Napi::Buffer::Copy`と同じ
+   */
+  Napi::Buffer<uint8_t> copy(Napi::Env env, const uint8_t *data, size_t size);
+
+  /**
+   * このプールが作ったBufferを手放す(ArrayBufferを切り離し、領域を区分に戻す)
+   * @return このプールが作ったBufferでない・既に手放している場合は何もせず`false`
+   */
+  bool release(Napi::Buffer<uint8_t> buffer);
+
+  BufferPoolStats stats();
+
+private:
+  struct Lease
+  {
+    std::shared_ptr<BufferPool> pool;
+    size_t class_index;
+  };
+
+  static void finalize(Napi::Env env, uint8_t *slab, Lease *lease);
+
+  /**
+   * @return 区分に収まらない場合は`nullptr`
+   */
+  uint8_t *acquire(size_t size, size_t &class_index);
+  void give_back(uint8_t *slab, size_t class_index);
+  void trim();
+
+  std::mutex mutex_;
+  size_t capacity_ = 0;
+  size_t idle_bytes_ = 0;
+  size_t idle_slabs_ = 0;
+  size_t outstanding_bytes_ = 0;
+  std::vector<uint8_t *> idle_[BUFFER_POOL_CLASSES];
+  std::unordered_set<const uint8_t *> outstanding_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t oversize_ = 0;
+  uint64_t released_ = 0;
+};
+
+#endif /* VOICEVOX_BUFFER_POOL */
@@ -0,0 +1,189 @@
+#include "capture.h"
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+  void put_u32(std::string &out, uint32_t value)
+  {
+    for (int i = 0; i < 4; i++)
+      out += static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+
+  void put_u64(std::string &out, uint64_t value)
+  {
+    for (int i = 0; i < 8; i++)
+      out += static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+
+  void put_f64(std::string &out, double value)
+  {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_u64(out, bits);
+  }
+
+  /** レコードのうち`input`を除いた部分のバイト数 */
+  const size_t record_fixed_bytes = 88;
+}
+
+Capture::Capture()
+    : active_(false), queued_bytes_(0), max_queue_bytes_(0), stopping_(false), origin_ns_(0), recorded_(0), dropped_(0), written_bytes_(0), file_(nullptr)
+{
+}
+
+Capture::~Capture()
+{
+  stop();
+}
+
+uint64_t Capture::now()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool Capture::start(const std::string &path, size_t max_queue_bytes, std::string &error)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (active_.load() || writer_.joinable())
+  {
+    error = "既に記録中です";
+    return false;
+  }
+  file_ = fopen(path.c_str(), "wb");
+  if (file_ == nullptr)
+  {
+    error = "ファイルを開けませんでした: " + path;
+    return false;
+  }
+  uint64_t unix_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+  std::string header("VVCAPTUR");
+  put_u32(header, CAPTURE_FORMAT_VERSION);
+  put_u32(header, 0);
+  put_u64(header, unix_ns);
+  if (fwrite(header.data(), 1, header.size(), file_) != header.size())
+  {
+    fclose(file_);
+    file_ = nullptr;
+    error = "ファイルに書き込めませんでした: " + path;
+    return false;
+  }
+  queue_.clear();
+  queued_bytes_ = 0;
+  max_queue_bytes_ = max_queue_bytes;
+  stopping_ = false;
+  origin_ns_ = now();
+  recorded_ = 0;
+  dropped_ = 0;
+  written_bytes_ = header.size();
+  writer_ = std::thread(&Capture::run, this);
+  active_.store(true);
+  return true;
+}
+
+CaptureStats Capture::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_.store(false);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+  if (writer_.joinable())
+    writer_.join();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (file_ != nullptr)
+  {
+    fclose(file_);
+    file_ = nullptr;
+  }
+  return CaptureStats{recorded_, dropped_, written_bytes_};
+}
+
+void Capture::record(CaptureBinding binding, uint32_t style_id, const std::string &input, uint8_t flags, int32_t result_code, uint64_t arrival_ns, const CaptureOptions &options)
+{
+  if (!active())
+    return;
+  // 記録開始より前に呼び出されたものは、到着時刻を表せないため記録しない
+  if (arrival_ns < origin_ns_)
+    return;
+  uint64_t latency_ns = now() - arrival_ns;
+  const AudioOutputSpec &output = options.output;
+  uint8_t option_flags = 0;
+  if (output.normalize)
+    option_flags |= CAPTURE_OPTION_NORMALIZE;
+  if (output.trim)
+    option_flags |= CAPTURE_OPTION_TRIM;
+  if (options.pace)
+    option_flags |= CAPTURE_OPTION_PACE;
+  if (options.patch_wav_header)
+    option_flags |= CAPTURE_OPTION_PATCH_WAV_HEADER;
+  // 組み立てはロックの外で行う
+  std::string rec;
+  rec.reserve(4 + record_fixed_bytes + input.size());
+  put_u32(rec, static_cast<uint32_t>(record_fixed_bytes + input.size()));
+  rec += static_cast<char>(binding);
+  rec += static_cast<char>(flags);
+  rec += static_cast<char>(options.variant);
+  rec += static_cast<char>(option_flags);
+  put_u32(rec, style_id);
+  put_u32(rec, static_cast<uint32_t>(result_code));
+  put_u64(rec, arrival_ns - origin_ns_);
+  put_u64(rec, latency_ns);
+  put_u32(rec, output.sample_rate);
+  put_u32(rec, output.format);
+  put_f64(rec, output.target_loudness);
+  put_f64(rec, output.trim_threshold_db);
+  put_u32(rec, output.trim_margin_ms);
+  put_u32(rec, output.fade_in_ms);
+  put_u32(rec, output.fade_out_ms);
+  put_u32(rec, output.pad_start_ms);
+  put_u32(rec, output.pad_end_ms);
+  put_u32(rec, options.frame_ms);
+  put_u32(rec, options.frames_per_batch);
+  put_u32(rec, options.ring_bytes);
+  put_u32(rec, static_cast<uint32_t>(input.size()));
+  rec += input;
+
+  bool notify;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_.load())
+      return;
+    if (queued_bytes_ + rec.size() > max_queue_bytes_)
+    {
+      dropped_++;
+      return;
+    }
+    notify = queue_.empty();
+    queued_bytes_ += rec.size();
+    queue_.push_back(std::move(rec));
+    recorded_++;
+  }
+  if (notify)
+    cv_.notify_one();
+}
+
+void Capture::run()
+{
+  std::deque<std::string> batch;
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]
+               { return stopping_ || !queue_.empty(); });
+      if (queue_.empty() && stopping_)
+        break;
+      batch.swap(queue_);
+      queued_bytes_ = 0;
+    }
+    for (const std::string &rec : batch)
+    {
+      // 書き込みに失敗した場合も呼び出し側には影響させず、書けた分だけ数える
+      written_bytes_ += fwrite(rec.data(), 1, rec.size(), file_);
+    }
+    batch.clear();
+    fflush(file_);
+  }
+}
@@ -0,0 +1,177 @@
+/**
+ * @file capture.h
+ *
+ * 合成系バインディングの呼び出しを記録する(性能調査での再生用)。
+ *
+ * 記録はホットパスでレコードを組み立ててキューに積むだけで、ファイルへの書き込みは専用のスレッドで行う。
+ * キューに溜まったバイト数が上限を超えた場合、そのレコードは捨てて`dropped`に数える(呼び出し側は待たされない)。
+ *
+ * ファイル形式(数値はすべてリトルエンディアン)
+ *
+ * ヘッダ(24バイト)
+ * - magic `VVCAPTUR` (8バイト)
+ * - version u32 (= ::CAPTURE_FORMAT_VERSION)
+ * - reserved u32
+ * - 記録開始時刻 u64 (UNIXエポックからのナノ秒)
+ *
+ * レコード
+ * - length u32 (このフィールドを除いたレコードのバイト数)
+ * - binding u8 (::CaptureBinding)
+ * - flags u8 (bit0: enable_interrogative_upspeak)
+ * - variant u8 (::CaptureVariant)
+ * - option_flags u8 (`CAPTURE_OPTION_*`)
+ * - style_id u32
+ * - result_code i32
+ * - arrival u64 (記録開始からのナノ秒)
+ * - latency u64 (ナノ秒)
+ * - output_sampling_rate u32 (0は変換しない)
+ * - output_format u32 (`AUDIO_OUTPUT_*`)
+ * - target_loudness f64 (`CAPTURE_OPTION_NORMALIZE`の場合のみ意味を持つ)
+ * - trim_threshold_db f64, trim_margin_ms u32 (`CAPTURE_OPTION_TRIM`の場合のみ意味を持つ)
+ * - fade_in_ms u32, fade_out_ms u32, pad_start_ms u32, pad_end_ms u32
+ * - frame_ms u32, frames_per_batch u32 (::CAPTURE_VARIANT_FRAMES のみ)
+ * - ring_bytes u32 (::CAPTURE_VARIANT_STREAM のみ)
+ * - input_length u32
+ * - input (テキスト、カナ、AudioQueryまたはAccentPhraseのJSON、UTF-8)
+ *
+ * 記録開始より前に呼び出され、記録中に完了した呼び出しは記録しない。
+ * 書き込み先のパスやファイルディスクリプタは記録しない。
+ */
+#ifndef VOICEVOX_CAPTURE
+#define VOICEVOX_CAPTURE
+
+#include "audio_output.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#define CAPTURE_FORMAT_VERSION 2
+
+/**
+ * 記録するバインディング。値はファイルに書き込まれるため変更しないこと
+ */
+enum CaptureBinding : uint8_t
+{
+  CAPTURE_SYNTHESIZER_TTS_V0_16 = 1,
+  CAPTURE_SYNTHESIZER_TTS_FROM_KANA_V0_16 = 2,
+  CAPTURE_SYNTHESIZER_SYNTHESIS_V0_16 = 3,
+  CAPTURE_SYNTHESIZER_CREATE_AUDIO_QUERY_V0_16 = 4,
+  CAPTURE_SYNTHESIZER_CREATE_AUDIO_QUERY_FROM_KANA_V0_16 = 5,
+  CAPTURE_SYNTHESIZER_CREATE_ACCENT_PHRASES_V0_16 = 6,
+  CAPTURE_SYNTHESIZER_CREATE_ACCENT_PHRASES_FROM_KANA_V0_16 = 7,
+  CAPTURE_SYNTHESIZER_REPLACE_MORA_DATA_V0_16 = 8,
+  CAPTURE_SYNTHESIZER_REPLACE_PHONEME_LENGTH_V0_16 = 9,
+  CAPTURE_SYNTHESIZER_REPLACE_MORA_PITCH_V0_16 = 10,
+};
+
+#define CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK 0x01
+
+/**
+ * 呼び出したバインディングの種類(同期版・スレッドプール版など)。値はファイルに書き込まれるため変更しないこと
+ */
+enum CaptureVariant : uint8_t
+{
+  /** `voicevoxSynthesizer*V0_16` */
+  CAPTURE_VARIANT_SYNC = 0,
+  /** `voicevoxSynthesizerTtsAsyncV0_16`・`voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16` */
+  CAPTURE_VARIANT_ASYNC = 1,
+  /** `voicevoxSynthesizerSynthesisFramesAsyncV0_16` */
+  CAPTURE_VARIANT_FRAMES = 2,
+  /** `voicevoxSynthesizerSynthesisToFileAsyncV0_16` */
+  CAPTURE_VARIANT_FILE = 3,
+  /** `voicevoxSynthesizerSynthesisToFdAsyncV0_16` */
+  CAPTURE_VARIANT_FD = 4,
+  /** `voicevoxSynthesizerSynthesisStreamV0_16` */
+  CAPTURE_VARIANT_STREAM = 5,
+};
+
+#define CAPTURE_OPTION_NORMALIZE 0x01
+#define CAPTURE_OPTION_TRIM 0x02
+#define CAPTURE_OPTION_PACE 0x04
+#define CAPTURE_OPTION_PATCH_WAV_HEADER 0x08
+
+/**
+ * 呼び出しのオプション。同期版では既定値のまま記録する
+ */
+struct CaptureOptions
+{
+  CaptureVariant variant = CAPTURE_VARIANT_SYNC;
+  AudioOutputSpec output;
+  /** ::CAPTURE_VARIANT_FRAMES */
+  uint32_t frame_ms = 0;
+  uint32_t frames_per_batch = 0;
+  bool pace = false;
+  /** ::CAPTURE_VARIANT_FD */
+  bool patch_wav_header = false;
+  /** ::CAPTURE_VARIANT_STREAM */
+  uint32_t ring_bytes = 0;
+};
+
+struct CaptureStats
+{
+  uint64_t recorded;
+  uint64_t dropped;
+  uint64_t written_bytes;
+};
+
+class Capture
+{
+public:
+  Capture();
+  ~Capture();
+
+  /**
+   * 記録を開始する
+   * @param path 書き込むファイル。既にある場合は上書きする
+   * @param max_queue_bytes 書き込み待ちにできる最大のバイト数
+   * @param error 失敗した場合の理由
+   * @return 開始できたかどうか。既に記録中の場合も`false`
+   */
+  bool start(const std::string &path, size_t max_queue_bytes, std::string &error);
+
+  /**
+   * 記録を停止する。書き込み待ちのレコードは全て書き込んでから戻る
+   */
+  CaptureStats stop();
+
+  bool active() const
+  {
+    return active_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * 現在時刻(ナノ秒、単調増加)。`record`の`arrival_ns`に渡す
+   */
+  static uint64_t now();
+
+  /**
+   * 1回分の呼び出しを記録する。記録中でなければ何もしない
+   * @param arrival_ns 呼び出された時刻(::Capture::now)。記録開始より前の場合は記録しない
+   * @param options 呼び出しのオプション
+   */
+  void record(CaptureBinding binding, uint32_t style_id, const std::string &input, uint8_t flags, int32_t result_code, uint64_t arrival_ns, const CaptureOptions &options = CaptureOptions());
+
+private:
+  void run();
+
+  std::atomic<bool> active_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::string> queue_;
+  size_t queued_bytes_;
+  size_t max_queue_bytes_;
+  bool stopping_;
+  uint64_t origin_ns_;
+  uint64_t recorded_;
+  uint64_t dropped_;
+  uint64_t written_bytes_;
+  FILE *file_;
+  std::thread writer_;
+};
+
+#endif /* VOICEVOX_CAPTURE */
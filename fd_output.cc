@@ -0,0 +1,210 @@
+#include "fd_output.h"
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <stdio.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  std::string errno_message(const char *what, int code)
+  {
+    return std::string(what) + ": " + std::strerror(code);
+  }
+
+#ifndef _WIN32
+  /**
+   * `fd`へ書き込めるようになるまで待つ
+   */
+  bool wait_writable(int fd, uint32_t timeout_ms, std::string &error)
+  {
+    struct pollfd target;
+    target.fd = fd;
+    target.events = POLLOUT;
+    for (;;)
+    {
+      target.revents = 0;
+      int ready = poll(&target, 1, timeout_ms == 0 ? -1 : static_cast<int>(timeout_ms));
+      if (ready > 0)
+      {
+        if (target.revents & POLLNVAL)
+        {
+          error = "ファイルディスクリプタが開かれていません";
+          return false;
+        }
+        // POLLERR・POLLHUPの場合も、理由は次の書き込みのエラーで返す
+        return true;
+      }
+      if (ready == 0)
+      {
+        error = "書き込めるようになるまでの待ち時間が上限を超えました";
+        return false;
+      }
+      if (errno != EINTR)
+      {
+        error = errno_message("書き込みを待てませんでした", errno);
+        return false;
+      }
+    }
+  }
+
+  /**
+   * `iov`の`count`個をすべて書き込む。`iov`は書いた分だけ進める
+   */
+  bool write_all(int fd, struct iovec *iov, int count, uint32_t timeout_ms, uint64_t &written, std::string &error)
+  {
+    while (count > 0)
+    {
+      ssize_t result = writev(fd, iov, count);
+      if (result < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+          if (!wait_writable(fd, timeout_ms, error))
+            return false;
+          continue;
+        }
+        error = errno_message("書き込みに失敗しました", errno);
+        return false;
+      }
+      written += static_cast<uint64_t>(result);
+      size_t remaining = static_cast<size_t>(result);
+      while (count > 0 && remaining >= iov->iov_len)
+      {
+        remaining -= iov->iov_len;
+        iov++;
+        count--;
+      }
+      if (count > 0)
+      {
+        iov->iov_base = static_cast<uint8_t *>(iov->iov_base) + remaining;
+        iov->iov_len -= remaining;
+      }
+    }
+    return true;
+  }
+#endif
+}
+
+bool write_fd(int fd, const std::function<size_t(uint8_t *buffer, size_t capacity)> &fill, uint32_t timeout_ms, uint64_t &written, std::string &error)
+{
+  written = 0;
+  if (fd < 0)
+  {
+    error = "ファイルディスクリプタが正しくありません";
+    return false;
+  }
+  std::vector<uint8_t> buffer(FD_OUTPUT_IOV_COUNT * FD_OUTPUT_CHUNK_BYTES);
+#ifdef _WIN32
+  (void)timeout_ms;
+  for (;;)
+  {
+    size_t size = fill(buffer.data(), buffer.size());
+    if (size == 0)
+      return true;
+    size_t offset = 0;
+    while (offset < size)
+    {
+      int result = _write(fd, buffer.data() + offset, static_cast<unsigned int>(size - offset));
+      if (result < 0)
+      {
+        error = errno_message("書き込みに失敗しました", errno);
+        return false;
+      }
+      offset += static_cast<size_t>(result);
+      written += static_cast<uint64_t>(result);
+    }
+  }
+#else
+  struct iovec iov[FD_OUTPUT_IOV_COUNT];
+  for (;;)
+  {
+    // チャンクごとに埋め、埋まった分をまとめて書く
+    int count = 0;
+    bool ended = false;
+    while (count < FD_OUTPUT_IOV_COUNT)
+    {
+      uint8_t *chunk = buffer.data() + count * FD_OUTPUT_CHUNK_BYTES;
+      size_t size = fill(chunk, FD_OUTPUT_CHUNK_BYTES);
+      if (size == 0)
+      {
+        ended = true;
+        break;
+      }
+      iov[count].iov_base = chunk;
+      iov[count].iov_len = size;
+      count++;
+    }
+    if (!write_all(fd, iov, count, timeout_ms, written, error))
+      return false;
+    if (ended)
+      return true;
+  }
+#endif
+}
+
+bool fd_tell(int fd, int64_t &offset, std::string &error)
+{
+#ifdef _WIN32
+  offset = _lseeki64(fd, 0, SEEK_CUR);
+#else
+  offset = static_cast<int64_t>(lseek(fd, 0, SEEK_CUR));
+#endif
+  if (offset < 0)
+  {
+    error = errno_message("シークできないファイルディスクリプタのため、後からヘッダを書き換えられません", errno);
+    return false;
+  }
+#ifndef _WIN32
+  // 追記モードではpwriteも末尾に書かれる
+  int flags = fcntl(fd, F_GETFL);
+  if (flags >= 0 && (flags & O_APPEND))
+  {
+    error = "追記モードのファイルディスクリプタのため、後からヘッダを書き換えられません";
+    return false;
+  }
+#endif
+  return true;
+}
+
+bool fd_write_at(int fd, int64_t offset, const uint8_t *data, size_t size, std::string &error)
+{
+#ifdef _WIN32
+  __int64 current = _lseeki64(fd, 0, SEEK_CUR);
+  bool written = current >= 0 && _lseeki64(fd, offset, SEEK_SET) == offset && _write(fd, data, static_cast<unsigned int>(size)) == static_cast<int>(size);
+  int code = errno;
+  if (current >= 0)
+    _lseeki64(fd, current, SEEK_SET);
+  if (!written)
+  {
+    error = errno_message("ヘッダを書き換えられませんでした", code);
+    return false;
+  }
+  return true;
+#else
+  size_t done = 0;
+  while (done < size)
+  {
+    ssize_t result = pwrite(fd, data + done, size - done, static_cast<off_t>(offset + done));
+    if (result < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      error = errno_message("ヘッダを書き換えられませんでした", errno);
+      return false;
+    }
+    done += static_cast<size_t>(result);
+  }
+  return true;
+#endif
+}
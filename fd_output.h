@@ -0,0 +1,46 @@
+/**
+ * @file fd_output.h
+ *
+ * 変換した音声をファイルディスクリプタ(ファイル・パイプ・ソケット)へ直接書き込む。
+ *
+ * POSIXでは::FD_OUTPUT_IOV_COUNT 個のチャンクをまとめて`writev`で書き、途中までしか書けなかった分は続きから書き直す。
+ * 非ブロッキングのディスクリプタ(Node.jsのソケットなど)で`EAGAIN`になった場合は、`poll`で書き込めるようになるまで待つ。
+ * 待つのは専用のスレッドで行うこと(::ThreadJob)。相手が読まない間スレッドプールを塞がないようにするため。
+ * `SIGPIPE`はNode.jsが無視するよう設定しているため、相手が閉じた場合は`EPIPE`のエラーになる。
+ *
+ * WindowsではCRTのファイルディスクリプタ(`fs.open`で開いたファイル)にのみ書き込める。
+ */
+#ifndef VOICEVOX_FD_OUTPUT
+#define VOICEVOX_FD_OUTPUT
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// 1回の`writev`にまとめるチャンクの数と、1チャンクのバイト数
+#define FD_OUTPUT_IOV_COUNT 8
+#define FD_OUTPUT_CHUNK_BYTES 16384
+
+/**
+ * `fill`が0を返すまで、`fill`が書いた内容を`fd`へ順に書き込む。`fd`は閉じない
+ * @param fill `buffer`に最大`capacity`バイト書き、書いたバイト数を返す
+ * @param timeout_ms 書き込めるようになるまで待つ時間の上限(ミリ秒)。0の場合は無制限
+ * @param written 書き込んだバイト数(失敗した場合はそこまで)
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する
+ */
+bool write_fd(int fd, const std::function<size_t(uint8_t *buffer, size_t capacity)> &fill, uint32_t timeout_ms, uint64_t &written, std::string &error);
+
+/**
+ * 後から::fd_write_at で書き換えるために、`fd`の現在の位置を得る
+ * @return シークできない(パイプ・ソケット)か追記モードの場合は`false`を返し、`error`に理由を設定する
+ */
+bool fd_tell(int fd, int64_t &offset, std::string &error);
+
+/**
+ * `fd`の`offset`の位置へ`data`を書く(ストリーミング用のWAVのヘッダを書き換えるなど)。現在の位置は変えない
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する
+ */
+bool fd_write_at(int fd, int64_t offset, const uint8_t *data, size_t size, std::string &error);
+
+#endif /* VOICEVOX_FD_OUTPUT */
@@ -0,0 +1,95 @@
+#include "frame_stream.h"
+#include <algorithm>
+#include <chrono>
+
+Napi::Promise FrameStream::start(Napi::Env env, Napi::Function callback, std::vector<uint8_t> &&audio, const Options &options, ResultFn make_result)
+{
+  FrameStream *stream = new FrameStream(env, std::move(audio), options, std::move(make_result));
+  Napi::Promise promise = stream->deferred_.Promise();
+  stream->tsfn_ = Napi::ThreadSafeFunction::New(env, callback, "voicevoxFrameStream", 0, 1, stream, FrameStream::finalize);
+  stream->thread_ = std::thread(&FrameStream::run, stream);
+  return promise;
+}
+
+FrameStream::FrameStream(Napi::Env env, std::vector<uint8_t> &&audio, const Options &options, ResultFn make_result)
+    : audio_(std::move(audio)), options_(options), make_result_(std::move(make_result)), deferred_(Napi::Promise::Deferred::New(env)), cancelled_(false)
+{
+  // 最後のフレームを無音で埋め、フレームの長さを揃える
+  size_t remainder = audio_.size() % options_.frame_bytes;
+  if (remainder != 0)
+    audio_.resize(audio_.size() + options_.frame_bytes - remainder, options_.silence);
+}
+
+void FrameStream::run()
+{
+  size_t total = audio_.size() / options_.frame_bytes;
+  auto started = std::chrono::steady_clock::now();
+  for (size_t first = 0; first < total; first += options_.frames_per_batch)
+  {
+    if (options_.pace)
+    {
+      auto due = started + std::chrono::nanoseconds(first * options_.frame_ns);
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait_until(lock, due, [this]()
+                       { return cancelled_.load(); });
+    }
+    if (cancelled_)
+      break;
+    size_t frames = std::min(options_.frames_per_batch, total - first);
+    napi_status status = tsfn_.BlockingCall([this, first, frames](Napi::Env env, Napi::Function callback)
+                                            { deliver(env, callback, first, frames); });
+    if (status != napi_ok)
+      break;
+  }
+  tsfn_.Release();
+}
+
+void FrameStream::deliver(Napi::Env env, Napi::Function callback, size_t first, size_t frames)
+{
+  // 環境の終了時は呼び出さずに捨てる
+  if (static_cast<napi_env>(env) == nullptr || callback.IsEmpty() || cancelled_)
+    return;
+  try
+  {
+    Napi::Buffer<uint8_t> batch = Napi::Buffer<uint8_t>::Copy(env, audio_.data() + first * options_.frame_bytes, frames * options_.frame_bytes);
+    Napi::Value ret = callback.Call({batch, Napi::Number::New(env, static_cast<double>(frames))});
+    delivered_ += frames;
+    if (ret.IsBoolean() && !ret.As<Napi::Boolean>().Value())
+      cancel();
+  }
+  catch (const Napi::Error &e)
+  {
+    error_ = Napi::Persistent(e.Value());
+    cancel();
+  }
+}
+
+void FrameStream::cancel()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+  }
+  wake_.notify_all();
+}
+
+void FrameStream::finalize(Napi::Env env, FrameStream *stream)
+{
+  bool cancelled = stream->cancelled_;
+  // 環境の終了で先に呼ばれた場合も、スレッドが待機中なら起こしてから待つ
+  stream->cancel();
+  if (stream->thread_.joinable())
+    stream->thread_.join();
+  if (!stream->error_.IsEmpty())
+    stream->deferred_.Reject(stream->error_.Value());
+  else
+  {
+    Napi::Object obj = stream->make_result_(env);
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("frames", Napi::Number::New(env, static_cast<double>(stream->delivered_)));
+    result.Set("cancelled", Napi::Boolean::New(env, cancelled));
+    obj.Set("result", result);
+    stream->deferred_.Resolve(obj);
+  }
+  delete stream;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file frame_stream.h
+ *
+ * 合成した音声を決まった長さのフレームに区切り、まとめてJSに渡す(RTP・WebRTC向け)。
+ *
+ * 変換済みの音声を最後のフレームまで無音で埋めて保持し、専用のスレッドが`frames_per_batch`フレームずつ
+ * ThreadSafeFunctionで渡す。1回の呼び出しで作るBufferは1つで、JS側ではフレームごとに`subarray`すればよい。
+ * `pace`を指定すると、各バッチをその最初のフレームの再生時刻まで待ってから渡す(実時間で送出する)。
+ *
+ * 自身の寿命はThreadSafeFunctionが管理し、全てのバッチを渡し終えてスレッドが終わった時点で解放される。
+ */
+#ifndef VOICEVOX_FRAME_STREAM
+#define VOICEVOX_FRAME_STREAM
+
+#include <napi.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class FrameStream
+{
+public:
+  struct Options
+  {
+    /** 1フレームのバイト数 */
+    size_t frame_bytes;
+    /** 1回の呼び出しで渡すフレームの数 */
+    size_t frames_per_batch;
+    /** 1フレームの長さ */
+    uint64_t frame_ns;
+    bool pace;
+    /** 最後のフレームの足りない分を埋める無音の値 */
+    uint8_t silence;
+  };
+
+  /** 配信を終えたときのPromiseの値を作る。`result`はこのクラスが設定する */
+  typedef std::function<Napi::Object(Napi::Env)> ResultFn;
+
+  /**
+   * 配信を開始する。メインスレッドから呼ぶこと
+   * @param callback `(batch: Buffer, frames: number) => boolean | void`。`false`を返すか例外を投げると中止する
+   * @return 渡し終えるか中止すると、`make_result`の値に`result: { frames, cancelled }`を加えたもので解決されるPromise。
+   *         `callback`が例外を投げた場合はそれでrejectされる
+   */
+  static Napi::Promise start(Napi::Env env, Napi::Function callback, std::vector<uint8_t> &&audio, const Options &options, ResultFn make_result);
+
+private:
+  FrameStream(Napi::Env env, std::vector<uint8_t> &&audio, const Options &options, ResultFn make_result);
+
+  void run();
+  void deliver(Napi::Env env, Napi::Function callback, size_t first, size_t frames);
+  void cancel();
+  static void finalize(Napi::Env env, FrameStream *stream);
+
+  std::vector<uint8_t> audio_;
+  Options options_;
+  ResultFn make_result_;
+  Napi::Promise::Deferred deferred_;
+  Napi::ThreadSafeFunction tsfn_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::atomic<bool> cancelled_;
+  /** JSに渡したフレームの数(メインスレッドでのみ触る) */
+  size_t delivered_ = 0;
+  /** `callback`が投げた例外 */
+  Napi::ObjectReference error_;
+};
+
+#endif /* VOICEVOX_FRAME_STREAM */
@@ -0,0 +1,93 @@
+#include "g711.h"
+
+namespace
+{
+  // 各セグメントの上限(μ-lawは14ビット、A-lawは13ビットの値に対して)
+  const int16_t ULAW_SEGMENT_END[8] = {0x3f, 0x7f, 0xff, 0x1ff, 0x3ff, 0x7ff, 0xfff, 0x1fff};
+  const int16_t ALAW_SEGMENT_END[8] = {0x1f, 0x3f, 0x7f, 0xff, 0x1ff, 0x3ff, 0x7ff, 0xfff};
+  const int ULAW_BIAS = 0x84;
+  const int ULAW_CLIP = 8159;
+
+  int segment(int value, const int16_t *end)
+  {
+    for (int i = 0; i < 8; i++)
+      if (value <= end[i])
+        return i;
+    return 8;
+  }
+
+  /**
+   * 14ビットの値(16ビットのサンプルを2ビット右シフトしたもの)をμ-lawにする
+   */
+  uint8_t linear14_to_ulaw(int value)
+  {
+    int mask = 0xff;
+    if (value < 0)
+    {
+      value = -value;
+      mask = 0x7f;
+    }
+    if (value > ULAW_CLIP)
+      value = ULAW_CLIP;
+    value += ULAW_BIAS >> 2;
+    int seg = segment(value, ULAW_SEGMENT_END);
+    if (seg >= 8)
+      return static_cast<uint8_t>(0x7f ^ mask);
+    return static_cast<uint8_t>(((seg << 4) | ((value >> (seg + 1)) & 0xf)) ^ mask);
+  }
+
+  /**
+   * 13ビットの値(16ビットのサンプルを3ビット右シフトしたもの)をA-lawにする
+   */
+  uint8_t linear13_to_alaw(int value)
+  {
+    int mask = 0xd5;
+    if (value < 0)
+    {
+      mask = 0x55;
+      value = -value - 1;
+    }
+    int seg = segment(value, ALAW_SEGMENT_END);
+    if (seg >= 8)
+      return static_cast<uint8_t>(0x7f ^ mask);
+    int aval = seg << 4;
+    aval |= seg < 2 ? (value >> 1) & 0xf : (value >> seg) & 0xf;
+    return static_cast<uint8_t>(aval ^ mask);
+  }
+
+  /**
+   * 添字は、右シフトした値の下位ビットをそのまま(負の値は2の補数で)使う
+   */
+  struct Tables
+  {
+    uint8_t ulaw[1 << 14];
+    uint8_t alaw[1 << 13];
+    Tables()
+    {
+      for (int value = -(1 << 13); value < (1 << 13); value++)
+        ulaw[value & 0x3fff] = linear14_to_ulaw(value);
+      for (int value = -(1 << 12); value < (1 << 12); value++)
+        alaw[value & 0x1fff] = linear13_to_alaw(value);
+    }
+  };
+
+  const Tables &tables()
+  {
+    static const Tables instance;
+    return instance;
+  }
+}
+
+void g711_encode_ulaw(const int16_t *samples, size_t count, uint8_t *out)
+{
+  const uint8_t *table = tables().ulaw;
+  for (size_t i = 0; i < count; i++)
+    out[i] = table[(samples[i] >> 2) & 0x3fff];
+}
+
+void g711_encode_alaw(const int16_t *samples, size_t count, uint8_t *out)
+{
+  const uint8_t *table = tables().alaw;
+  for (size_t i = 0; i < count; i++)
+    out[i] = table[(samples[i] >> 3) & 0x1fff];
+}
@@ -0,0 +1,27 @@
+/**
+ * @file g711.h
+ *
+ * G.711(μ-law・A-law)の符号化。
+ *
+ * 16ビットリニアPCMの上位ビット(μ-lawは14ビット、A-lawは13ビット)を添字にした表を一度だけ作り、1サンプルを1回の表引きで符号化する。
+ * 結果はITU-T G.711の参照実装(Sun Microsystemsのg711.c)と一致する。
+ *
+ * ワーカースレッドから呼んでよい。
+ */
+#ifndef VOICEVOX_G711
+#define VOICEVOX_G711
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * `count`サンプルをμ-lawにし、`out`に`count`バイト書く
+ */
+void g711_encode_ulaw(const int16_t *samples, size_t count, uint8_t *out);
+
+/**
+ * `count`サンプルをA-lawにし、`out`に`count`バイト書く
+ */
+void g711_encode_alaw(const int16_t *samples, size_t count, uint8_t *out);
+
+#endif /* VOICEVOX_G711 */
@@ -0,0 +1,279 @@
+#include "json_reader.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void append_utf8(std::string &out, uint32_t code_point)
+{
+  if (code_point < 0x80)
+  {
+    out += static_cast<char>(code_point);
+  }
+  else if (code_point < 0x800)
+  {
+    out += static_cast<char>(0xc0 | (code_point >> 6));
+    out += static_cast<char>(0x80 | (code_point & 0x3f));
+  }
+  else if (code_point < 0x10000)
+  {
+    out += static_cast<char>(0xe0 | (code_point >> 12));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (code_point & 0x3f));
+  }
+  else
+  {
+    out += static_cast<char>(0xf0 | (code_point >> 18));
+    out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (code_point & 0x3f));
+  }
+}
+
+void append_json_string(std::string &out, const std::string &value)
+{
+  out += '"';
+  for (char c : value)
+  {
+    switch (c)
+    {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+        out += escaped;
+      }
+      else
+        out += c;
+    }
+  }
+  out += '"';
+}
+
+void append_json_number(std::string &out, double value)
+{
+  if (!std::isfinite(value))
+  {
+    out += '0';
+    return;
+  }
+  // 読み直したときに同じ値になる、なるべく短い桁数で書く
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+  if (std::strtod(buffer, nullptr) != value)
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  out += buffer;
+}
+
+bool JsonReader::consume(char c)
+{
+  skip_space();
+  if (*p_ != c)
+    return false;
+  p_++;
+  return true;
+}
+
+bool JsonReader::peek(char c)
+{
+  skip_space();
+  return *p_ == c;
+}
+
+bool JsonReader::at_end()
+{
+  skip_space();
+  return *p_ == '\0';
+}
+
+bool JsonReader::read_string(std::string &out)
+{
+  out.clear();
+  if (!consume('"'))
+    return false;
+  while (*p_ != '"')
+  {
+    if (*p_ == '\0')
+      return false;
+    if (*p_ != '\\')
+    {
+      out += *p_++;
+      continue;
+    }
+    p_++;
+    switch (*p_++)
+    {
+    case '"':
+      out += '"';
+      break;
+    case '\\':
+      out += '\\';
+      break;
+    case '/':
+      out += '/';
+      break;
+    case 'b':
+      out += '\b';
+      break;
+    case 'f':
+      out += '\f';
+      break;
+    case 'n':
+      out += '\n';
+      break;
+    case 'r':
+      out += '\r';
+      break;
+    case 't':
+      out += '\t';
+      break;
+    case 'u':
+    {
+      uint32_t code_point;
+      if (!read_hex4(code_point))
+        return false;
+      if (code_point >= 0xd800 && code_point < 0xdc00)
+      {
+        uint32_t low;
+        if (p_[0] != '\\' || p_[1] != 'u')
+          return false;
+        p_ += 2;
+        if (!read_hex4(low) || low < 0xdc00 || low >= 0xe000)
+          return false;
+        code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+      }
+      append_utf8(out, code_point);
+      break;
+    }
+    default:
+      return false;
+    }
+  }
+  p_++;
+  return true;
+}
+
+bool JsonReader::read_uint32(uint32_t &out)
+{
+  skip_space();
+  char *end;
+  unsigned long value = std::strtoul(p_, &end, 10);
+  if (end == p_)
+    return false;
+  p_ = end;
+  out = static_cast<uint32_t>(value);
+  return true;
+}
+
+bool JsonReader::read_double(double &out)
+{
+  skip_space();
+  char *end;
+  double value = std::strtod(p_, &end);
+  if (end == p_)
+    return false;
+  p_ = end;
+  out = value;
+  return true;
+}
+
+bool JsonReader::read_bool(bool &out)
+{
+  skip_space();
+  if (consume_word("true"))
+    out = true;
+  else if (consume_word("false"))
+    out = false;
+  else
+    return false;
+  return true;
+}
+
+bool JsonReader::consume_null()
+{
+  skip_space();
+  return consume_word("null");
+}
+
+bool JsonReader::skip_value()
+{
+  skip_space();
+  if (*p_ == '"')
+  {
+    std::string ignored;
+    return read_string(ignored);
+  }
+  if (*p_ == '{' || *p_ == '[')
+  {
+    char close = *p_ == '{' ? '}' : ']';
+    p_++;
+    if (consume(close))
+      return true;
+    do
+    {
+      if (close == '}')
+      {
+        std::string ignored;
+        if (!read_string(ignored) || !consume(':'))
+          return false;
+      }
+      if (!skip_value())
+        return false;
+    } while (consume(','));
+    return consume(close);
+  }
+  const char *start = p_;
+  while (*p_ != '\0' && std::strchr(",}] \t\r\n", *p_) == nullptr)
+    p_++;
+  return p_ != start;
+}
+
+void JsonReader::skip_space()
+{
+  while (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\n')
+    p_++;
+}
+
+bool JsonReader::consume_word(const char *word)
+{
+  size_t length = std::strlen(word);
+  if (std::strncmp(p_, word, length) != 0)
+    return false;
+  p_ += length;
+  return true;
+}
+
+bool JsonReader::read_hex4(uint32_t &out)
+{
+  out = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    char c = *p_++;
+    out <<= 4;
+    if (c >= '0' && c <= '9')
+      out |= c - '0';
+    else if (c >= 'a' && c <= 'f')
+      out |= c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      out |= c - 'A' + 10;
+    else
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file json_reader.h
+ *
+ * voicevox_coreが出力するJSONを読み書きするための最小限の道具。
+ *
+ * 読む側は、呼び出し側が期待する形を順に`consume`・`read_*`で確かめながら読む(DOMは作らない)。
+ * 書く側は、文字列と数値をJSONとして`std::string`に追記する。
+ */
+#ifndef VOICEVOX_JSON_READER
+#define VOICEVOX_JSON_READER
+
+#include <cstdint>
+#include <string>
+
+/**
+ * コードポイントをUTF-8で追記する
+ */
+void append_utf8(std::string &out, uint32_t code_point);
+
+/**
+ * 文字列をJSONの文字列(引用符付き)として追記する
+ */
+void append_json_string(std::string &out, const std::string &value);
+
+/**
+ * 数値をJSONの数値として追記する(有限でない値は0とする)
+ */
+void append_json_number(std::string &out, double value);
+
+class JsonReader
+{
+public:
+  explicit JsonReader(const char *json) : p_(json) {}
+
+  bool consume(char c);
+  bool peek(char c);
+  bool at_end();
+  bool read_string(std::string &out);
+  bool read_uint32(uint32_t &out);
+  bool read_double(double &out);
+  bool read_bool(bool &out);
+
+  /**
+   * `null`であれば読み進めて`true`を返す
+   */
+  bool consume_null();
+
+  /**
+   * 値を一つ読み飛ばす
+   */
+  bool skip_value();
+
+private:
+  void skip_space();
+  bool consume_word(const char *word);
+  bool read_hex4(uint32_t &out);
+
+  const char *p_;
+};
+
+#endif /* VOICEVOX_JSON_READER */
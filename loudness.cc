@@ -0,0 +1,366 @@
+#include "loudness.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define LOUDNESS_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define LOUDNESS_NEON
+#endif
+
+namespace
+{
+  const double PI = 3.14159265358979323846;
+  // 400msのブロックを100msずつずらす
+  const uint32_t STEPS_PER_BLOCK = 4;
+  const double ABSOLUTE_GATE = -70.0;
+  const double RELATIVE_GATE = -10.0;
+
+  typedef double (*SumSquaresFn)(const float *x, size_t n);
+  typedef void (*ScaleFn)(int16_t *x, size_t n, float gain);
+  typedef int32_t (*PeakFn)(const int16_t *x, size_t n);
+
+  double sum_squares_scalar(const float *x, size_t n)
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++)
+      sum += static_cast<double>(x[i]) * x[i];
+    return sum;
+  }
+
+  int16_t to_int16(float value)
+  {
+    float rounded = std::nearbyint(value);
+    if (rounded > 32767.0f)
+      return 32767;
+    if (rounded < -32768.0f)
+      return -32768;
+    return static_cast<int16_t>(rounded);
+  }
+
+  void scale_scalar(int16_t *x, size_t n, float gain)
+  {
+    for (size_t i = 0; i < n; i++)
+      x[i] = to_int16(x[i] * gain);
+  }
+
+  int32_t peak_scalar(const int16_t *x, size_t n)
+  {
+    int32_t peak = 0;
+    for (size_t i = 0; i < n; i++)
+      peak = std::max(peak, std::abs(static_cast<int32_t>(x[i])));
+    return peak;
+  }
+
+#ifdef LOUDNESS_X86
+#ifndef _MSC_VER
+  __attribute__((target("avx2")))
+#endif
+  double sum_squares_avx2(const float *x, size_t n)
+  {
+    // 長い区間でも精度が落ちないよう、倍精度で足す
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+      __m256 v = _mm256_loadu_ps(x + i);
+      __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+      __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+      acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(lo, lo));
+      acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(hi, hi));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + sum_squares_scalar(x + i, n - i);
+  }
+
+#ifndef _MSC_VER
+  __attribute__((target("avx2")))
+#endif
+  void scale_avx2(int16_t *x, size_t n, float gain)
+  {
+    __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+      __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v));
+      __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1));
+      lo = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(lo), g));
+      hi = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(hi), g));
+      // packsは128ビットごとに詰めるため、並びを戻す
+      __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xd8);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + i), packed);
+    }
+    scale_scalar(x + i, n - i, gain);
+  }
+
+#ifndef _MSC_VER
+  __attribute__((target("avx2")))
+#endif
+  int32_t peak_avx2(const int16_t *x, size_t n)
+  {
+    // -32768の絶対値は符号なしで32768になる
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+      acc = _mm256_max_epu16(acc, _mm256_abs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i))));
+    uint16_t lanes[16];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    int32_t peak = peak_scalar(x + i, n - i);
+    for (uint16_t lane : lanes)
+      peak = std::max(peak, static_cast<int32_t>(lane));
+    return peak;
+  }
+
+  bool cpu_has_avx2()
+  {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 6) != 6)
+      return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+  }
+#endif
+
+#ifdef LOUDNESS_NEON
+  double sum_squares_neon(const float *x, size_t n)
+  {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      float32x4_t v = vld1q_f32(x + i);
+      float64x2_t lo = vcvt_f64_f32(vget_low_f32(v));
+      float64x2_t hi = vcvt_high_f64_f32(v);
+      acc0 = vfmaq_f64(acc0, lo, lo);
+      acc1 = vfmaq_f64(acc1, hi, hi);
+    }
+    return vaddvq_f64(vaddq_f64(acc0, acc1)) + sum_squares_scalar(x + i, n - i);
+  }
+
+  void scale_neon(int16_t *x, size_t n, float gain)
+  {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+      int16x8_t v = vld1q_s16(x + i);
+      float32x4_t lo = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), gain);
+      float32x4_t hi = vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(v)), gain);
+      vst1q_s16(x + i, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(lo)), vqmovn_s32(vcvtnq_s32_f32(hi))));
+    }
+    scale_scalar(x + i, n - i, gain);
+  }
+
+  int32_t peak_neon(const int16_t *x, size_t n)
+  {
+    uint16x8_t acc = vdupq_n_u16(0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+      acc = vmaxq_u16(acc, vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(x + i))));
+    return std::max(peak_scalar(x + i, n - i), static_cast<int32_t>(vmaxvq_u16(acc)));
+  }
+#endif
+
+  struct Kernel
+  {
+    SumSquaresFn sum_squares;
+    ScaleFn scale;
+    PeakFn peak;
+    const char *name;
+    Kernel() : sum_squares(sum_squares_scalar), scale(scale_scalar), peak(peak_scalar), name("scalar")
+    {
+      // 比較用に、環境変数でスカラーの実装に固定できる
+      const char *force_scalar = std::getenv("VOICEVOX_LOUDNESS_SCALAR");
+      if (force_scalar != nullptr && force_scalar[0] != '\0' && force_scalar[0] != '0')
+        return;
+#if defined(LOUDNESS_X86)
+      if (cpu_has_avx2())
+      {
+        sum_squares = sum_squares_avx2;
+        scale = scale_avx2;
+        peak = peak_avx2;
+        name = "avx2";
+      }
+#elif defined(LOUDNESS_NEON)
+      sum_squares = sum_squares_neon;
+      scale = scale_neon;
+      peak = peak_neon;
+      name = "neon";
+#endif
+    }
+  };
+
+  const Kernel &kernel()
+  {
+    static const Kernel instance;
+    return instance;
+  }
+
+  struct Biquad
+  {
+    double b0, b1, b2, a1, a2;
+  };
+
+  /**
+   * BS.1770のKフィルタの1段目(頭部の影響を表す高域シェルフ)と2段目(RLB、高域通過)を`sample_rate`向けに作る
+   */
+  void k_weighting(uint32_t sample_rate, Biquad &shelf, Biquad &high_pass)
+  {
+    double k = std::tan(PI * 1681.974450955533 / sample_rate);
+    double q = 0.7071752369554196;
+    double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    double vb = std::pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    shelf.b0 = (vh + vb * k / q + k * k) / a0;
+    shelf.b1 = 2.0 * (k * k - vh) / a0;
+    shelf.b2 = (vh - vb * k / q + k * k) / a0;
+    shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+    shelf.a2 = (1.0 - k / q + k * k) / a0;
+    k = std::tan(PI * 38.13547087602444 / sample_rate);
+    q = 0.5003270373238773;
+    a0 = 1.0 + k / q + k * k;
+    high_pass.b0 = 1.0;
+    high_pass.b1 = -2.0;
+    high_pass.b2 = 1.0;
+    high_pass.a1 = 2.0 * (k * k - 1.0) / a0;
+    high_pass.a2 = (1.0 - k / q + k * k) / a0;
+  }
+
+  double to_lufs(double mean_square)
+  {
+    return -0.691 + 10.0 * std::log10(mean_square);
+  }
+}
+
+double loudness_measure(const int16_t *samples, size_t frames, uint16_t channels, uint32_t sample_rate)
+{
+  const double silent = -std::numeric_limits<double>::infinity();
+  if (frames == 0 || channels == 0 || sample_rate == 0)
+    return silent;
+  const Kernel &k = kernel();
+  Biquad shelf, high_pass;
+  k_weighting(sample_rate, shelf, high_pass);
+  // 100msごとの二乗和(全チャンネルの和。モノラル・ステレオの重みは1)
+  size_t step = std::max<size_t>(1, sample_rate / 10);
+  size_t steps = frames / step;
+  bool whole = steps < STEPS_PER_BLOCK;
+  std::vector<double> step_energy(whole ? 1 : steps, 0.0);
+  std::vector<float> filtered(frames);
+  for (uint16_t channel = 0; channel < channels; channel++)
+  {
+    // Kフィルタは再帰的なため、サンプル順に倍精度で計算する(-1..1に正規化)
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0, z1 = 0, z2 = 0;
+    for (size_t i = 0; i < frames; i++)
+    {
+      double x = samples[i * channels + channel] / 32768.0;
+      double y = shelf.b0 * x + shelf.b1 * x1 + shelf.b2 * x2 - shelf.a1 * y1 - shelf.a2 * y2;
+      double z = high_pass.b0 * y + high_pass.b1 * y1 + high_pass.b2 * y2 - high_pass.a1 * z1 - high_pass.a2 * z2;
+      x2 = x1;
+      x1 = x;
+      y2 = y1;
+      y1 = y;
+      z2 = z1;
+      z1 = z;
+      filtered[i] = static_cast<float>(z);
+    }
+    if (whole)
+      step_energy[0] += k.sum_squares(filtered.data(), frames);
+    else
+      for (size_t s = 0; s < steps; s++)
+        step_energy[s] += k.sum_squares(filtered.data() + s * step, step);
+  }
+  std::vector<double> blocks;
+  if (whole)
+    blocks.push_back(step_energy[0] / frames);
+  else
+    for (size_t s = 0; s + STEPS_PER_BLOCK <= steps; s++)
+    {
+      double sum = 0.0;
+      for (uint32_t j = 0; j < STEPS_PER_BLOCK; j++)
+        sum += step_energy[s + j];
+      blocks.push_back(sum / (step * STEPS_PER_BLOCK));
+    }
+  double absolute_sum = 0.0;
+  size_t absolute_count = 0;
+  for (double block : blocks)
+    if (block > 0.0 && to_lufs(block) > ABSOLUTE_GATE)
+    {
+      absolute_sum += block;
+      absolute_count++;
+    }
+  if (absolute_count == 0)
+    return silent;
+  double relative_gate = to_lufs(absolute_sum / absolute_count) + RELATIVE_GATE;
+  double sum = 0.0;
+  size_t count = 0;
+  for (double block : blocks)
+    if (block > 0.0 && to_lufs(block) > ABSOLUTE_GATE && to_lufs(block) > relative_gate)
+    {
+      sum += block;
+      count++;
+    }
+  return count == 0 ? silent : to_lufs(sum / count);
+}
+
+void LoudnessNormalizer::start(double measured, double target, uint32_t sample_rate)
+{
+  gain_db_ = std::isfinite(measured) ? std::min(target - measured, LOUDNESS_MAX_GAIN_DB) : 0.0;
+  gain_ = static_cast<float>(std::pow(10.0, gain_db_ / 20.0));
+  ceiling_ = static_cast<float>(32767.0 * std::pow(10.0, LOUDNESS_CEILING_DBFS / 20.0));
+  release_ = sample_rate == 0 ? 1.0f : static_cast<float>(1.0 - std::exp(-1000.0 / (LOUDNESS_RELEASE_MS * sample_rate)));
+  limiter_gain_ = 1.0f;
+}
+
+void LoudnessNormalizer::process(int16_t *samples, size_t frames, uint16_t channels)
+{
+  if (frames == 0 || channels == 0)
+    return;
+  const Kernel &k = kernel();
+  size_t count = frames * channels;
+  // リミッタが効いておらず、利得をかけてもしきい値を超えない区間はまとめて処理する
+  if (limiter_gain_ == 1.0f && k.peak(samples, count) * gain_ <= ceiling_)
+  {
+    if (gain_ != 1.0f)
+      k.scale(samples, count, gain_);
+    return;
+  }
+  for (size_t i = 0; i < frames; i++)
+  {
+    int16_t *frame = samples + i * channels;
+    // 全チャンネルで同じだけ絞る
+    float peak = 0.0f;
+    for (uint16_t channel = 0; channel < channels; channel++)
+      peak = std::max(peak, std::fabs(frame[channel] * gain_));
+    float required = peak > ceiling_ ? ceiling_ / peak : 1.0f;
+    limiter_gain_ += (1.0f - limiter_gain_) * release_;
+    if (required < limiter_gain_)
+      limiter_gain_ = required;
+    else if (limiter_gain_ > 0.9999f)
+      limiter_gain_ = 1.0f;
+    for (uint16_t channel = 0; channel < channels; channel++)
+      frame[channel] = to_int16(frame[channel] * gain_ * limiter_gain_);
+  }
+}
+
+const char *loudness_kernel_name()
+{
+  return kernel().name;
+}
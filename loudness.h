@@ -0,0 +1,71 @@
+/**
+ * @file loudness.h
+ *
+ * ラウドネスの正規化(ITU-R BS.1770 / EBU R128のIntegrated Loudness)。
+ *
+ * 測定はKフィルタ(高域シェルフ+高域通過の2段のbiquad)をかけた信号を400ms(100msずつずらす)のブロックに分け、
+ * -70LUFSの絶対ゲートと、そこから-10LUの相対ゲートを通ったブロックの平均とする。400msより短い音声は全体を1ブロックとする。
+ * 補正は測定値と目標の差だけ一律に利得をかけ、::LOUDNESS_CEILING_DBFS を超える分は瞬時に絞って徐々に戻すピークリミッタで抑える。
+ *
+ * 二乗和と利得をかける処理はAVX2(x86-64、実行時に判定)・NEON(AArch64)・スカラーのいずれかで行う。
+ * ワーカースレッドから呼んでよい。
+ */
+#ifndef VOICEVOX_LOUDNESS
+#define VOICEVOX_LOUDNESS
+
+#include <cstddef>
+#include <cstdint>
+
+// 目標に指定できるラウドネスの範囲(LUFS)
+#define LOUDNESS_MIN_TARGET -70.0
+#define LOUDNESS_MAX_TARGET 0.0
+// 上げる利得の上限(dB)。ほとんど無音の音声を持ち上げすぎないため
+#define LOUDNESS_MAX_GAIN_DB 24.0
+// リミッタのしきい値(dBFS、サンプルピーク)と、絞った後に戻る時定数(ミリ秒)
+#define LOUDNESS_CEILING_DBFS -1.0
+#define LOUDNESS_RELEASE_MS 50.0
+
+/**
+ * 16ビットリニアPCMのラウドネスを測る
+ * @param samples チャンネルごとにインターリーブされた`frames`フレーム
+ * @return LUFS。ゲートを通るブロックが無い(無音)場合は負の無限大
+ */
+double loudness_measure(const int16_t *samples, size_t frames, uint16_t channels, uint32_t sample_rate);
+
+class LoudnessNormalizer
+{
+public:
+  /**
+   * 測定値`measured`を`target`(LUFS)にする利得で始める。測定値が有限でない場合は利得をかけない
+   * @param sample_rate 補正する音声のサンプリングレート(測定したものと違ってよい)
+   */
+  void start(double measured, double target, uint32_t sample_rate);
+
+  /**
+   * かける利得(dB)
+   */
+  double gain_db() const
+  {
+    return gain_db_;
+  }
+
+  /**
+   * `samples`に利得をかけてリミッタを通す。続けて呼ぶとリミッタの状態を引き継ぐ
+   */
+  void process(int16_t *samples, size_t frames, uint16_t channels);
+
+private:
+  double gain_db_ = 0.0;
+  float gain_ = 1.0f;
+  float ceiling_ = 32767.0f;
+  float release_ = 1.0f;
+  /** リミッタが今かけている利得(1なら絞っていない) */
+  float limiter_gain_ = 1.0f;
+};
+
+/**
+ * 使われる実装の名前(`avx2`, `neon`, `scalar`)
+ */
+const char *loudness_kernel_name();
+
+#endif /* VOICEVOX_LOUDNESS */
@@ -0,0 +1,129 @@
+/**
+ * @file lru_cache.h
+ *
+ * 文字列をキーとする、件数で上限を決めるLRUキャッシュ。
+ *
+ * 上限を超えた分は最も長く使われていないものから捨てる。上限を0にすると何も保持しない(無効)。
+ * 命中・失敗の数は呼び出し側が`record`で数える(見つかっても使えない値がある場合に、失敗として数えられるように)。
+ *
+ * メインスレッドからのみ触ること。
+ */
+#ifndef VOICEVOX_LRU_CACHE
+#define VOICEVOX_LRU_CACHE
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+template <class V>
+class LruCache
+{
+public:
+  explicit LruCache(size_t capacity) : capacity_(capacity), hits_(0), misses_(0), evictions_(0)
+  {
+  }
+
+  /**
+   * 上限を変える。超えた分はすぐに捨てる
+   */
+  void set_capacity(size_t capacity)
+  {
+    capacity_ = capacity;
+    trim();
+  }
+
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  size_t size() const
+  {
+    return index_.size();
+  }
+
+  /**
+   * 値を探し、見つかれば最も新しく使われたものとする
+   * @return 見つからなければ`nullptr`。次に`put`・`clear`するまで有効
+   */
+  V *find(const std::string &key)
+  {
+    auto it = index_.find(key);
+    if (it == index_.end())
+      return nullptr;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->second;
+  }
+
+  /**
+   * 値を追加する。同じキーがあれば置き換える
+   */
+  void put(const std::string &key, V value)
+  {
+    if (capacity_ == 0)
+      return;
+    auto it = index_.find(key);
+    if (it != index_.end())
+    {
+      it->second->second = std::move(value);
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.emplace_front(key, std::move(value));
+    index_.emplace(key, entries_.begin());
+    trim();
+  }
+
+  void clear()
+  {
+    entries_.clear();
+    index_.clear();
+  }
+
+  void record(bool hit)
+  {
+    if (hit)
+      hits_++;
+    else
+      misses_++;
+  }
+
+  uint64_t hits() const
+  {
+    return hits_;
+  }
+
+  uint64_t misses() const
+  {
+    return misses_;
+  }
+
+  uint64_t evictions() const
+  {
+    return evictions_;
+  }
+
+private:
+  void trim()
+  {
+    while (index_.size() > capacity_)
+    {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+      evictions_++;
+    }
+  }
+
+  size_t capacity_;
+  uint64_t hits_;
+  uint64_t misses_;
+  uint64_t evictions_;
+  /** 先頭が最も新しく使われたもの */
+  std::list<std::pair<std::string, V>> entries_;
+  std::unordered_map<std::string, typename std::list<std::pair<std::string, V>>::iterator> index_;
+};
+
+#endif /* VOICEVOX_LRU_CACHE */
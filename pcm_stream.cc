@@ -0,0 +1,149 @@
+#include "pcm_stream.h"
+#include <exception>
+
+PcmStream::PcmStream(size_t ring_bytes)
+    : ring_(ring_bytes), cancelled_(false), finished_(false), producer_waiting_(false), consumer_waiting_(false)
+{
+}
+
+void PcmStream::start(std::shared_ptr<PcmStream> stream, Napi::Env env, Napi::Object self, Napi::Function on_readable, ProduceFn produce)
+{
+  // ThreadSafeFunctionが終わるまで、自身への参照をその文脈として持つ
+  auto context = new std::shared_ptr<PcmStream>(stream);
+  stream->tsfn_ = Napi::ThreadSafeFunction::New(env, on_readable, "voicevoxPcmStream", 0, 1, context, PcmStream::finalize);
+  stream->self_ = Napi::Persistent(self);
+  PcmStream *raw = stream.get();
+  raw->thread_ = std::thread(
+      [raw, produce]()
+      {
+        try
+        {
+          produce(*raw);
+        }
+        catch (const std::exception &e)
+        {
+          raw->finish(-1, e.what());
+        }
+        catch (const char *e)
+        {
+          // Windowsのload_funcは文字列を投げる
+          raw->finish(-1, e);
+        }
+        if (!raw->finished_)
+          raw->finish(-1, "書き込みを終えずに終了しました");
+        raw->tsfn_.Release();
+      });
+}
+
+bool PcmStream::write(const uint8_t *data, size_t size)
+{
+  while (size > 0)
+  {
+    if (cancelled_)
+      return false;
+    size_t written = ring_.write(data, size);
+    data += written;
+    size -= written;
+    if (written > 0)
+    {
+      notify_readable();
+      continue;
+    }
+    // 一杯なので、読み出し側が空きを作るまで待つ
+    std::unique_lock<std::mutex> lock(mutex_);
+    producer_waiting_ = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    space_.wait(lock, [this]()
+                { return cancelled_ || ring_.writable() > 0; });
+    producer_waiting_ = false;
+  }
+  return !cancelled_;
+}
+
+void PcmStream::finish(int32_t result_code, const std::string &error)
+{
+  if (finished_)
+    return;
+  result_code_ = result_code;
+  error_ = error;
+  finished_ = true;
+  notify_readable();
+}
+
+void PcmStream::post(MainFn fn)
+{
+  tsfn_.BlockingCall([fn](Napi::Env env, Napi::Function)
+                     {
+                       if (static_cast<napi_env>(env) != nullptr)
+                         fn(env);
+                     });
+}
+
+size_t PcmStream::read(uint8_t *out, size_t max_bytes)
+{
+  size_t read = ring_.read(out, max_bytes);
+  if (read > 0)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (producer_waiting_)
+    {
+      // 待ちに入る前に確かめた空きと行き違わないよう、ロックを取ってから起こす
+      std::lock_guard<std::mutex> lock(mutex_);
+      space_.notify_one();
+    }
+  }
+  return read;
+}
+
+bool PcmStream::wait_readable()
+{
+  consumer_waiting_ = true;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (ring_.readable() > 0 || finished_)
+  {
+    consumer_waiting_ = false;
+    return true;
+  }
+  return false;
+}
+
+void PcmStream::cancel()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+  }
+  space_.notify_all();
+}
+
+void PcmStream::notify_readable()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!consumer_waiting_.exchange(false))
+    return;
+  tsfn_.NonBlockingCall([](Napi::Env env, Napi::Function on_readable)
+                        {
+                          if (static_cast<napi_env>(env) == nullptr || on_readable.IsEmpty())
+                            return;
+                          try
+                          {
+                            on_readable.Call({});
+                          }
+                          catch (const Napi::Error &e)
+                          {
+                            // 捕捉されない例外として扱わせる
+                            e.ThrowAsJavaScriptException();
+                          }
+                        });
+}
+
+void PcmStream::finalize(Napi::Env, std::shared_ptr<PcmStream> *context)
+{
+  std::shared_ptr<PcmStream> stream = *context;
+  delete context;
+  // 環境の終了で先に呼ばれた場合も、書き込みを止めてから待つ
+  stream->cancel();
+  if (stream->thread_.joinable())
+    stream->thread_.join();
+  stream->self_.Reset();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file pcm_stream.h
+ *
+ * 合成した音声を、容量の決まったリングバッファ(::SpscRing)を通してJSのReadableに流す。
+ *
+ * 書き込みは専用のスレッドで行い、リングが一杯の間は読み出されるまで待つ(libuvのスレッドプールは塞がない)。
+ * 読み出しはメインスレッドで行い、空だった場合は`on_readable`で書き込みを知らせる。
+ * そのため1本あたりのメモリはリングの容量と書き込み側の作業領域だけで決まり、JS側の滞留はReadableの`highWaterMark`で抑えられる。
+ *
+ * 自身はThreadSafeFunctionの終了(書き込みスレッドの終了後)まで生存する。読み出しを止める場合は`cancel`を呼ぶこと。
+ */
+#ifndef VOICEVOX_PCM_STREAM
+#define VOICEVOX_PCM_STREAM
+
+#include "spsc_ring.h"
+#include <napi.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// リングバッファの容量の下限
+#define PCM_STREAM_MIN_RING_BYTES 4096
+// 書き込みスレッドが1回に変換するバイト数
+#define PCM_STREAM_CHUNK_BYTES 16384
+
+class PcmStream
+{
+public:
+  /** 書き込みスレッドで実行する処理。`write`で書き込み、最後に`finish`を呼ぶ */
+  typedef std::function<void(PcmStream &stream)> ProduceFn;
+  /** メインスレッドで実行する処理 */
+  typedef std::function<void(Napi::Env)> MainFn;
+
+  explicit PcmStream(size_t ring_bytes);
+
+  /**
+   * 書き込みスレッドを開始する。メインスレッドから呼ぶこと
+   * @param self 終わるまで参照を保持するオブジェクト(`produce`が使うもの)
+   * @param on_readable 読み出しが空で待っているところに書き込まれたとき(と書き込みを終えたとき)に呼ばれる
+   */
+  static void start(std::shared_ptr<PcmStream> stream, Napi::Env env, Napi::Object self, Napi::Function on_readable, ProduceFn produce);
+
+  /**
+   * 全て書き込むまで、リングに空きができるのを待ちながら書き込む。書き込みスレッドから呼ぶ
+   * @return 中止された場合は`false`
+   */
+  bool write(const uint8_t *data, size_t size);
+
+  /**
+   * 書き込みを終える。書き込みスレッドから呼ぶ
+   * @param result_code voicevox_coreの結果コード
+   * @param error 空でなければ読み出し側で例外にする
+   */
+  void finish(int32_t result_code, const std::string &error);
+
+  /**
+   * `fn`をメインスレッドで実行する(完了は待たない)。書き込みスレッドから呼ぶ
+   */
+  void post(MainFn fn);
+
+  /**
+   * 読み出せるだけ読み出す。メインスレッドから呼ぶ
+   * @return 読み出したバイト数。0の場合は`ended`か`wait_readable`で確かめる
+   */
+  size_t read(uint8_t *out, size_t max_bytes);
+
+  size_t readable() const
+  {
+    return ring_.readable();
+  }
+
+  /**
+   * 書き込みを終え、全て読み出したかどうか
+   */
+  bool ended() const
+  {
+    return finished_ && ring_.readable() == 0;
+  }
+
+  /**
+   * 次に書き込まれたときに`on_readable`を呼ぶようにする
+   * @return 既に読み出せるか終わっている場合は`true`(`on_readable`は呼ばれないことがある)
+   */
+  bool wait_readable();
+
+  int32_t result_code() const
+  {
+    return result_code_;
+  }
+
+  const std::string &error() const
+  {
+    return error_;
+  }
+
+  /**
+   * 書き込みを中止する。メインスレッドから呼ぶ
+   */
+  void cancel();
+
+private:
+  void notify_readable();
+  static void finalize(Napi::Env env, std::shared_ptr<PcmStream> *context);
+
+  SpscRing ring_;
+  Napi::ThreadSafeFunction tsfn_;
+  Napi::ObjectReference self_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable space_;
+  std::atomic<bool> cancelled_;
+  std::atomic<bool> finished_;
+  std::atomic<bool> producer_waiting_;
+  std::atomic<bool> consumer_waiting_;
+  /** `finished_`を立てる前に設定する */
+  int32_t result_code_ = 0;
+  std::string error_;
+};
+
+#endif /* VOICEVOX_PCM_STREAM */
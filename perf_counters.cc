@@ -0,0 +1,183 @@
+#include "perf_counters.h"
+#include <chrono>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace
+{
+  uint64_t now_ns()
+  {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+#ifdef __linux__
+  /**
+   * スレッド毎のカウンタ群(サイクル数をリーダーとするグループ)
+   */
+  class ThreadCounters
+  {
+  public:
+    ThreadCounters() : opened_(false), available_(false)
+    {
+      for (int &fd : fds_)
+        fd = -1;
+    }
+
+    ~ThreadCounters()
+    {
+      close_all();
+    }
+
+    bool available()
+    {
+      if (!opened_)
+        open();
+      return available_;
+    }
+
+    bool read(uint64_t &cycles, uint64_t &instructions, uint64_t &cache_misses)
+    {
+      if (!available())
+        return false;
+      // PERF_FORMAT_GROUP: nr, values[nr]
+      uint64_t buf[1 + 3];
+      if (::read(fds_[0], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) || buf[0] != 3)
+        return false;
+      cycles = buf[1];
+      instructions = buf[2];
+      cache_misses = buf[3];
+      return true;
+    }
+
+  private:
+    void open()
+    {
+      opened_ = true;
+      const uint64_t configs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+      for (int i = 0; i < 3; i++)
+      {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.read_format = PERF_FORMAT_GROUP;
+        // perf_event_paranoid=2でも開けるよう、ユーザー空間のみを数える
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+        if (fd < 0)
+        {
+          close_all();
+          return;
+        }
+        fds_[i] = fd;
+      }
+      available_ = true;
+    }
+
+    void close_all()
+    {
+      for (int &fd : fds_)
+      {
+        if (fd >= 0)
+          close(fd);
+        fd = -1;
+      }
+      available_ = false;
+    }
+
+    int fds_[3];
+    bool opened_;
+    bool available_;
+  };
+
+  thread_local ThreadCounters thread_counters;
+#endif
+
+  void snapshot(PerfReading &reading)
+  {
+    reading.counters = false;
+    reading.cycles = 0;
+    reading.instructions = 0;
+    reading.cache_misses = 0;
+    reading.context_switches = 0;
+#ifdef __linux__
+    reading.counters = thread_counters.read(reading.cycles, reading.instructions, reading.cache_misses);
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0)
+      reading.context_switches = static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+#endif
+    reading.wall_ns = now_ns();
+  }
+}
+
+PerfCounters::PerfCounters() : enabled_(false)
+{
+}
+
+bool PerfCounters::enable(bool enabled)
+{
+  if (enabled)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    totals_.clear();
+  }
+  enabled_.store(enabled);
+#ifdef __linux__
+  return thread_counters.available();
+#else
+  return false;
+#endif
+}
+
+void PerfCounters::add(const char *name, const PerfReading &reading)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  PerfTotals &totals = totals_[name];
+  totals.calls++;
+  totals.wall_ns += reading.wall_ns;
+  totals.context_switches += reading.context_switches;
+  if (reading.counters)
+  {
+    totals.counter_calls++;
+    totals.cycles += reading.cycles;
+    totals.instructions += reading.instructions;
+    totals.cache_misses += reading.cache_misses;
+  }
+}
+
+std::map<std::string, PerfTotals> PerfCounters::totals()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return totals_;
+}
+
+PerfScope::PerfScope(PerfCounters &counters) : counters_(counters), active_(counters.enabled())
+{
+  if (active_)
+    snapshot(start_);
+}
+
+bool PerfScope::finish(const char *name, PerfReading &reading)
+{
+  if (!active_)
+    return false;
+  active_ = false;
+  PerfReading end;
+  snapshot(end);
+  reading.counters = start_.counters && end.counters;
+  reading.wall_ns = end.wall_ns - start_.wall_ns;
+  reading.cycles = reading.counters ? end.cycles - start_.cycles : 0;
+  reading.instructions = reading.counters ? end.instructions - start_.instructions : 0;
+  reading.cache_misses = reading.counters ? end.cache_misses - start_.cache_misses : 0;
+  reading.context_switches = end.context_switches - start_.context_switches;
+  counters_.add(name, reading);
+  return true;
+}
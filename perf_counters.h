@@ -0,0 +1,96 @@
+/**
+ * @file perf_counters.h
+ *
+ * 合成系の呼び出し毎のハードウェアカウンタ(Linuxのperf_event_open)。
+ *
+ * 有効にすると、呼び出し毎にサイクル数・命令数・キャッシュミス・コンテキストスイッチを計測し、
+ * バインディング毎に集計する。カウンタはスレッド毎に初回の計測時に開く。
+ * カーネルが許可しない場合(`perf_event_paranoid`やコンテナの制限など)やLinux以外では、経過時間とコンテキストスイッチ数のみを計測する。
+ */
+#ifndef VOICEVOX_PERF_COUNTERS
+#define VOICEVOX_PERF_COUNTERS
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+struct PerfReading
+{
+  /** サイクル数・命令数・キャッシュミスの値が有効かどうか */
+  bool counters;
+  uint64_t wall_ns;
+  uint64_t cycles;
+  uint64_t instructions;
+  uint64_t cache_misses;
+  uint64_t context_switches;
+};
+
+struct PerfTotals
+{
+  uint64_t calls;
+  /** ハードウェアカウンタを計測できた呼び出しの数 */
+  uint64_t counter_calls;
+  uint64_t wall_ns;
+  uint64_t cycles;
+  uint64_t instructions;
+  uint64_t cache_misses;
+  uint64_t context_switches;
+};
+
+class PerfCounters
+{
+public:
+  PerfCounters();
+
+  /**
+   * 計測を有効・無効にする。有効にした時点の集計は消去する
+   * @return 呼び出したスレッドでハードウェアカウンタが使えるかどうか
+   */
+  bool enable(bool enabled);
+
+  bool enabled() const
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  void add(const char *name, const PerfReading &reading);
+
+  std::map<std::string, PerfTotals> totals();
+
+private:
+  std::atomic<bool> enabled_;
+  std::mutex mutex_;
+  std::map<std::string, PerfTotals> totals_;
+};
+
+/**
+ * 1回の呼び出しを計測する。計測が無効なら何もしない
+ *
+ * @example
+ * ```cpp
+ * PerfScope perf_scope(this->perf);
+ * VoicevoxResultCode resultCode = voicevox_synthesizer_tts_v0_16(...);
+ * PerfReading reading;
+ * if (perf_scope.finish("voicevoxSynthesizerTtsV0_16", reading)) ...
+ * ```
+ */
+class PerfScope
+{
+public:
+  explicit PerfScope(PerfCounters &counters);
+
+  /**
+   * 計測を終えて集計に加える
+   * @return 計測していたかどうか
+   */
+  bool finish(const char *name, PerfReading &reading);
+
+private:
+  PerfCounters &counters_;
+  bool active_;
+  PerfReading start_;
+};
+
+#endif /* VOICEVOX_PERF_COUNTERS */
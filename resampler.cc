@@ -0,0 +1,300 @@
+#include "resampler.h"
+#include "wav.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define RESAMPLER_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RESAMPLER_NEON
+#endif
+
+namespace
+{
+  const double PI = 3.14159265358979323846;
+  // 減衰量がおよそ90dBになる値
+  const double KAISER_BETA = 8.6;
+  // 遷移帯域をナイキスト周波数より下に置くための係数
+  const double ROLLOFF = 0.94;
+  const size_t MAX_CACHED = 16;
+
+  typedef float (*DotFn)(const float *a, const float *b, size_t n);
+
+  float dot_scalar(const float *a, const float *b, size_t n)
+  {
+    float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < n; i += 4)
+    {
+      sum[0] += a[i] * b[i];
+      sum[1] += a[i + 1] * b[i + 1];
+      sum[2] += a[i + 2] * b[i + 2];
+      sum[3] += a[i + 3] * b[i + 3];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+  }
+
+#ifdef RESAMPLER_X86
+#ifndef _MSC_VER
+  __attribute__((target("avx2,fma")))
+#endif
+  float dot_avx2(const float *a, const float *b, size_t n)
+  {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    if (i < n)
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+  }
+
+  bool cpu_has_avx2_fma()
+  {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!fma || !osxsave || (_xgetbv(0) & 6) != 6)
+      return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+  }
+#endif
+
+#ifdef RESAMPLER_NEON
+  float dot_neon(const float *a, const float *b, size_t n)
+  {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (size_t i = 0; i < n; i += 8)
+    {
+      acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+      acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1));
+  }
+#endif
+
+  struct Kernel
+  {
+    DotFn dot;
+    const char *name;
+    Kernel() : dot(dot_scalar), name("scalar")
+    {
+      // 比較用に、環境変数でスカラーの実装に固定できる
+      const char *force_scalar = std::getenv("VOICEVOX_RESAMPLER_SCALAR");
+      if (force_scalar != nullptr && force_scalar[0] != '\0' && force_scalar[0] != '0')
+        return;
+#if defined(RESAMPLER_X86)
+      if (cpu_has_avx2_fma())
+      {
+        dot = dot_avx2;
+        name = "avx2";
+      }
+#elif defined(RESAMPLER_NEON)
+      dot = dot_neon;
+      name = "neon";
+#endif
+    }
+  };
+
+  const Kernel &kernel()
+  {
+    static const Kernel instance;
+    return instance;
+  }
+
+  uint32_t gcd(uint32_t a, uint32_t b)
+  {
+    while (b != 0)
+    {
+      uint32_t t = a % b;
+      a = b;
+      b = t;
+    }
+    return a;
+  }
+
+  /**
+   * 第1種変形ベッセル関数(0次)
+   */
+  double bessel_i0(double x)
+  {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; k++)
+    {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum += term;
+      if (term < sum * 1e-12)
+        break;
+    }
+    return sum;
+  }
+
+  int16_t to_int16(float value)
+  {
+    float rounded = std::nearbyint(value);
+    if (rounded > 32767.0f)
+      return 32767;
+    if (rounded < -32768.0f)
+      return -32768;
+    return static_cast<int16_t>(rounded);
+  }
+}
+
+std::shared_ptr<const Resampler> Resampler::get(uint32_t input_rate, uint32_t output_rate)
+{
+  if (input_rate == 0 || output_rate == 0 || input_rate > RESAMPLER_MAX_RATE || output_rate > RESAMPLER_MAX_RATE)
+    return nullptr;
+  if (output_rate / gcd(input_rate, output_rate) > RESAMPLER_MAX_PHASES)
+    return nullptr;
+  static std::mutex mutex;
+  static std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<const Resampler>> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto key = std::make_pair(input_rate, output_rate);
+  auto it = cache.find(key);
+  if (it != cache.end())
+    return it->second;
+  if (cache.size() >= MAX_CACHED)
+    cache.clear();
+  auto resampler = std::make_shared<const Resampler>(input_rate, output_rate);
+  cache.emplace(key, resampler);
+  return resampler;
+}
+
+const char *Resampler::kernel_name()
+{
+  return kernel().name;
+}
+
+Resampler::Resampler(uint32_t input_rate, uint32_t output_rate)
+{
+  uint32_t divisor = gcd(input_rate, output_rate);
+  up_ = output_rate / divisor;
+  down_ = input_rate / divisor;
+  // 間引く場合は出力のナイキスト周波数に合わせて帯域を狭め、その分フィルタを長くする
+  double scale = up_ < down_ ? static_cast<double>(up_) / down_ : 1.0;
+  double cutoff = scale * ROLLOFF;
+  half_ = static_cast<size_t>(std::ceil(RESAMPLER_ZERO_CROSSINGS / scale));
+  taps_ = (2 * half_ + 7) / 8 * 8;
+  coefficients_.assign(static_cast<size_t>(up_) * taps_, 0.0f);
+  double i0_beta = bessel_i0(KAISER_BETA);
+  for (uint32_t phase = 0; phase < up_; phase++)
+  {
+    float *h = &coefficients_[phase * taps_];
+    double sum = 0.0;
+    for (size_t k = 0; k < 2 * half_; k++)
+    {
+      // 出力位置から見た、k番目の入力の位置(入力のサンプル単位)
+      double d = static_cast<double>(k) - static_cast<double>(half_) + 1.0 - static_cast<double>(phase) / up_;
+      double x = d / static_cast<double>(half_);
+      if (x <= -1.0 || x >= 1.0)
+        continue;
+      double sinc = d == 0.0 ? 1.0 : std::sin(PI * cutoff * d) / (PI * cutoff * d);
+      double value = cutoff * sinc * bessel_i0(KAISER_BETA * std::sqrt(1.0 - x * x)) / i0_beta;
+      h[k] = static_cast<float>(value);
+      sum += value;
+    }
+    // 直流の利得を1にする
+    for (size_t k = 0; k < 2 * half_; k++)
+      h[k] = static_cast<float>(h[k] / sum);
+  }
+}
+
+size_t Resampler::output_frames(size_t input_frames) const
+{
+  return static_cast<size_t>((static_cast<uint64_t>(input_frames) * up_ + down_ - 1) / down_);
+}
+
+void Resampler::process(const int16_t *input, size_t frames, uint16_t channels, int16_t *output) const
+{
+  process_range(input, frames, channels, 0, output_frames(frames), output);
+}
+
+void Resampler::process_range(const int16_t *input, size_t frames, uint16_t channels, size_t first, size_t count, int16_t *output) const
+{
+  if (count == 0)
+    return;
+  DotFn dot = kernel().dot;
+  uint64_t first_position = static_cast<uint64_t>(first) * down_;
+  size_t first_input = static_cast<size_t>(first_position / up_);
+  size_t last_input = static_cast<size_t>(static_cast<uint64_t>(first + count - 1) * down_ / up_);
+  // 範囲外を0で埋めた1チャンネル分の入力。`window[k]`は入力の`first_input + 1 - half_ + k`番目
+  std::vector<float> window(last_input - first_input + taps_, 0.0f);
+  for (uint16_t channel = 0; channel < channels; channel++)
+  {
+    for (size_t k = 0; k < window.size(); k++)
+    {
+      size_t j = first_input + 1 + k;
+      window[k] = j >= half_ && j - half_ < frames ? static_cast<float>(input[(j - half_) * channels + channel]) : 0.0f;
+    }
+    uint64_t position = first_position;
+    for (size_t n = 0; n < count; n++)
+    {
+      size_t i = static_cast<size_t>(position / up_);
+      size_t phase = static_cast<size_t>(position % up_);
+      output[n * channels + channel] = to_int16(dot(&window[i - first_input], &coefficients_[phase * taps_], taps_));
+      position += down_;
+    }
+  }
+}
+
+bool resample_wav(const uint8_t *wav, size_t size, uint32_t output_rate, std::vector<uint8_t> &out, std::string &error)
+{
+  WavFormat format;
+  if (!wav_parse(wav, size, format, error))
+    return false;
+  if (format.format != WAV_FORMAT_PCM || format.bits_per_sample != 16 || format.channels == 0)
+  {
+    error = "16ビットリニアPCMのWAVではありません";
+    return false;
+  }
+  size_t frames = format.data_size / (2 * format.channels);
+  if (format.sample_rate == output_rate)
+  {
+    out.resize(WAV_HEADER_SIZE + frames * 2 * format.channels);
+    wav_write_header(out.data(), WAV_FORMAT_PCM, format.channels, output_rate, 16, static_cast<uint32_t>(out.size() - WAV_HEADER_SIZE));
+    std::memcpy(out.data() + WAV_HEADER_SIZE, wav + format.data_offset, out.size() - WAV_HEADER_SIZE);
+    return true;
+  }
+  std::shared_ptr<const Resampler> resampler = Resampler::get(format.sample_rate, output_rate);
+  if (!resampler)
+  {
+    error = "対応していないサンプリングレートの組です: " + std::to_string(format.sample_rate) + " -> " + std::to_string(output_rate);
+    return false;
+  }
+  // dataチャンクは2バイト境界に揃っているとは限らないため、写してから変換する
+  std::vector<int16_t> samples(frames * format.channels);
+  std::memcpy(samples.data(), wav + format.data_offset, samples.size() * 2);
+  size_t out_frames = resampler->output_frames(frames);
+  size_t data_size = out_frames * 2 * format.channels;
+  out.resize(WAV_HEADER_SIZE + data_size);
+  wav_write_header(out.data(), WAV_FORMAT_PCM, format.channels, output_rate, 16, static_cast<uint32_t>(data_size));
+  std::vector<int16_t> resampled(out_frames * format.channels);
+  resampler->process(samples.data(), frames, format.channels, resampled.data());
+  std::memcpy(out.data() + WAV_HEADER_SIZE, resampled.data(), data_size);
+  return true;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file resampler.h
+ *
+ * 16ビットリニアPCMのサンプリングレート変換(ポリフェーズ、カイザー窓の窓関数法FIR)。
+ *
+ * 変換比を既約分数 up/down にし、出力1サンプルごとにup個の位相のうち一つの係数列と入力の積和をとる。
+ * 係数列の長さは8の倍数に揃え、積和はAVX2+FMA(x86-64、実行時に判定)・NEON(AArch64)・スカラーのいずれかで行う。
+ * 係数はレートの組ごとに一度だけ計算し、使い回す。
+ *
+ * ワーカースレッドから呼んでよい。
+ */
+#ifndef VOICEVOX_RESAMPLER
+#define VOICEVOX_RESAMPLER
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 扱えるサンプリングレートの上限
+#define RESAMPLER_MAX_RATE 384000
+// 位相の数(変換比の分子)の上限。これを超える組(互いに素に近いレート同士)は扱わない
+#define RESAMPLER_MAX_PHASES 1024
+// 通過域の片側にとる零点の数。多いほど遷移帯域が狭くなる
+#define RESAMPLER_ZERO_CROSSINGS 16
+
+class Resampler
+{
+public:
+  /**
+   * レートの組に対応する変換器を返す(係数は組ごとに一度だけ計算する)
+   * @return 扱えない組の場合は`nullptr`
+   */
+  static std::shared_ptr<const Resampler> get(uint32_t input_rate, uint32_t output_rate);
+
+  /**
+   * 使われる積和の実装の名前(`avx2`, `neon`, `scalar`)
+   */
+  static const char *kernel_name();
+
+  Resampler(uint32_t input_rate, uint32_t output_rate);
+
+  size_t output_frames(size_t input_frames) const;
+
+  /**
+   * @param input チャンネルごとにインターリーブされた`frames`フレーム
+   * @param output `output_frames(frames) * channels`サンプル分の領域
+   */
+  void process(const int16_t *input, size_t frames, uint16_t channels, int16_t *output) const;
+
+  /**
+   * 出力の`first`番目から`count`フレームだけを作る。長い入力を少しずつ変換する場合に使う
+   * @param input 入力全体(`frames`フレーム)
+   * @param output `count * channels`サンプル分の領域
+   */
+  void process_range(const int16_t *input, size_t frames, uint16_t channels, size_t first, size_t count, int16_t *output) const;
+
+private:
+  uint32_t up_;
+  uint32_t down_;
+  /** 出力位置の片側にとる入力のサンプル数 */
+  size_t half_;
+  /** 1位相あたりの係数の数(8の倍数) */
+  size_t taps_;
+  /** 位相ごとに`taps_`個ずつ並べた係数 */
+  std::vector<float> coefficients_;
+};
+
+/**
+ * 16ビットリニアPCMのWAVを`output_rate`に変換したWAVを作る。既に`output_rate`ならそのまま写す
+ * @return 失敗した場合は`false`を返し、`error`に理由を設定する
+ */
+bool resample_wav(const uint8_t *wav, size_t size, uint32_t output_rate, std::vector<uint8_t> &out, std::string &error);
+
+#endif /* VOICEVOX_RESAMPLER */
@@ -0,0 +1,93 @@
+/**
+ * @file spsc_ring.h
+ *
+ * 書き込み側と読み出し側がそれぞれ1スレッドだけのリングバッファ(ロックなし)。
+ *
+ * 容量は2のべき乗に切り上げる。位置は読み書きしたバイト数の累計で持ち、容量で割った余りを添字にする。
+ * 書き込み側は`head_`だけを、読み出し側は`tail_`だけを進め、相手の位置はacquireで読む。
+ * 空き・データを待つ処理は持たないため、呼び出し側で行うこと。
+ */
+#ifndef VOICEVOX_SPSC_RING
+#define VOICEVOX_SPSC_RING
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class SpscRing
+{
+public:
+  explicit SpscRing(size_t capacity) : head_(0), tail_(0)
+  {
+    size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+    buffer_.resize(size);
+    mask_ = size - 1;
+  }
+
+  size_t capacity() const
+  {
+    return buffer_.size();
+  }
+
+  /**
+   * 読み出せるバイト数(読み出し側から呼ぶ)
+   */
+  size_t readable() const
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * 書き込めるバイト数(書き込み側から呼ぶ)
+   */
+  size_t writable() const
+  {
+    return buffer_.size() - (head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_acquire));
+  }
+
+  /**
+   * 書き込み側から呼ぶ
+   * @return 書き込んだバイト数(空きが足りなければ`size`より少ない)
+   */
+  size_t write(const uint8_t *data, size_t size)
+  {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size = std::min(size, buffer_.size() - (head - tail_.load(std::memory_order_acquire)));
+    size_t offset = head & mask_;
+    size_t first = std::min(size, buffer_.size() - offset);
+    std::memcpy(&buffer_[offset], data, first);
+    std::memcpy(&buffer_[0], data + first, size - first);
+    head_.store(head + size, std::memory_order_release);
+    return size;
+  }
+
+  /**
+   * 読み出し側から呼ぶ
+   * @return 読み出したバイト数
+   */
+  size_t read(uint8_t *out, size_t size)
+  {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size = std::min(size, head_.load(std::memory_order_acquire) - tail);
+    size_t offset = tail & mask_;
+    size_t first = std::min(size, buffer_.size() - offset);
+    std::memcpy(out, &buffer_[offset], first);
+    std::memcpy(out + first, &buffer_[0], size - first);
+    tail_.store(tail + size, std::memory_order_release);
+    return size;
+  }
+
+private:
+  std::vector<uint8_t> buffer_;
+  size_t mask_;
+  // 書き込み側と読み出し側で別のキャッシュラインに置く
+  alignas(64) std::atomic<size_t> head_;
+  alignas(64) std::atomic<size_t> tail_;
+};
+
+#endif /* VOICEVOX_SPSC_RING */
@@ -0,0 +1,204 @@
+#include "user_dict_index.h"
+#include "json_reader.h"
+
+namespace
+{
+  const char *WORD_TYPES[] = {"PROPER_NOUN", "COMMON_NOUN", "VERB", "ADJECTIVE", "SUFFIX"};
+
+  bool uuid_from_string(const std::string &str, std::string &uuid)
+  {
+    uuid.clear();
+    int high = -1;
+    for (char c : str)
+    {
+      int value;
+      if (c >= '0' && c <= '9')
+        value = c - '0';
+      else if (c >= 'a' && c <= 'f')
+        value = c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        value = c - 'A' + 10;
+      else if (c == '-')
+        continue;
+      else
+        return false;
+      if (high < 0)
+      {
+        high = value;
+        continue;
+      }
+      uuid += static_cast<char>((high << 4) | value);
+      high = -1;
+    }
+    return uuid.size() == 16 && high < 0;
+  }
+
+  bool read_word(JsonReader &reader, UserDictIndexWord &word)
+  {
+    if (!reader.consume('{'))
+      return false;
+    if (reader.consume('}'))
+      return true;
+    do
+    {
+      std::string field;
+      if (!reader.read_string(field) || !reader.consume(':'))
+        return false;
+      bool ok;
+      if (field == "surface")
+        ok = reader.read_string(word.surface);
+      else if (field == "pronunciation")
+        ok = reader.read_string(word.pronunciation);
+      else if (field == "accent_type")
+        ok = reader.read_uint32(word.accent_type);
+      else if (field == "priority")
+        ok = reader.read_uint32(word.priority);
+      else if (field == "word_type")
+      {
+        std::string word_type;
+        ok = reader.read_string(word_type);
+        for (uint32_t i = 0; i < sizeof(WORD_TYPES) / sizeof(WORD_TYPES[0]); i++)
+        {
+          if (word_type == WORD_TYPES[i])
+            word.word_type = i;
+        }
+      }
+      else
+        ok = reader.skip_value();
+      if (!ok)
+        return false;
+    } while (reader.consume(','));
+    return reader.consume('}');
+  }
+}
+
+std::string UserDictIndex::normalize_surface(const std::string &surface)
+{
+  std::string normalized;
+  normalized.reserve(surface.size());
+  for (char c : surface)
+  {
+    if (c == ' ')
+      append_utf8(normalized, 0x3000);
+    else if (c >= 0x21 && c <= 0x7e)
+      append_utf8(normalized, static_cast<uint32_t>(c) + 0xfee0);
+    else
+      normalized += c;
+  }
+  return normalized;
+}
+
+void UserDictIndex::put(const uint8_t (&uuid)[16], const std::string &surface, const std::string &pronunciation, uint32_t accent_type, uint32_t word_type, uint32_t priority)
+{
+  put_word(UserDictIndexWord{std::string(reinterpret_cast<const char *>(uuid), 16), normalize_surface(surface), pronunciation, accent_type, word_type, priority});
+}
+
+void UserDictIndex::put_word(UserDictIndexWord word)
+{
+  generation_++;
+  auto it = words_.find(word.uuid);
+  if (it != words_.end())
+  {
+    remove_surface(it->second.surface, word.uuid);
+    words_.erase(it);
+  }
+  surfaces_.emplace(word.surface, word.uuid);
+  std::string uuid = word.uuid;
+  words_.emplace(std::move(uuid), std::move(word));
+}
+
+void UserDictIndex::remove(const uint8_t (&uuid)[16])
+{
+  auto it = words_.find(std::string(reinterpret_cast<const char *>(uuid), 16));
+  if (it == words_.end())
+    return;
+  generation_++;
+  remove_surface(it->second.surface, it->first);
+  words_.erase(it);
+}
+
+void UserDictIndex::remove_surface(const std::string &surface, const std::string &uuid)
+{
+  auto range = surfaces_.equal_range(surface);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == uuid)
+    {
+      surfaces_.erase(it);
+      return;
+    }
+  }
+}
+
+void UserDictIndex::merge(const UserDictIndex &other)
+{
+  for (const auto &entry : other.words_)
+    put_word(entry.second);
+}
+
+bool UserDictIndex::rebuild(const char *json)
+{
+  generation_++;
+  words_.clear();
+  surfaces_.clear();
+  JsonReader reader(json);
+  if (!reader.consume('{'))
+    return false;
+  if (!reader.peek('}'))
+  {
+    do
+    {
+      std::string key;
+      UserDictIndexWord word{"", "", "", 0, 0, 0};
+      if (!reader.read_string(key) || !uuid_from_string(key, word.uuid) || !reader.consume(':') || !read_word(reader, word))
+      {
+        words_.clear();
+        surfaces_.clear();
+        return false;
+      }
+      put_word(std::move(word));
+    } while (reader.consume(','));
+  }
+  if (!reader.consume('}') || !reader.at_end())
+  {
+    words_.clear();
+    surfaces_.clear();
+    return false;
+  }
+  return true;
+}
+
+void UserDictIndex::replace(UserDictIndex &&other)
+{
+  generation_++;
+  words_ = std::move(other.words_);
+  surfaces_ = std::move(other.surfaces_);
+}
+
+const UserDictIndexWord *UserDictIndex::find_uuid(const uint8_t (&uuid)[16]) const
+{
+  auto it = words_.find(std::string(reinterpret_cast<const char *>(uuid), 16));
+  return it == words_.end() ? nullptr : &it->second;
+}
+
+std::vector<const UserDictIndexWord *> UserDictIndex::find_surface(const std::string &surface) const
+{
+  std::vector<const UserDictIndexWord *> result;
+  auto range = surfaces_.equal_range(normalize_surface(surface));
+  for (auto it = range.first; it != range.second; ++it)
+    result.push_back(&words_.at(it->second));
+  return result;
+}
+
+std::vector<const UserDictIndexWord *> UserDictIndex::find_prefix(const std::string &prefix, size_t limit) const
+{
+  std::vector<const UserDictIndexWord *> result;
+  std::string normalized = normalize_surface(prefix);
+  for (auto it = surfaces_.lower_bound(normalized); it != surfaces_.end() && result.size() < limit; ++it)
+  {
+    if (it->first.compare(0, normalized.size(), normalized) != 0)
+      break;
+    result.push_back(&words_.at(it->second));
+  }
+  return result;
+}
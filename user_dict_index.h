@@ -0,0 +1,111 @@
+/**
+ * @file user_dict_index.h
+ *
+ * ユーザー辞書の単語の索引(表記・UUIDから引く)。
+ *
+ * voicevox_coreのユーザー辞書は単語を取り出す手段がJSONへの書き出ししか無いため、
+ * 追加・更新・削除の度にこちらにも同じ内容を反映し、検索のたびに辞書全体を書き出さずに済むようにする。
+ * 表記はvoicevox_coreと同じく、ASCIIの記号・英数字と空白を全角に変換して保持する。
+ *
+ * メインスレッドからのみ触ること。
+ */
+#ifndef VOICEVOX_USER_DICT_INDEX
+#define VOICEVOX_USER_DICT_INDEX
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct UserDictIndexWord
+{
+  /** UUID(16バイト) */
+  std::string uuid;
+  std::string surface;
+  std::string pronunciation;
+  uint32_t accent_type;
+  uint32_t word_type;
+  uint32_t priority;
+};
+
+class UserDictIndex
+{
+public:
+  /**
+   * voicevox_coreと同じ規則で表記を正規化する(U+0021〜U+007EをU+FF01〜U+FF5Eへ、空白をU+3000へ)
+   */
+  static std::string normalize_surface(const std::string &surface);
+
+  /**
+   * 単語を追加する。同じUUIDの単語があれば置き換える
+   * @param surface 正規化前の表記
+   */
+  void put(const uint8_t (&uuid)[16], const std::string &surface, const std::string &pronunciation, uint32_t accent_type, uint32_t word_type, uint32_t priority);
+
+  void remove(const uint8_t (&uuid)[16]);
+
+  /**
+   * 他の索引の単語を全て取り込む(`voicevox_user_dict_import`と同じく、同じUUIDは上書き)
+   */
+  void merge(const UserDictIndex &other);
+
+  /**
+   * `voicevox_user_dict_to_json`の出力から作り直す
+   * @return JSONを解釈できたかどうか。失敗した場合は空になる
+   */
+  bool rebuild(const char *json);
+
+  /**
+   * 別の場所(ワーカースレッドなど)で作った索引で置き換える
+   */
+  void replace(UserDictIndex &&other);
+
+  const UserDictIndexWord *find_uuid(const uint8_t (&uuid)[16]) const;
+
+  /**
+   * 表記が一致する単語を探す
+   * @param surface 正規化前の表記
+   */
+  std::vector<const UserDictIndexWord *> find_surface(const std::string &surface) const;
+
+  /**
+   * 表記が前方一致する単語を、表記の昇順に最大`limit`件探す
+   * @param prefix 正規化前の表記
+   */
+  std::vector<const UserDictIndexWord *> find_prefix(const std::string &prefix, size_t limit) const;
+
+  size_t size() const
+  {
+    return words_.size();
+  }
+
+  /**
+   * 変更の度に増える値。非同期ジョブの間に変更されたかどうかを確かめるのに使う
+   */
+  uint64_t generation() const
+  {
+    return generation_;
+  }
+
+  /**
+   * 全ての単語を表記の順に辿る
+   */
+  template <class F>
+  void for_each(F f) const
+  {
+    for (const auto &surface : surfaces_)
+      f(words_.at(surface.second));
+  }
+
+private:
+  void put_word(UserDictIndexWord word);
+  void remove_surface(const std::string &surface, const std::string &uuid);
+
+  uint64_t generation_ = 0;
+  std::unordered_map<std::string, UserDictIndexWord> words_;
+  /** 正規化した表記 -> UUID。UTF-8のバイト順で並ぶため、前方一致する範囲は連続する */
+  std::multimap<std::string, std::string> surfaces_;
+};
+
+#endif /* VOICEVOX_USER_DICT_INDEX */
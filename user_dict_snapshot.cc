@@ -0,0 +1,239 @@
+#include "user_dict_snapshot.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  const char MAGIC[8] = {'V', 'V', 'U', 'D', 'S', 'N', 'A', 'P'};
+  const size_t HEADER_SIZE = 32;
+  /** 1単語あたりの固定長の列のバイト数(UUIDと5つのu32) */
+  const size_t FIXED_WORD_SIZE = 16 + 4 * 5;
+
+  struct Crc32Table
+  {
+    uint32_t values[256];
+    Crc32Table()
+    {
+      for (uint32_t i = 0; i < 256; i++)
+      {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+          c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        values[i] = c;
+      }
+    }
+  };
+
+  uint32_t crc32(const uint8_t *data, size_t size)
+  {
+    static const Crc32Table table;
+    uint32_t c = 0xffffffffu;
+    for (size_t i = 0; i < size; i++)
+      c = table.values[(c ^ data[i]) & 0xff] ^ (c >> 8);
+    return c ^ 0xffffffffu;
+  }
+
+  uint32_t get_u32(const uint8_t *p)
+  {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  void set_u32(char *p, uint32_t value)
+  {
+    for (int i = 0; i < 4; i++)
+      p[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+std::string user_dict_snapshot_build(const UserDictIndex &index)
+{
+  uint32_t word_count = static_cast<uint32_t>(index.size());
+  size_t surfaces_size = 0;
+  size_t pronunciations_size = 0;
+  index.for_each([&](const UserDictIndexWord &word)
+                 {
+                   surfaces_size += word.surface.size() + 1;
+                   pronunciations_size += word.pronunciation.size() + 1; });
+  size_t fixed_size = HEADER_SIZE + FIXED_WORD_SIZE * word_count;
+  std::string out(fixed_size + surfaces_size + pronunciations_size, '\0');
+  char *base = &out[0];
+  std::memcpy(base, MAGIC, sizeof(MAGIC));
+  set_u32(base + 8, USER_DICT_SNAPSHOT_VERSION);
+  set_u32(base + 12, word_count);
+  set_u32(base + 16, static_cast<uint32_t>(surfaces_size));
+  set_u32(base + 20, static_cast<uint32_t>(pronunciations_size));
+
+  char *uuids = base + HEADER_SIZE;
+  char *accent_types = uuids + 16 * word_count;
+  char *priorities = accent_types + 4 * word_count;
+  char *word_types = priorities + 4 * word_count;
+  char *surface_offsets = word_types + 4 * word_count;
+  char *pronunciation_offsets = surface_offsets + 4 * word_count;
+  char *surfaces = base + fixed_size;
+  char *pronunciations = surfaces + surfaces_size;
+  uint32_t i = 0;
+  uint32_t surface_offset = 0;
+  uint32_t pronunciation_offset = 0;
+  index.for_each([&](const UserDictIndexWord &word)
+                 {
+                   std::memcpy(uuids + 16 * i, word.uuid.data(), 16);
+                   set_u32(accent_types + 4 * i, word.accent_type);
+                   set_u32(priorities + 4 * i, word.priority);
+                   set_u32(word_types + 4 * i, word.word_type);
+                   set_u32(surface_offsets + 4 * i, surface_offset);
+                   set_u32(pronunciation_offsets + 4 * i, pronunciation_offset);
+                   // 終端のNULは確保時に埋めてある
+                   std::memcpy(surfaces + surface_offset, word.surface.data(), word.surface.size());
+                   std::memcpy(pronunciations + pronunciation_offset, word.pronunciation.data(), word.pronunciation.size());
+                   surface_offset += static_cast<uint32_t>(word.surface.size() + 1);
+                   pronunciation_offset += static_cast<uint32_t>(word.pronunciation.size() + 1);
+                   i++; });
+  set_u32(base + 24, crc32(reinterpret_cast<const uint8_t *>(base + HEADER_SIZE), out.size() - HEADER_SIZE));
+  return out;
+}
+
+UserDictSnapshotReader::UserDictSnapshotReader()
+    : data_(nullptr), size_(0), word_count_(0), uuids_(nullptr), accent_types_(nullptr), priorities_(nullptr), word_types_(nullptr),
+      surface_offsets_(nullptr), pronunciation_offsets_(nullptr), surfaces_(nullptr), pronunciations_(nullptr)
+{
+}
+
+UserDictSnapshotReader::~UserDictSnapshotReader()
+{
+  close();
+}
+
+void UserDictSnapshotReader::close()
+{
+#ifdef _WIN32
+  buffer_.clear();
+#else
+  if (data_ != nullptr && size_ > 0)
+    munmap(const_cast<uint8_t *>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  word_count_ = 0;
+}
+
+bool UserDictSnapshotReader::open(const std::string &path, std::string &error)
+{
+  close();
+#ifdef _WIN32
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr)
+  {
+    error = "ファイルを開けませんでした: " + path;
+    return false;
+  }
+  char chunk[65536];
+  size_t read;
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    buffer_.append(chunk, read);
+  fclose(file);
+  data_ = reinterpret_cast<const uint8_t *>(buffer_.data());
+  size_ = buffer_.size();
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    error = "ファイルを開けませんでした: " + path;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    error = "ファイルを開けませんでした: " + path;
+    return false;
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ >= HEADER_SIZE)
+  {
+    void *mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+      ::close(fd);
+      size_ = 0;
+      error = "ファイルをmmapできませんでした: " + path;
+      return false;
+    }
+    // 先頭から順に読むため、先読みを促す
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t *>(mapped);
+  }
+  ::close(fd);
+#endif
+  if (!validate(error))
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool UserDictSnapshotReader::validate(std::string &error)
+{
+  if (size_ < HEADER_SIZE || std::memcmp(data_, MAGIC, sizeof(MAGIC)) != 0)
+  {
+    error = "ユーザー辞書のスナップショットではありません";
+    return false;
+  }
+  if (get_u32(data_ + 8) != USER_DICT_SNAPSHOT_VERSION)
+  {
+    error = "対応していないバージョンのスナップショットです";
+    return false;
+  }
+  uint32_t word_count = get_u32(data_ + 12);
+  uint64_t surfaces_size = get_u32(data_ + 16);
+  uint64_t pronunciations_size = get_u32(data_ + 20);
+  uint64_t fixed_size = HEADER_SIZE + static_cast<uint64_t>(FIXED_WORD_SIZE) * word_count;
+  if (fixed_size + surfaces_size + pronunciations_size != size_)
+  {
+    error = "スナップショットの大きさが正しくありません";
+    return false;
+  }
+  if (crc32(data_ + HEADER_SIZE, size_ - HEADER_SIZE) != get_u32(data_ + 24))
+  {
+    error = "スナップショットのチェックサムが一致しません";
+    return false;
+  }
+  const uint8_t *p = data_ + HEADER_SIZE;
+  uuids_ = reinterpret_cast<const uint8_t(*)[16]>(p);
+  p += 16 * static_cast<size_t>(word_count);
+  accent_types_ = reinterpret_cast<const uint32_t *>(p);
+  p += 4 * static_cast<size_t>(word_count);
+  priorities_ = reinterpret_cast<const uint32_t *>(p);
+  p += 4 * static_cast<size_t>(word_count);
+  word_types_ = reinterpret_cast<const uint32_t *>(p);
+  p += 4 * static_cast<size_t>(word_count);
+  surface_offsets_ = reinterpret_cast<const uint32_t *>(p);
+  p += 4 * static_cast<size_t>(word_count);
+  pronunciation_offsets_ = reinterpret_cast<const uint32_t *>(p);
+  p += 4 * static_cast<size_t>(word_count);
+  surfaces_ = reinterpret_cast<const char *>(p);
+  pronunciations_ = surfaces_ + surfaces_size;
+  // 文字列の領域がNULで終わり、位置がすべて領域内にあれば、各文字列は領域内で終端する
+  if ((surfaces_size > 0 && surfaces_[surfaces_size - 1] != '\0') || (pronunciations_size > 0 && pronunciations_[pronunciations_size - 1] != '\0'))
+  {
+    error = "スナップショットの文字列が終端していません";
+    return false;
+  }
+  for (uint32_t i = 0; i < word_count; i++)
+  {
+    if (surface_offsets_[i] >= surfaces_size || pronunciation_offsets_[i] >= pronunciations_size)
+    {
+      error = "スナップショットの文字列の位置が正しくありません";
+      return false;
+    }
+  }
+  word_count_ = word_count;
+  return true;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file user_dict_snapshot.h
+ *
+ * ユーザー辞書のバイナリスナップショット。
+ *
+ * 列ごとに並べた固定長の配列と、NUL終端の文字列を連結した領域からなり、mmapしたまま読める(コピーや解析が要らない)。
+ * 数値はすべてリトルエンディアンで、リトルエンディアンの環境でのみ読み書きできる。
+ *
+ * ヘッダ(32バイト)
+ * - magic `VVUDSNAP` (8バイト)
+ * - version u32 (= ::USER_DICT_SNAPSHOT_VERSION)
+ * - word_count u32 (N)
+ * - surfaces_size u32 (表記の領域のバイト数)
+ * - pronunciations_size u32 (読みの領域のバイト数)
+ * - checksum u32 (ヘッダより後ろ全体のCRC-32)
+ * - reserved u32
+ *
+ * 本体(ヘッダの直後から順に、すべて4バイト境界に揃う)
+ * - uuids u8[N][16]
+ * - accent_types u32[N]
+ * - priorities u32[N]
+ * - word_types u32[N]
+ * - surface_offsets u32[N] (表記の領域内での位置)
+ * - pronunciation_offsets u32[N]
+ * - surfaces (NUL終端の文字列の連結、正規化済みの表記)
+ * - pronunciations (NUL終端の文字列の連結)
+ */
+#ifndef VOICEVOX_USER_DICT_SNAPSHOT
+#define VOICEVOX_USER_DICT_SNAPSHOT
+
+#include "user_dict_index.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define USER_DICT_SNAPSHOT_VERSION 1
+
+/**
+ * 索引の内容からスナップショットのバイト列を作る
+ */
+std::string user_dict_snapshot_build(const UserDictIndex &index);
+
+/**
+ * スナップショットのファイルを読み取り専用でmmapし、検証した上で各列を参照させる
+ */
+class UserDictSnapshotReader
+{
+public:
+  UserDictSnapshotReader();
+  ~UserDictSnapshotReader();
+  UserDictSnapshotReader(const UserDictSnapshotReader &) = delete;
+  UserDictSnapshotReader &operator=(const UserDictSnapshotReader &) = delete;
+
+  /**
+   * @return 開けなかった・形式が違う・チェックサムが合わない場合は`false`を返し、`error`に理由を設定する
+   */
+  bool open(const std::string &path, std::string &error);
+
+  uint32_t size() const
+  {
+    return word_count_;
+  }
+
+  const uint8_t (&uuid(uint32_t i) const)[16]
+  {
+    return uuids_[i];
+  }
+
+  uint32_t accent_type(uint32_t i) const
+  {
+    return accent_types_[i];
+  }
+
+  uint32_t priority(uint32_t i) const
+  {
+    return priorities_[i];
+  }
+
+  uint32_t word_type(uint32_t i) const
+  {
+    return word_types_[i];
+  }
+
+  const char *surface(uint32_t i) const
+  {
+    return surfaces_ + surface_offsets_[i];
+  }
+
+  const char *pronunciation(uint32_t i) const
+  {
+    return pronunciations_ + pronunciation_offsets_[i];
+  }
+
+private:
+  bool validate(std::string &error);
+  void close();
+
+  const uint8_t *data_;
+  size_t size_;
+#ifdef _WIN32
+  std::string buffer_;
+#endif
+  uint32_t word_count_;
+  const uint8_t (*uuids_)[16];
+  const uint32_t *accent_types_;
+  const uint32_t *priorities_;
+  const uint32_t *word_types_;
+  const uint32_t *surface_offsets_;
+  const uint32_t *pronunciation_offsets_;
+  const char *surfaces_;
+  const char *pronunciations_;
+};
+
+#endif /* VOICEVOX_USER_DICT_SNAPSHOT */
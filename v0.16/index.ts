@@ -1,5 +1,8 @@
+import { Readable } from "stream";
 import { VoicevoxCore, VoicevoxResultCodeV0_16, VoicevoxAccelerationMode, VoicevoxUserDictWordType } from "../voicevox_core";
 import {
+  checkValidArray,
+  checkValidBoolean,
   checkValidNumber,
   checkValidObject,
   checkValidOption,
@@ -19,6 +22,28 @@ import {
 
 const Pointer = Symbol("Pointer");
 const Deleted = Symbol("Deleted");
+const AudioQueryCounter = Symbol("AudioQueryCounter");
+const PcmStreamCounter = Symbol("PcmStreamCounter");
+
+/**
+ * `VoicevoxTtsOptions`などの`outputFormat`から、バインディングに渡す値への対応
+ */
+const OutputFormat: { [key in VoicevoxOutputFormat]: number } = {
+  wav: 0,
+  mulaw: 1,
+  alaw: 2,
+  pcm: 3,
+  "wav-stream": 4,
+};
+
+/**
+ * `voicevoxSynthesizerAudioQueryReplaceV0_16`の`kind`
+ */
+const AudioQueryReplaceKind = {
+  MORA_DATA: 0,
+  PHONEME_LENGTH: 1,
+  MORA_PITCH: 2,
+} as const;
 
 /**
  * voicevox_coreを利用してVOICEVOXを使う
@@ -30,6 +55,8 @@ export class Voicevox {
   #voiceModelCounter: number = 0;
   #synthesizerPointer: number = 0;
   #userDictCounter: number = 0;
+  [AudioQueryCounter]: number = 0;
+  [PcmStreamCounter]: number = 0;
   /**
    * @param path libvoicevox_core.so, libvoicevox_core.solib, voicevox_core.dllを指すパス
    * @param otherDll その他利用にあたって必要なdllファイル(onnxruntimeなど)があるディレクトリ(フォルダ)へのパス(Windowsのみ)
@@ -52,9 +79,13 @@ export class Voicevox {
       checkValidString(openJtalkDicDir, "openJtalkDicDir");
       const openJtalkPointerName = this.#openJtalkPointerCounter;
       this.#openJtalkPointerCounter++;
-      const { resultCode } = this[Core].voicevoxOpenJtalkRcNewV0_16(openJtalkDicDir, openJtalkPointerName);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve(new VoicevoxOpenJtalkRc(this, openJtalkPointerName));
+      // 辞書の読み込みはスレッドプールで行う
+      resolve(
+        this[Core].voicevoxOpenJtalkRcNewAsyncV0_16(openJtalkDicDir, openJtalkPointerName).then(({ resultCode }) => {
+          if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+          return new VoicevoxOpenJtalkRc(this, openJtalkPointerName);
+        })
+      );
     });
   }
 
@@ -102,6 +133,34 @@ export class Voicevox {
     });
   }
 
+  /**
+   * テナントごとのユーザー辞書で合成する`VoicevoxTenantPool`を構築(_construct_)する。
+   * シンセサイザは最大`capacity`個まで必要になった時点で作り、最近使われていないものから別のテナントに使い回す。
+   * 解放は`VoicevoxTenantPool#delete`で行う。
+   *
+   * シンセサイザを作るたびに`models`を読み込むため、`models`は`VoicevoxTenantPool#delete`を呼ぶまで破棄しないこと
+   * (破棄した後にシンセサイザを作ろうとすると、その呼び出しは例外を発生する)。
+   * @param {string} openJtalkDicDir 辞書ディレクトリを指すパス
+   * @param {Array<VoicevoxVoiceModel>} models 各シンセサイザに読み込む音声モデル。プールを破棄するまで開いておくこと
+   * @param {VoicevoxInitializeOptions} options シンセサイザのオプション
+   * @param {number} capacity シンセサイザの最大数
+   * @returns {Promise<VoicevoxTenantPool>}
+   */
+  tenantPoolNew(openJtalkDicDir: string, models: Array<VoicevoxVoiceModel>, options: VoicevoxInitializeOptions, capacity: number): Promise<VoicevoxTenantPool> {
+    return new Promise<VoicevoxTenantPool>((resolve) => {
+      checkValidString(openJtalkDicDir, "openJtalkDicDir");
+      if (!(models instanceof Array)) throw new VoicevoxJsError("有効なmodelsではありません(Arrayでない)");
+      for (const model of models) {
+        checkValidObject(model, "models", VoicevoxVoiceModel, "VoicevoxVoiceModel");
+        if (model.deleted) throw new VoicevoxJsError("modelsに破棄されたVoicevoxVoiceModelが含まれています");
+      }
+      checkVoicevoxInitializeOptions(options);
+      checkValidNumber(capacity, "capacity", true);
+      if (capacity < 1) throw new VoicevoxJsError("capacityは1以上にしてください");
+      resolve(new VoicevoxTenantPool(this, openJtalkDicDir, models.slice(), options, capacity));
+    });
+  }
+
   /**
    * このライブラリで利用可能なデバイスの情報を、JSONで取得する。
    * あくまで本ライブラリが対応しているデバイスの情報であることに注意。GPUが使える環境ではなかったとしても`cuda`や`dml`は`true`を示しうる。
@@ -115,6 +174,21 @@ export class Voicevox {
     });
   }
 
+  /**
+   * AudioQueryのJSONから、ネイティブ側で保持する`VoicevoxAudioQuery`を構築(_construct_)する。
+   * 解放は`VoicevoxAudioQuery#delete`で行う。
+   * @param {VoicevoxAudioQueryJson} audioQueryJson AudioQuery
+   * @returns {Promise<VoicevoxAudioQuery>}
+   */
+  audioQueryNew(audioQueryJson: VoicevoxAudioQueryJson): Promise<VoicevoxAudioQuery> {
+    return new Promise<VoicevoxAudioQuery>((resolve) => {
+      checkVoicevoxAudioQueryJson(audioQueryJson);
+      const audioQueryPointerName = this[AudioQueryCounter]++;
+      this[Core].voicevoxAudioQueryNewV0_16(JSON.stringify(audioQueryJson), audioQueryPointerName);
+      resolve(new VoicevoxAudioQuery(this, audioQueryPointerName));
+    });
+  }
+
   /**
    * ユーザー辞書を構築(_construct_)する。
    * @returns {Promise<VoicevoxUserDict>}
@@ -127,6 +201,158 @@ export class Voicevox {
     });
   }
 
+  /**
+   * 合成系の呼び出し(`VoicevoxSynthesizer#tts`など)の記録を開始する。性能調査用。
+   * 記録は別スレッドで書き込まれ、書き込み待ちが`maxQueueBytes`を超えた分は捨てられる。
+   * 引数・オプション(出力形式・ラウドネス・後処理など)と、どのメソッドで呼ばれたかを記録する。記録を開始する前に呼び出したものは記録しない。
+   * 記録したファイルは`bench/replay.js`で再生できる。
+   * @param {string} path 書き込むファイル。既にある場合は上書きする
+   * @param {number} maxQueueBytes 書き込み待ちにできる最大のバイト数
+   * @returns {Promise<void>}
+   */
+  captureStart(path: string, maxQueueBytes: number = 64 * 1024 * 1024): Promise<void> {
+    return new Promise<void>((resolve) => {
+      checkValidString(path, "path");
+      checkValidNumber(maxQueueBytes, "maxQueueBytes", true);
+      this[Core].captureStart(path, maxQueueBytes);
+      resolve();
+    });
+  }
+
+  /**
+   * 呼び出しの記録を停止する。書き込み待ちの記録は全て書き込んでから戻る。
+   * @returns {Promise<VoicevoxCaptureStats>}
+   */
+  captureStop(): Promise<VoicevoxCaptureStats> {
+    return new Promise<VoicevoxCaptureStats>((resolve) => {
+      const { result } = this[Core].captureStop();
+      resolve(result);
+    });
+  }
+
+  /**
+   * 合成系の呼び出しの計測を有効・無効にする。有効にした時点で集計は消去される。
+   * Linuxではperf_event_openでサイクル数・命令数・キャッシュミスも計測する。使えない場合は経過時間とコンテキストスイッチ数のみとなる。
+   * @param {boolean} enabled 有効にするかどうか
+   * @returns {Promise<boolean>} ハードウェアカウンタが使えるかどうか
+   */
+  perfCountersEnable(enabled: boolean): Promise<boolean> {
+    return new Promise<boolean>((resolve) => {
+      checkValidBoolean(enabled, "enabled");
+      const { result } = this[Core].perfCountersEnable(enabled);
+      resolve(result);
+    });
+  }
+
+  /**
+   * テキスト解析の結果を保持する件数を設定する。既定は1024件で、0にすると保持しない。
+   * `VoicevoxSynthesizer#createAudioQuery`・`createAccentPhrases`は、同じテキストを別のスタイルで呼び出したときにテキスト解析を省き、音高・長さだけをそのスタイルで作り直す。
+   * ユーザー辞書を設定し直したOpenJtalkRcの解析結果は使われない。
+   * @param {number} capacity 保持する件数
+   * @returns {Promise<void>}
+   */
+  accentPhraseCacheSetCapacity(capacity: number): Promise<void> {
+    return new Promise<void>((resolve) => {
+      checkValidNumber(capacity, "capacity", true);
+      if (capacity < 0) throw new VoicevoxJsError("capacityは0以上にしてください");
+      this[Core].accentPhraseCacheSetCapacity(capacity);
+      resolve();
+    });
+  }
+
+  /**
+   * テキストとAquesTalk風記法の対応を記録する件数を設定する。既定は0(記録しない)。
+   * 有効にすると`VoicevoxSynthesizer#createAudioQuery`の結果の`kana`を記録し、以降の同じテキストの`tts`はテキスト解析を省いてAquesTalk風記法から合成する。
+   * 省けた時間の見積もりは`getStats`の`kanaCache.savedNs`で確認できる。
+   * @param {number} capacity 記録する件数
+   * @returns {Promise<void>}
+   */
+  kanaCacheSetCapacity(capacity: number): Promise<void> {
+    return new Promise<void>((resolve) => {
+      checkValidNumber(capacity, "capacity", true);
+      if (capacity < 0) throw new VoicevoxJsError("capacityは0以上にしてください");
+      this[Core].kanaCacheSetCapacity(capacity);
+      resolve();
+    });
+  }
+
+  /**
+   * 合成結果のBufferの領域を使い回す、戻った領域の合計の上限(バイト)を設定する。既定は0(使い回さない)。
+   * 有効にすると`VoicevoxSynthesizer#synthesis`・`tts`・`ttsFromKana`などの結果は、大きさの区分ごとに使い回す領域の上に作られる。
+   * 結果を使い終えたら`releaseBuffer`で手放すと、GCを待たずに次の結果に使われる。命中率と占有量は`getStats`の`bufferPool`で確認できる。
+   * @param {number} capacity 戻った領域を保持するバイト数の上限
+   * @returns {Promise<void>}
+   */
+  bufferPoolSetCapacity(capacity: number): Promise<void> {
+    return new Promise<void>((resolve) => {
+      checkValidNumber(capacity, "capacity", true);
+      if (capacity < 0 || capacity > 0xffffffff) throw new VoicevoxJsError("capacityは0から2^32-1の範囲にしてください");
+      this[Core].bufferPoolSetCapacity(capacity);
+      resolve();
+    });
+  }
+
+  /**
+   * `bufferPoolSetCapacity`で有効にしたプールの結果のBufferを手放し、領域をすぐに使い回せるようにする。
+   * 手放したBuffer(と、そこから作った`subarray`など)は長さ0になるため、書き出しなどを終えてから呼ぶこと。
+   * @param {Buffer} buffer 合成結果のBuffer
+   * @returns {Promise<boolean>} プールが作ったBufferでない・手放し済みの場合は`false`
+   */
+  releaseBuffer(buffer: Buffer): Promise<boolean> {
+    return new Promise<boolean>((resolve) => {
+      if (!Buffer.isBuffer(buffer)) throw new VoicevoxJsError("bufferがBufferではありません");
+      resolve(this[Core].bufferPoolRelease(buffer).result);
+    });
+  }
+
+  /**
+   * 16ビットリニアPCM(リトルエンディアン、チャンネルごとにインターリーブ)のサンプリングレートを変換する。変換はスレッドプールで行う。
+   * 変換比を既約分数にしたときの分子が1024を超える組(44100Hzから44099Hzなど)は扱えない。
+   * @param {Buffer} pcm PCM
+   * @param {number} inputRate 入力のサンプリングレート
+   * @param {number} outputRate 出力のサンプリングレート
+   * @param {number} channels チャンネル数
+   * @returns {Promise<Buffer>} 変換後のPCM
+   */
+  resamplePcm(pcm: Buffer, inputRate: number, outputRate: number, channels: number = 1): Promise<Buffer> {
+    return new Promise<Buffer>((resolve) => {
+      if (!Buffer.isBuffer(pcm)) throw new VoicevoxJsError("pcmがBufferではありません");
+      checkValidNumber(inputRate, "inputRate", true);
+      checkValidNumber(outputRate, "outputRate", true);
+      checkValidNumber(channels, "channels", true);
+      if (inputRate <= 0 || outputRate <= 0) throw new VoicevoxJsError("サンプリングレートは正の値にしてください");
+      if (channels <= 0) throw new VoicevoxJsError("channelsは正の値にしてください");
+      resolve(this[Core].resamplePcmAsync(pcm, inputRate, outputRate, channels).then(({ result }) => result));
+    });
+  }
+
+  /**
+   * 16ビットリニアPCMのWAVのサンプリングレートを変換する。変換はスレッドプールで行う。
+   * 合成と同時に変換する場合は、`VoicevoxTtsOptions`などの`outputSamplingRate`を使う。
+   * @param {Buffer} wav WAV
+   * @param {number} outputRate 出力のサンプリングレート
+   * @returns {Promise<Buffer>} 変換後のWAV
+   */
+  resampleWav(wav: Buffer, outputRate: number): Promise<Buffer> {
+    return new Promise<Buffer>((resolve) => {
+      if (!Buffer.isBuffer(wav)) throw new VoicevoxJsError("wavがBufferではありません");
+      checkValidNumber(outputRate, "outputRate", true);
+      if (outputRate <= 0) throw new VoicevoxJsError("outputRateは正の値にしてください");
+      resolve(this[Core].resampleWavAsync(wav, outputRate).then(({ result }) => result));
+    });
+  }
+
+  /**
+   * 統計情報を取得する。
+   * @returns {Promise<VoicevoxStats>}
+   */
+  getStats(): Promise<VoicevoxStats> {
+    return new Promise<VoicevoxStats>((resolve) => {
+      const { result } = this[Core].getStats();
+      resolve(result);
+    });
+  }
+
   /**
    * デフォルトの初期化オプションを生成する
    * @returns {VoicevoxInitializeOptions} デフォルト値が設定された初期化オプション
@@ -194,6 +420,7 @@ class VoicevoxOpenJtalkRc {
   /**
    * OpenJtalkの使うユーザー辞書を設定する。
    * この関数を呼び出した後にユーザー辞書を変更した場合、再度この関数を呼び出す必要がある。
+   * 完了するまで、このOpen JTalkとユーザー辞書は破棄できない。
    * @param {VoicevoxUserDict} userDict ユーザー辞書
    * @returns {Promise<void>}
    */
@@ -201,9 +428,12 @@ class VoicevoxOpenJtalkRc {
     return new Promise<void>((resolve) => {
       checkValidObject(userDict, "userDict", VoicevoxUserDict, "VoicevoxUserDict");
       if (this[Deleted]) throw new VoicevoxJsError("Open JTalkは破棄済みです");
-      const { resultCode } = this.#voicevoxBase[Core].voicevoxOpenJtalkRcUseUserDictV0_16(this[Pointer], userDict[Pointer]);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve();
+      // 辞書の再構築はスレッドプールで行う。完了するまでこのOpen JTalkとユーザー辞書は破棄できない
+      resolve(
+        this.#voicevoxBase[Core].voicevoxOpenJtalkRcUseUserDictAsyncV0_16(this[Pointer], userDict[Pointer]).then(({ resultCode }) => {
+          if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+        })
+      );
     });
   }
 
@@ -450,6 +680,198 @@ class VoicevoxSynthesizer {
     });
   }
 
+  /**
+   * 日本語テキストからAudioQueryを生成し、ネイティブ側で保持する`VoicevoxAudioQuery`を構築(_construct_)する。
+   * 音高・長さを何度も書き換えてから合成する場合は、`createAudioQuery`よりもJSONの変換が少なく済む。
+   * 解放は`VoicevoxAudioQuery#delete`で行う。
+   * @param {string} text UTF-8の日本語テキスト
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @returns {Promise<VoicevoxAudioQuery>}
+   */
+  createAudioQueryHandle(text: string, styleId: VoicevoxStyleId): Promise<VoicevoxAudioQuery> {
+    return new Promise<VoicevoxAudioQuery>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidString(text, "text");
+      checkValidNumber(styleId, "styleId", true);
+      const audioQueryPointerName = this.#voicevoxBase[AudioQueryCounter]++;
+      const { resultCode } = this.#voicevoxBase[Core].voicevoxSynthesizerCreateAudioQueryHandleV0_16(this[Pointer], text, styleId, audioQueryPointerName);
+      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+      resolve(new VoicevoxAudioQuery(this.#voicevoxBase, audioQueryPointerName));
+    });
+  }
+
+  /**
+   * `VoicevoxAudioQuery`から音声合成を行う。
+   * 呼び出した時点の内容で合成するため、完了を待たずに`audioQuery`を書き換えてよい。
+   * @param {VoicevoxAudioQuery} audioQuery AudioQuery
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @param {VoicevoxSynthesisOptions} options オプション
+   * @returns {Promise<Buffer>}
+   */
+  synthesisAudioQuery(audioQuery: VoicevoxAudioQuery, styleId: VoicevoxStyleId, options: VoicevoxSynthesisOptions): Promise<Buffer> {
+    return new Promise<Buffer>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidObject(audioQuery, "audioQuery", VoicevoxAudioQuery, "VoicevoxAudioQuery");
+      if (audioQuery[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      checkValidNumber(styleId, "styleId", true);
+      checkVoicevoxSynthesisOptions(options);
+      // 合成はスレッドプールで行う
+      resolve(
+        this.#voicevoxBase[Core].voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16(this[Pointer], audioQuery[Pointer], styleId, options.enableInterrogativeUpspeak, options.outputSamplingRate ?? 0, OutputFormat[options.outputFormat ?? "wav"], options.targetLoudness, options.postProcess).then(({ result, resultCode }) => {
+          if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+          return result;
+        })
+      );
+    });
+  }
+
+  /**
+   * `VoicevoxAudioQuery`から音声合成を行い、決まった長さのフレームに区切って渡す。
+   * `onFrames`は`framesPerBatch`フレーム(最後は残りのフレーム)をつなげた1つのBufferで呼ばれ、最後のフレームは無音で埋められる。
+   * フレームごとに扱う場合は`batch.subarray`で切り出す。`onFrames`が`false`を返すと以降は渡さない。
+   * @param {VoicevoxAudioQuery} audioQuery AudioQuery
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @param {VoicevoxFrameOptions} options オプション
+   * @param {(batch: Buffer, frames: number) => boolean | void} onFrames フレームを受け取るコールバック
+   * @returns {Promise<VoicevoxFrameStreamResult>} 全て渡し終えるか中止した時点で解決される
+   */
+  synthesisFrames(audioQuery: VoicevoxAudioQuery, styleId: VoicevoxStyleId, options: VoicevoxFrameOptions, onFrames: (batch: Buffer, frames: number) => boolean | void): Promise<VoicevoxFrameStreamResult> {
+    return new Promise<VoicevoxFrameStreamResult>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidObject(audioQuery, "audioQuery", VoicevoxAudioQuery, "VoicevoxAudioQuery");
+      if (audioQuery[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      checkValidNumber(styleId, "styleId", true);
+      checkVoicevoxFrameOptions(options);
+      if (typeof onFrames !== "function") throw new VoicevoxJsError("onFramesが関数ではありません");
+      resolve(
+        this.#voicevoxBase[Core]
+          .voicevoxSynthesizerSynthesisFramesAsyncV0_16(this[Pointer], audioQuery[Pointer], styleId, options.enableInterrogativeUpspeak, options.outputSamplingRate ?? 0, OutputFormat[options.outputFormat ?? "pcm"], options.frameMs, options.framesPerBatch, options.pace, onFrames, options.targetLoudness, options.postProcess)
+          .then(({ result, resultCode }) => {
+            if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+            return result;
+          })
+      );
+    });
+  }
+
+  /**
+   * `VoicevoxAudioQuery`から音声合成を行い、ファイルに書き込む。
+   * 変換と書き込みはスレッドプールで少しずつ行うため、音声はJSのヒープに載らない。
+   * 同じディレクトリの一時ファイル(`path + ".<pid>.<連番>.tmp"`)に書き込んでから置き換えるため、失敗した場合に書きかけのファイルは残らない。
+   * @param {string} path 書き込むファイル。既にある場合は置き換える
+   * @param {VoicevoxAudioQuery} audioQuery AudioQuery
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @param {VoicevoxFileOptions} options オプション
+   * @returns {Promise<VoicevoxFileResult>}
+   */
+  synthesisToFile(path: string, audioQuery: VoicevoxAudioQuery, styleId: VoicevoxStyleId, options: VoicevoxFileOptions): Promise<VoicevoxFileResult> {
+    return new Promise<VoicevoxFileResult>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidString(path, "path");
+      checkValidObject(audioQuery, "audioQuery", VoicevoxAudioQuery, "VoicevoxAudioQuery");
+      if (audioQuery[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      checkValidNumber(styleId, "styleId", true);
+      checkVoicevoxFileOptions(options);
+      resolve(
+        this.#voicevoxBase[Core]
+          .voicevoxSynthesizerSynthesisToFileAsyncV0_16(
+            this[Pointer],
+            audioQuery[Pointer],
+            styleId,
+            options.enableInterrogativeUpspeak,
+            options.outputSamplingRate ?? 0,
+            OutputFormat[options.outputFormat ?? "wav"],
+            path,
+            options.patchWavHeader ?? false,
+            options.targetLoudness,
+            options.postProcess
+          )
+          .then(({ result, resultCode }) => {
+            if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+            return result;
+          })
+      );
+    });
+  }
+
+  /**
+   * `VoicevoxAudioQuery`から音声合成を行い、ファイルディスクリプタ(ファイル・パイプ・ソケット)へ直接書き込む。
+   * 合成・変換・書き込みは専用のスレッドで行い、音声はJSのヒープに載らない。非ブロッキングのソケットでは書き込めるようになるまで待つ。
+   * 書き込みが終わるまで、`fd`を閉じたりJS側から同じ`fd`へ書き込んだりしないこと。`fd`は閉じない。
+   * Windowsではファイルのディスクリプタ(`fs.open`で開いたもの)にのみ書き込める。
+   * @param {number} fd 書き込むファイルディスクリプタ
+   * @param {VoicevoxAudioQuery} audioQuery AudioQuery
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @param {VoicevoxFdOptions} options オプション
+   * @returns {Promise<VoicevoxFileResult>} 書き込みに失敗した場合は`VoicevoxJsError`以外のErrorでrejectされる
+   */
+  synthesisToFd(fd: number, audioQuery: VoicevoxAudioQuery, styleId: VoicevoxStyleId, options: VoicevoxFdOptions): Promise<VoicevoxFileResult> {
+    return new Promise<VoicevoxFileResult>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidNumber(fd, "fd", true);
+      if (fd < 0 || fd > 0x7fffffff) throw new VoicevoxJsError("fdが有効なファイルディスクリプタではありません");
+      checkValidObject(audioQuery, "audioQuery", VoicevoxAudioQuery, "VoicevoxAudioQuery");
+      if (audioQuery[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      checkValidNumber(styleId, "styleId", true);
+      checkVoicevoxFdOptions(options);
+      resolve(
+        this.#voicevoxBase[Core]
+          .voicevoxSynthesizerSynthesisToFdAsyncV0_16(
+            this[Pointer],
+            audioQuery[Pointer],
+            styleId,
+            options.enableInterrogativeUpspeak,
+            options.outputSamplingRate ?? 0,
+            OutputFormat[options.outputFormat ?? "wav"],
+            fd,
+            options.timeoutMs ?? 0,
+            options.patchWavHeader ?? false,
+            options.targetLoudness,
+            options.postProcess
+          )
+          .then(({ result, resultCode }) => {
+            if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+            return result;
+          })
+      );
+    });
+  }
+
+  /**
+   * `VoicevoxAudioQuery`から音声合成を行い、Readableで少しずつ読み出す。
+   * 合成と変換は専用のスレッドで行い、容量`ringBytes`のリングバッファを通して渡す。読み出しが遅い間は変換・書き込みが止まるため、
+   * ネイティブ側の滞留はリングバッファの容量、JS側の滞留は`highWaterMark`までに抑えられる。
+   * 途中でやめる場合は`destroy`を呼ぶこと(読み出さないまま放置すると、書き込みスレッドが待ち続ける)。
+   * @param {VoicevoxAudioQuery} audioQuery AudioQuery
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @param {VoicevoxStreamOptions} options オプション
+   * @returns {Readable} 合成に失敗した場合は`VoicevoxError`で`error`になる
+   */
+  synthesisStream(audioQuery: VoicevoxAudioQuery, styleId: VoicevoxStyleId, options: VoicevoxStreamOptions): Readable {
+    if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+    checkValidObject(audioQuery, "audioQuery", VoicevoxAudioQuery, "VoicevoxAudioQuery");
+    if (audioQuery[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+    checkValidNumber(styleId, "styleId", true);
+    checkVoicevoxStreamOptions(options);
+    const core = this.#voicevoxBase[Core];
+    const streamPointerName = this.#voicevoxBase[PcmStreamCounter]++;
+    const stream = new VoicevoxSynthesisStream(core, streamPointerName, options.highWaterMark ?? 16 * 1024);
+    core.voicevoxSynthesizerSynthesisStreamV0_16(
+      this[Pointer],
+      audioQuery[Pointer],
+      styleId,
+      options.enableInterrogativeUpspeak,
+      options.outputSamplingRate ?? 0,
+      OutputFormat[options.outputFormat ?? "pcm"],
+      options.ringBytes ?? 64 * 1024,
+      streamPointerName,
+      () => stream[Pull](),
+      options.targetLoudness,
+      options.postProcess
+    );
+    return stream;
+  }
+
   /**
    * AquesTalk風記法から音声合成を行う。
    * @param {string} kana AquesTalk風記法
@@ -482,150 +904,863 @@ class VoicevoxSynthesizer {
       checkValidString(text, "text");
       checkValidNumber(styleId, "styleId", true);
       checkVoicevoxTtsOptions(options);
-      const { result, resultCode } = this.#voicevoxBase[Core].voicevoxSynthesizerTtsV0_16(this[Pointer], text, styleId, options.enableInterrogativeUpspeak);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve(result);
+      // 合成はスレッドプールで行う
+      resolve(
+        this.#voicevoxBase[Core].voicevoxSynthesizerTtsAsyncV0_16(this[Pointer], text, styleId, options.enableInterrogativeUpspeak, options.outputSamplingRate ?? 0, OutputFormat[options.outputFormat ?? "wav"], options.targetLoudness, options.postProcess).then(({ result, resultCode }) => {
+          if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+          return result;
+        })
+      );
+    });
+  }
+
+  /**
+   * 使うOpenJtalkRcを切り替える。
+   * 新しいOpenJtalkRcでシンセサイザを作り直し、読み込み済みの音声モデルを読み込み直してから切り替えるため、合成を止めずにユーザー辞書を更新できる。
+   * 切り替えるまでに呼び出した合成はそのまま古いOpenJtalkRcで行われる。
+   *
+   * 費用と制限:
+   * - 音声モデルは`loadVoiceModel`したときのファイルから開き直して読み込むため、切り替えのたびに全ての音声モデルを読み込む時間がかかり、
+   *   完了するまでは古いシンセサイザと合わせて音声モデルのメモリが2倍になる。
+   * - 開き直すため、読み込んだときのファイルは残しておくこと(`VoicevoxVoiceModel`は破棄してよい)。
+   * - 完了するまで、このシンセサイザと`openJtalkRc`は破棄できず、`loadVoiceModel`・`unloadVoiceModel`は例外を発生する。
+   *
+   * 合成を少しの間止めてもよく、辞書だけを更新したい場合は、このシンセサイザを作ったOpenJtalkRcの`useUserDict`を呼ぶ方が軽い
+   * (シンセサイザはOpenJtalkRcを共有しているため、作り直さずに反映される)。
+   * @param {VoicevoxOpenJtalkRc} openJtalkRc ユーザー辞書を設定済みのOpenJtalkRc
+   * @returns {Promise<void>}
+   */
+  swapOpenJtalkRc(openJtalkRc: VoicevoxOpenJtalkRc): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidObject(openJtalkRc, "openJtalkRc", VoicevoxOpenJtalkRc, "VoicevoxOpenJtalkRc");
+      resolve(
+        this.#voicevoxBase[Core].voicevoxSynthesizerSwapOpenJtalkAsyncV0_16(this[Pointer], openJtalkRc[Pointer]).then(({ resultCode }) => {
+          if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+        })
+      );
+    });
+  }
+
+  /**
+   * ユーザー辞書を反映したOpenJtalkRcを新しく作り、それに切り替える(`swapOpenJtalkRc`)。
+   * 辞書の読み込みからシンセサイザの作り直しまでスレッドプールで行うため、更新中も合成の遅延は増えない。
+   * 代わりに、呼び出すたびに全ての音声モデルを読み込み直し、その間は音声モデルのメモリが2倍になる(`swapOpenJtalkRc`の費用と制限を参照)。
+   * @param {string} openJtalkDicDir 辞書ディレクトリを指すUTF-8のパス
+   * @param {VoicevoxUserDict} userDict ユーザー辞書
+   * @returns {Promise<void>}
+   * @example
+   * ```js
+   * await userDict.addWord(word);
+   * await synthesizer.reloadUserDict("open_jtalk_dic_utf_8-1.11", userDict);
+   * ```
+   */
+  reloadUserDict(openJtalkDicDir: string, userDict: VoicevoxUserDict): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidObject(userDict, "userDict", VoicevoxUserDict, "VoicevoxUserDict");
+      resolve(
+        this.#voicevoxBase.openJtalkRcNew(openJtalkDicDir).then((openJtalkRc) =>
+          openJtalkRc
+            .useUserDict(userDict)
+            .then(() => this.swapOpenJtalkRc(openJtalkRc))
+            // シンセサイザは自身の参照を持つため、切り替え後はこちらを破棄してよい
+            .finally(() => openJtalkRc.delete())
+        )
+      );
     });
   }
 }
 
-class VoicevoxUserDict {
-  [Pointer]: number;
+/**
+ * `VoicevoxTenantPool`のシンセサイザ1つ分。
+ */
+interface VoicevoxTenantSlot {
+  openJtalkRc: VoicevoxOpenJtalkRc;
+  synthesizer: VoicevoxSynthesizer;
+  /** 実行中の呼び出しの数。0のものだけ別のテナントに使い回す */
+  busy: number;
+  /** 構築・ユーザー辞書の切り替えの完了 */
+  ready: Promise<void>;
+  /** 構築に失敗し、破棄済み */
+  discarded: boolean;
+}
+
+/**
+ * テナント(ユーザー辞書の異なる利用者)ごとに呼び出しを振り分ける。
+ *
+ * テナントごとにOpenJtalkRcとシンセサイザを持つ代わりに、最大`capacity`個のシンセサイザを用意し、
+ * 最近使われていないものからユーザー辞書を設定し直して使い回す(テナントを切り替えるときはOpenJtalkRcの辞書を設定し直すだけで、音声モデルは読み込み直さない)。
+ * 各シンセサイザはそれぞれ自分のOpenJtalkRc(システム辞書)を持ち、`models`を全て自分に読み込む(シンセサイザ同士で共有はしない)。
+ * そのため、メモリは登録したテナントの数ではなく、およそ`capacity` ×(システム辞書 + 全ての音声モデル)になる。
+ */
+class VoicevoxTenantPool {
   #voicevoxBase: Voicevox;
+  #openJtalkDicDir: string;
+  #models: Array<VoicevoxVoiceModel>;
+  #options: VoicevoxInitializeOptions;
+  #capacity: number;
   [Deleted]: boolean = false;
   get deleted(): boolean {
     return this[Deleted];
   }
-  constructor(base: Voicevox, pointer: number) {
+  /** テナント -> ユーザー辞書(`undefined`は辞書なし) */
+  #tenants = new Map<string, VoicevoxUserDict | undefined>();
+  /** テナント -> 割り当てたシンセサイザ。Mapの順を使われた順(先頭が最も古い)として扱う */
+  #slots = new Map<string, VoicevoxTenantSlot>();
+  /** 作成中のものも含めたシンセサイザの数 */
+  #size: number = 0;
+  /** 全てのシンセサイザが使用中のため、空くのを待っている呼び出し */
+  #waiters: Array<() => void> = [];
+  /** 辞書の無いテナントに切り替える際に設定する、空のユーザー辞書 */
+  #emptyUserDict: Promise<VoicevoxUserDict> | undefined;
+  #hits: number = 0;
+  #misses: number = 0;
+  #evictions: number = 0;
+  constructor(base: Voicevox, openJtalkDicDir: string, models: Array<VoicevoxVoiceModel>, options: VoicevoxInitializeOptions, capacity: number) {
     this.#voicevoxBase = base;
-    this[Pointer] = pointer;
+    this.#openJtalkDicDir = openJtalkDicDir;
+    this.#models = models;
+    this.#options = options;
+    this.#capacity = capacity;
   }
 
   /**
-   * ユーザー辞書にファイルを読み込ませる。
-   * @param {string} dictPath 読み込む辞書ファイルのパス
+   * テナントを登録する。既に登録されている場合はユーザー辞書を置き換える。
+   * 割り当て済みのシンセサイザがあれば、そのユーザー辞書も設定し直す(辞書を変更した後に呼び出せば反映される)。
+   * @param {string} tenantId テナントID
+   * @param {VoicevoxUserDict} [userDict] テナントのユーザー辞書。省略した場合は辞書なし
    * @returns {Promise<void>}
    */
-  load(dictPath: string): Promise<void> {
+  setTenant(tenantId: string, userDict?: VoicevoxUserDict): Promise<void> {
     return new Promise<void>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      checkValidString(dictPath, "dictPath");
-      const { resultCode } = this.#voicevoxBase[Core].voicevoxUserDictLoadV0_16(this[Pointer], dictPath);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve();
-    });
-  }
-
-  /**
-   * ユーザー辞書に単語を追加する。
-   * @param {VoicevoxUserDictWord} word 追加する単語
-   * @returns {Promise<string>} 追加した単語のUUID
-   */
-  addWord(word: VoicevoxUserDictWord): Promise<string> {
-    return new Promise<string>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      checkVoicevoxUserDictWord(word);
-      const { resultCode, result } = this.#voicevoxBase[Core].voicevoxUserDictAddWordV0_16(this[Pointer], word.surface, word.pronunciation, word.accentType, word.priority, word.wordType);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve(bufferToUuid(result));
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxTenantPoolは破棄されています");
+      checkValidString(tenantId, "tenantId");
+      if (userDict != null) checkValidObject(userDict, "userDict", VoicevoxUserDict, "VoicevoxUserDict");
+      this.#tenants.set(tenantId, userDict ?? undefined);
+      const slot = this.#slots.get(tenantId);
+      if (!slot) return resolve();
+      slot.ready = slot.ready.catch(() => {}).then(() => this.#specialize(slot, tenantId));
+      resolve(slot.ready);
     });
   }
 
   /**
-   * ユーザー辞書の単語を更新する。
-   * @param {string} wordUuid 更新する単語のUUID
-   * @param {VoicevoxUserDictWord} word 新しい単語のデータ
+   * テナントの登録を解除する。割り当てていたシンセサイザは、他のテナントに使い回される。
+   * @param {string} tenantId テナントID
    * @returns {Promise<void>}
    */
-  updateWord(wordUuid: string, word: VoicevoxUserDictWord): Promise<void> {
+  removeTenant(tenantId: string): Promise<void> {
     return new Promise<void>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      checkVoicevoxUserDictWord(word);
-      checkValidString(wordUuid, "wordUuid");
-      const { resultCode } = this.#voicevoxBase[Core].voicevoxUserDictUpdateWordV0_16(this[Pointer], word.surface, word.pronunciation, word.accentType, word.priority, word.wordType, uuidToBuffer(wordUuid));
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxTenantPoolは破棄されています");
+      checkValidString(tenantId, "tenantId");
+      this.#tenants.delete(tenantId);
       resolve();
     });
   }
 
   /**
-   * ユーザー辞書から単語を削除する。
-   * @param {string} wordUuid 更新する単語のUUID
-   * @returns {Promise<void>}
+   * テナントのユーザー辞書を設定したシンセサイザで`fn`を呼び出す。
+   * `fn`が完了するまで、そのシンセサイザは他のテナントに使い回されない。
+   * @param {string} tenantId テナントID
+   * @param {(synthesizer: VoicevoxSynthesizer) => Promise<T>} fn シンセサイザを使う処理
+   * @returns {Promise<T>} `fn`の結果
+   * @example
+   * ```js
+   * const query = await pool.run("tenant-a", (synthesizer) => synthesizer.createAudioQuery(text, styleId));
+   * ```
    */
-  removeWord(wordUuid: string): Promise<void> {
-    return new Promise<void>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      checkValidString(wordUuid, "wordUuid");
-      const { resultCode } = this.#voicevoxBase[Core].voicevoxUserDictRemoveWordV0_16(this[Pointer], uuidToBuffer(wordUuid));
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve();
+  run<T>(tenantId: string, fn: (synthesizer: VoicevoxSynthesizer) => Promise<T>): Promise<T> {
+    return new Promise<T>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxTenantPoolは破棄されています");
+      checkValidString(tenantId, "tenantId");
+      if (typeof fn !== "function") throw new VoicevoxJsError("fnがfunctionではありません");
+      if (!this.#tenants.has(tenantId)) throw new VoicevoxJsError(`テナント${tenantId}は登録されていません`);
+      resolve(this.#acquire(tenantId).then((slot) => new Promise<T>((done) => done(fn(slot.synthesizer))).finally(() => this.#release(slot))));
     });
   }
 
   /**
-   * ユーザー辞書の単語を出力する。
-   * @returns {Promise<VoicevoxUserDictsJson>}
+   * テナントのユーザー辞書を使って、日本語テキストから音声合成を行う。
+   * @param {string} tenantId テナントID
+   * @param {string} text UTF-8の日本語テキスト
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @param {VoicevoxTtsOptions} options オプション
+   * @returns {Promise<Buffer>}
    */
-  toJson(): Promise<VoicevoxUserDictsJson> {
-    return new Promise<VoicevoxUserDictsJson>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      const { result, resultCode } = this.#voicevoxBase[Core].voicevoxUserDictToJsonV0_16(this[Pointer]);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve(JSON.parse(result));
-    });
+  tts(tenantId: string, text: string, styleId: VoicevoxStyleId, options: VoicevoxTtsOptions): Promise<Buffer> {
+    return this.run(tenantId, (synthesizer) => synthesizer.tts(text, styleId, options));
   }
 
   /**
-   * 他のユーザー辞書をインポートする。
-   * @param {VoicevoxUserDict} otherDict インポートするユーザー辞書
-   * @returns {Promise<void>}
+   * テナントのユーザー辞書を使って、日本語テキストから`AudioQuery`を生成する。
+   * @param {string} tenantId テナントID
+   * @param {string} text UTF-8の日本語テキスト
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @returns {Promise<VoicevoxAudioQueryJson>}
    */
-  import(otherDict: VoicevoxUserDict): Promise<void> {
-    return new Promise<void>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      checkValidObject(otherDict, "otherDict", VoicevoxUserDict, "VoicevoxUserDict");
-      const { resultCode } = this.#voicevoxBase[Core].voicevoxUserDictImportV0_16(this[Pointer], otherDict[Pointer]);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve();
-    });
+  createAudioQuery(tenantId: string, text: string, styleId: VoicevoxStyleId): Promise<VoicevoxAudioQueryJson> {
+    return this.run(tenantId, (synthesizer) => synthesizer.createAudioQuery(text, styleId));
   }
 
   /**
-   * ユーザー辞書をファイルに保存する。
-   * @param {string} path 保存先のファイルパス
-   * @returns {Promise<void>}
+   * 振り分けの統計を取得する。
+   * @returns {Promise<VoicevoxTenantPoolStats>}
    */
-  save(path: string): Promise<void> {
-    return new Promise<void>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      checkValidString(path, "path");
-      const { resultCode } = this.#voicevoxBase[Core].voicevoxUserDictSaveV0_16(this[Pointer], path);
-      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
-      resolve();
+  getStats(): Promise<VoicevoxTenantPoolStats> {
+    return new Promise<VoicevoxTenantPoolStats>((resolve) => {
+      resolve({ capacity: this.#capacity, size: this.#size, tenants: this.#tenants.size, hits: this.#hits, misses: this.#misses, evictions: this.#evictions });
     });
   }
 
   /**
-   * ユーザー辞書を破棄(_destruct_)する。
+   * `VoicevoxTenantPool`を破棄(_destruct_)する。作成したシンセサイザとOpenJtalkRcも破棄する。
+   * 実行中の呼び出しがある場合、シンセサイザはそれが終わってから解放される。
    * @returns {Promise<void>}
    */
   delete(): Promise<void> {
     return new Promise<void>((resolve) => {
-      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
-      this.#voicevoxBase[Core].voicevoxUserDictDeleteV0_16(this[Pointer]);
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxTenantPoolは破棄されています");
       this[Deleted] = true;
-      resolve();
+      const slots = Array.from(this.#slots.values());
+      this.#slots.clear();
+      this.#tenants.clear();
+      const emptyUserDict = this.#emptyUserDict;
+      // 待っている呼び出しは、起こすと破棄済みとしてrejectされる
+      for (const wake of this.#waiters.splice(0)) wake();
+      resolve(
+        Promise.all(
+          slots.map((slot) =>
+            slot.ready
+              .catch(() => {})
+              .then(async () => {
+                if (slot.discarded) return;
+                await slot.synthesizer.delete();
+                await slot.openJtalkRc.delete();
+              })
+          )
+        ).then(() => emptyUserDict?.then((userDict) => userDict.delete()))
+      );
     });
   }
-}
 
-class VoicevoxVoiceModel {
-  [Pointer]: number;
-  #voicevoxBase: Voicevox;
-  [Deleted]: boolean = false;
-  get deleted(): boolean {
-    return this[Deleted];
+  #acquire(tenantId: string): Promise<VoicevoxTenantSlot> {
+    if (this[Deleted]) return Promise.reject(new VoicevoxJsError("VoicevoxTenantPoolは破棄されています"));
+    if (!this.#tenants.has(tenantId)) return Promise.reject(new VoicevoxJsError(`テナント${tenantId}は登録されていません`));
+    let slot = this.#slots.get(tenantId);
+    if (slot) {
+      this.#hits++;
+      // 使われた順の末尾へ移す
+      this.#slots.delete(tenantId);
+      // 前回のユーザー辞書の設定に失敗していれば、やり直す
+      const hit = slot;
+      slot.ready = slot.ready.catch((e) => {
+        if (hit.discarded) throw e;
+        return this.#specialize(hit, tenantId);
+      });
+    } else if (this.#size < this.#capacity) {
+      this.#misses++;
+      this.#size++;
+      slot = this.#create(tenantId);
+    } else {
+      let lru: [string, VoicevoxTenantSlot] | undefined;
+      for (const entry of this.#slots) {
+        if (entry[1].busy === 0) {
+          lru = entry;
+          break;
+        }
+      }
+      if (!lru) return new Promise<void>((wake) => this.#waiters.push(wake)).then(() => this.#acquire(tenantId));
+      this.#misses++;
+      this.#evictions++;
+      this.#slots.delete(lru[0]);
+      slot = lru[1];
+      const evicted = slot;
+      slot.ready = slot.ready.catch(() => {}).then(() => this.#specialize(evicted, tenantId));
+    }
+    this.#slots.set(tenantId, slot);
+    slot.busy++;
+    const acquired = slot;
+    return slot.ready.then(
+      () => acquired,
+      (e) => {
+        this.#release(acquired);
+        throw e;
+      }
+    );
+  }
+
+  #release(slot: VoicevoxTenantSlot) {
+    slot.busy--;
+    if (slot.busy === 0) this.#waiters.shift()?.();
+  }
+
+  #create(tenantId: string): VoicevoxTenantSlot {
+    const slot = {} as VoicevoxTenantSlot;
+    slot.busy = 0;
+    slot.discarded = false;
+    slot.ready = (async () => {
+      try {
+        if (this.#models.some((model) => model.deleted))
+          throw new VoicevoxJsError("VoicevoxTenantPoolに渡したVoicevoxVoiceModelが破棄されています(プールを破棄するまで開いておいてください)");
+        slot.openJtalkRc = await this.#voicevoxBase.openJtalkRcNew(this.#openJtalkDicDir);
+        slot.synthesizer = await this.#voicevoxBase.synthesizerNew(slot.openJtalkRc, this.#options);
+        for (const model of this.#models) await slot.synthesizer.loadVoiceModel(model);
+        await this.#specialize(slot, tenantId);
+      } catch (e) {
+        // 作れなかった枠は捨て、次の呼び出しで作り直す
+        for (const [id, other] of this.#slots) if (other === slot) this.#slots.delete(id);
+        this.#size--;
+        slot.discarded = true;
+        if (slot.synthesizer) await slot.synthesizer.delete().catch(() => {});
+        if (slot.openJtalkRc) await slot.openJtalkRc.delete().catch(() => {});
+        this.#waiters.shift()?.();
+        throw e;
+      }
+    })();
+    return slot;
+  }
+
+  /**
+   * シンセサイザのOpenJtalkRcにテナントのユーザー辞書を設定する(シンセサイザはOpenJtalkRcを共有しているため、作り直す必要はない)。
+   */
+  #specialize(slot: VoicevoxTenantSlot, tenantId: string): Promise<void> {
+    const userDict = this.#tenants.get(tenantId);
+    if (userDict) return slot.openJtalkRc.useUserDict(userDict);
+    this.#emptyUserDict ??= this.#voicevoxBase.userDictNew();
+    return this.#emptyUserDict.then((emptyUserDict) => slot.openJtalkRc.useUserDict(emptyUserDict));
+  }
+}
+
+class VoicevoxUserDict {
+  [Pointer]: number;
+  #voicevoxBase: Voicevox;
+  [Deleted]: boolean = false;
+  get deleted(): boolean {
+    return this[Deleted];
+  }
+  /** 保存中に呼ばれた変更の列の末尾(保存中でなければ`undefined`) */
+  #pending: Promise<unknown> | undefined;
+  constructor(base: Voicevox, pointer: number) {
+    this.#voicevoxBase = base;
+    this[Pointer] = pointer;
+  }
+
+  /**
+   * 辞書を変更する処理を実行する。
+   * 保存中であれば、保存が終わるまで待たせる(保存される内容を`save`を呼び出した時点のものに保ち、書き込み中のvoicevox_coreのロックでメインスレッドを止めないため)。
+   * @param {boolean} [saving=false] `fn`が保存であれば`true`にし、以降の変更を待たせる
+   */
+  #enqueue<T>(fn: () => Promise<T>, saving: boolean = false): Promise<T> {
+    if (!this.#pending && !saving) return fn();
+    const result = (this.#pending ?? Promise.resolve()).then(fn);
+    const tail = result.then(
+      () => {},
+      () => {}
+    );
+    this.#pending = tail;
+    tail.then(() => {
+      if (this.#pending === tail) this.#pending = undefined;
+    });
+    return result;
+  }
+
+  /**
+   * ユーザー辞書にファイルを読み込ませる。
+   * 読み込みはスレッドプールで行い、完了するまでこのユーザー辞書は破棄できない。
+   * @param {string} dictPath 読み込む辞書ファイルのパス
+   * @returns {Promise<void>}
+   */
+  load(dictPath: string): Promise<void> {
+    return this.#enqueue(() =>
+      new Promise<void>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        checkValidString(dictPath, "dictPath");
+        resolve(
+          this.#voicevoxBase[Core].voicevoxUserDictLoadAsyncV0_16(this[Pointer], dictPath).then(({ resultCode }) => {
+            if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+          })
+        );
+      })
+    );
+  }
+
+  /**
+   * ユーザー辞書に単語を追加する。
+   * @param {VoicevoxUserDictWord} word 追加する単語
+   * @returns {Promise<string>} 追加した単語のUUID
+   */
+  addWord(word: VoicevoxUserDictWord): Promise<string> {
+    return this.#enqueue(() =>
+      new Promise<string>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        checkVoicevoxUserDictWord(word);
+        const { resultCode, result } = this.#voicevoxBase[Core].voicevoxUserDictAddWordV0_16(this[Pointer], word.surface, word.pronunciation, word.accentType, word.priority, word.wordType);
+        if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+        resolve(bufferToUuid(result));
+      })
+    );
+  }
+
+  /**
+   * ユーザー辞書に複数の単語をまとめて追加する。
+   * 追加はスレッドプールで一度に行い、完了するまでこのユーザー辞書は破棄できない。
+   * 途中で失敗した場合は、それまでに追加した単語も取り除かれる。
+   * @param {VoicevoxUserDictWords} words 追加する単語(列ごとの配列、長さは揃える)
+   * @returns {Promise<Buffer>} 追加した単語のUUIDを順に並べたもの(16バイト×単語数)
+   * @example
+   * ```js
+   * const uuids = await userDict.addWords({ surface, pronunciation, accentType, priority, wordType });
+   * bufferToUuid(uuids.subarray(i * 16, i * 16 + 16)); // i番目の単語のUUID
+   * ```
+   */
+  addWords(words: VoicevoxUserDictWords): Promise<Buffer> {
+    return this.#enqueue(() =>
+      new Promise<Buffer>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        if (words == null) throw new VoicevoxJsError("有効なVoicevoxUserDictWordsではありません(存在しない)");
+        checkValidArray(words.surface, "surface", "string");
+        checkValidArray(words.pronunciation, "pronunciation", "string");
+        const accentType = toUint32Array(words.accentType, "accentType");
+        const priority = toUint32Array(words.priority, "priority");
+        const wordType = toUint32Array(words.wordType, "wordType");
+        resolve(
+          this.#voicevoxBase[Core].voicevoxUserDictAddWordsAsyncV0_16(this[Pointer], words.surface, words.pronunciation, accentType, priority, wordType).then(({ resultCode, result, failedIndex }) => {
+            if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(`${this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result}(${failedIndex}番目の単語)`);
+            return result;
+          })
+        );
+      })
+    );
+  }
+
+  /**
+   * ユーザー辞書の単語をUUIDで探す。
+   * 辞書全体をJSONに書き出さず、このライブラリが持つ索引から探す。
+   * @param {string} wordUuid 単語のUUID
+   * @returns {Promise<VoicevoxUserDictFoundWord | undefined>} 見つからない場合は`undefined`
+   */
+  getWord(wordUuid: string): Promise<VoicevoxUserDictFoundWord | undefined> {
+    return new Promise<VoicevoxUserDictFoundWord | undefined>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+      checkValidString(wordUuid, "wordUuid");
+      const { result } = this.#voicevoxBase[Core].voicevoxUserDictFindWordV0_16(this[Pointer], uuidToBuffer(wordUuid));
+      resolve(result && toFoundWord(result));
+    });
+  }
+
+  /**
+   * ユーザー辞書から表記が一致する単語を探す。
+   * 表記は辞書への登録時と同じく、ASCIIの英数字・記号を全角に変換してから比べる。
+   * @param {string} surface 表記
+   * @returns {Promise<Array<VoicevoxUserDictFoundWord>>}
+   */
+  findWords(surface: string): Promise<Array<VoicevoxUserDictFoundWord>> {
+    return new Promise<Array<VoicevoxUserDictFoundWord>>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+      checkValidString(surface, "surface");
+      const { result } = this.#voicevoxBase[Core].voicevoxUserDictFindWordsBySurfaceV0_16(this[Pointer], surface);
+      resolve(result.map(toFoundWord));
+    });
+  }
+
+  /**
+   * ユーザー辞書から表記が前方一致する単語を、表記の順に探す。
+   * @param {string} prefix 表記の先頭
+   * @param {number} [limit=100] 最大件数
+   * @returns {Promise<Array<VoicevoxUserDictFoundWord>>}
+   */
+  searchWords(prefix: string, limit: number = 100): Promise<Array<VoicevoxUserDictFoundWord>> {
+    return new Promise<Array<VoicevoxUserDictFoundWord>>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+      checkValidString(prefix, "prefix");
+      checkValidNumber(limit, "limit", true);
+      const { result } = this.#voicevoxBase[Core].voicevoxUserDictFindWordsByPrefixV0_16(this[Pointer], prefix, limit);
+      resolve(result.map(toFoundWord));
+    });
+  }
+
+  /**
+   * ユーザー辞書をバイナリのスナップショットとして保存する。
+   * 呼び出した時点の内容を、JSONを経由せずにスレッドプールで書き込む。書き込みは一時ファイルを経由して置き換えるため、途中で失敗しても既存のファイルは壊れない。
+   * @param {string} path 保存先のパス
+   * @returns {Promise<void>}
+   */
+  saveSnapshot(path: string): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+      checkValidString(path, "path");
+      resolve(
+        this.#voicevoxBase[Core].voicevoxUserDictSaveSnapshotAsyncV0_16(this[Pointer], path).then(
+          () => {},
+          (e: Error) => {
+            throw new VoicevoxJsError(e.message);
+          }
+        )
+      );
+    });
+  }
+
+  /**
+   * `saveSnapshot`で保存したスナップショットの単語を、このユーザー辞書に追加する。
+   * 単語のUUIDは新しく割り当てられる。失敗した場合は何も追加されない。
+   * @param {string} path スナップショットのパス
+   * @returns {Promise<VoicevoxUserDictSnapshotLoadResult>} 追加した単語のUUIDと、それぞれのスナップショットでのUUID
+   */
+  loadSnapshot(path: string): Promise<VoicevoxUserDictSnapshotLoadResult> {
+    return this.#enqueue(() =>
+      new Promise<VoicevoxUserDictSnapshotLoadResult>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        checkValidString(path, "path");
+        resolve(
+          this.#voicevoxBase[Core].voicevoxUserDictLoadSnapshotAsyncV0_16(this[Pointer], path).then(
+            ({ resultCode, result, snapshotWordUuids, failedIndex }) => {
+              if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(`${this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result}(${failedIndex}番目の単語)`);
+              return { wordUuids: result!, snapshotWordUuids: snapshotWordUuids! };
+            },
+            (e: Error) => {
+              throw new VoicevoxJsError(e.message);
+            }
+          )
+        );
+      })
+    );
+  }
+
+  /**
+   * ユーザー辞書の単語を更新する。
+   * @param {string} wordUuid 更新する単語のUUID
+   * @param {VoicevoxUserDictWord} word 新しい単語のデータ
+   * @returns {Promise<void>}
+   */
+  updateWord(wordUuid: string, word: VoicevoxUserDictWord): Promise<void> {
+    return this.#enqueue(() =>
+      new Promise<void>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        checkVoicevoxUserDictWord(word);
+        checkValidString(wordUuid, "wordUuid");
+        const { resultCode } = this.#voicevoxBase[Core].voicevoxUserDictUpdateWordV0_16(this[Pointer], word.surface, word.pronunciation, word.accentType, word.priority, word.wordType, uuidToBuffer(wordUuid));
+        if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+        resolve();
+      })
+    );
+  }
+
+  /**
+   * ユーザー辞書から単語を削除する。
+   * @param {string} wordUuid 更新する単語のUUID
+   * @returns {Promise<void>}
+   */
+  removeWord(wordUuid: string): Promise<void> {
+    return this.#enqueue(() =>
+      new Promise<void>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        checkValidString(wordUuid, "wordUuid");
+        const { resultCode } = this.#voicevoxBase[Core].voicevoxUserDictRemoveWordV0_16(this[Pointer], uuidToBuffer(wordUuid));
+        if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+        resolve();
+      })
+    );
+  }
+
+  /**
+   * ユーザー辞書の単語を出力する。
+   * @returns {Promise<VoicevoxUserDictsJson>}
+   */
+  toJson(): Promise<VoicevoxUserDictsJson> {
+    return new Promise<VoicevoxUserDictsJson>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+      const { result, resultCode } = this.#voicevoxBase[Core].voicevoxUserDictToJsonV0_16(this[Pointer]);
+      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+      resolve(JSON.parse(result));
+    });
+  }
+
+  /**
+   * 他のユーザー辞書をインポートする。
+   * インポートはスレッドプールで行い、完了するまでどちらのユーザー辞書も破棄できない。
+   * @param {VoicevoxUserDict} otherDict インポートするユーザー辞書
+   * @returns {Promise<void>}
+   */
+  import(otherDict: VoicevoxUserDict): Promise<void> {
+    return this.#enqueue(() =>
+      new Promise<void>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        checkValidObject(otherDict, "otherDict", VoicevoxUserDict, "VoicevoxUserDict");
+        resolve(
+          this.#voicevoxBase[Core].voicevoxUserDictImportAsyncV0_16(this[Pointer], otherDict[Pointer]).then(({ resultCode }) => {
+            if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+          })
+        );
+      })
+    );
+  }
+
+  /**
+   * ユーザー辞書をファイルに保存する。
+   * 書き込みはスレッドプールで行い、一時ファイルを経由して置き換えるため、途中で失敗しても既存のファイルは壊れない。
+   * 保存が終わるまでに呼ばれた単語の追加・更新・削除などは、保存の後に行われる(保存されるのは呼び出した時点の内容)。
+   * @param {string} path 保存先のファイルパス
+   * @returns {Promise<void>}
+   */
+  save(path: string): Promise<void> {
+    return this.#enqueue(() =>
+      new Promise<void>((resolve) => {
+        if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+        checkValidString(path, "path");
+        resolve(
+          this.#voicevoxBase[Core].voicevoxUserDictSaveAsyncV0_16(this[Pointer], path).then(
+            ({ resultCode }) => {
+              if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+            },
+            (e: Error) => {
+              throw new VoicevoxJsError(e.message);
+            }
+          )
+        );
+      }), true
+    );
+  }
+
+  /**
+   * ユーザー辞書を破棄(_destruct_)する。
+   * @returns {Promise<void>}
+   */
+  delete(): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxUserDictは破棄されています");
+      this.#voicevoxBase[Core].voicevoxUserDictDeleteV0_16(this[Pointer]);
+      this[Deleted] = true;
+      resolve();
+    });
+  }
+}
+
+const Pull = Symbol("Pull");
+
+/**
+ * `VoicevoxSynthesizer#synthesisStream`の結果。ネイティブ側のリングバッファから読み出す
+ */
+class VoicevoxSynthesisStream extends Readable {
+  #core: VoicevoxCore;
+  #pointer: number;
+  #closed: boolean = false;
+  constructor(core: VoicevoxCore, pointer: number, highWaterMark: number) {
+    super({ highWaterMark });
+    this.#core = core;
+    this.#pointer = pointer;
+  }
+
+  _read(): void {
+    this[Pull]();
+  }
+
+  /**
+   * 読み出せるだけ`push`する。リングバッファが空の場合は、書き込まれたときにネイティブ側から再び呼ばれる
+   */
+  [Pull](): void {
+    if (this.#closed) return;
+    try {
+      while (true) {
+        const { result, ended, resultCode } = this.#core.voicevoxPcmStreamReadV0_16(this.#pointer, this.readableHighWaterMark);
+        if (ended) {
+          if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) this.destroy(new VoicevoxError(this.#core.voicevoxErrorResultToMessageV0_12(resultCode).result));
+          else this.push(null);
+          return;
+        }
+        if (result === null || !this.push(result)) return;
+      }
+    } catch (e) {
+      this.destroy(e as Error);
+    }
+  }
+
+  _destroy(error: Error | null, callback: (error?: Error | null) => void): void {
+    if (!this.#closed) {
+      this.#closed = true;
+      this.#core.voicevoxPcmStreamDeleteV0_16(this.#pointer);
+    }
+    callback(error);
+  }
+}
+
+/**
+ * ネイティブ側で保持するAudioQuery。
+ * モーラの値はネイティブ側に項目ごとの配列で置かれ、書き換えや`replaceMoraData`などではJSONに変換しない。
+ * JSONにするのは`VoicevoxSynthesizer#synthesisAudioQuery`で合成するときと、`toJson`を呼んだときだけ。
+ */
+class VoicevoxAudioQuery {
+  [Pointer]: number;
+  #voicevoxBase: Voicevox;
+  [Deleted]: boolean = false;
+  get deleted(): boolean {
+    return this[Deleted];
+  }
+  constructor(base: Voicevox, pointer: number) {
+    this.#voicevoxBase = base;
+    this[Pointer] = pointer;
+  }
+
+  /**
+   * AudioQueryのJSONを取得する。
+   * @returns {Promise<VoicevoxAudioQueryJson>}
+   */
+  toJson(): Promise<VoicevoxAudioQueryJson> {
+    return new Promise<VoicevoxAudioQueryJson>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      const { result } = this.#voicevoxBase[Core].voicevoxAudioQueryToJsonV0_16(this[Pointer]);
+      resolve(JSON.parse(result));
+    });
+  }
+
+  /**
+   * モーラを項目ごとの配列で取得する。
+   * モーラはアクセント句の順に並び、句読点のモーラ(`pause_mora`)はそのアクセント句の最後に置かれる。`setMoraPitch`などの`moraIndex`はこの並びでの位置。
+   * @returns {Promise<VoicevoxAudioQueryMoras>}
+   */
+  getMoras(): Promise<VoicevoxAudioQueryMoras> {
+    return new Promise<VoicevoxAudioQueryMoras>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      const { result } = this.#voicevoxBase[Core].voicevoxAudioQueryGetMorasV0_16(this[Pointer]);
+      resolve(result);
+    });
+  }
+
+  /**
+   * モーラの音高を設定する。
+   * @param {number} moraIndex モーラの位置
+   * @param {number} pitch 音高
+   * @returns {Promise<void>}
+   */
+  setMoraPitch(moraIndex: number, pitch: number): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      checkValidNumber(moraIndex, "moraIndex", true);
+      checkValidNumber(pitch, "pitch", false);
+      this.#voicevoxBase[Core].voicevoxAudioQuerySetMoraPitchV0_16(this[Pointer], moraIndex, pitch);
+      resolve();
+    });
+  }
+
+  /**
+   * モーラの長さを設定する。
+   * @param {number} moraIndex モーラの位置
+   * @param {number | null} consonantLength 子音の長さ。`null`なら変更しない。子音の無いモーラでは無視される
+   * @param {number | null} vowelLength 母音の長さ。`null`なら変更しない
+   * @returns {Promise<void>}
+   */
+  setMoraLength(moraIndex: number, consonantLength: number | null, vowelLength: number | null): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      checkValidNumber(moraIndex, "moraIndex", true);
+      if (consonantLength !== null) checkValidNumber(consonantLength, "consonantLength", false);
+      if (vowelLength !== null) checkValidNumber(vowelLength, "vowelLength", false);
+      this.#voicevoxBase[Core].voicevoxAudioQuerySetMoraLengthV0_16(this[Pointer], moraIndex, consonantLength ?? NaN, vowelLength ?? NaN);
+      resolve();
+    });
+  }
+
+  /**
+   * 全てのモーラの音高を設定する。
+   * @param {Float64Array | Array<number>} pitches モーラの数と同じ長さの音高
+   * @returns {Promise<void>}
+   */
+  setPitches(pitches: Float64Array | Array<number>): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      if (!(pitches instanceof Float64Array)) {
+        checkValidArray(pitches, "pitches", "number");
+        pitches = Float64Array.from(pitches);
+      }
+      this.#voicevoxBase[Core].voicevoxAudioQuerySetPitchesV0_16(this[Pointer], pitches);
+      resolve();
+    });
+  }
+
+  /**
+   * 話速・音高などの全体の値を設定する。指定しなかった値は変更しない。
+   * @param {Partial<VoicevoxAudioQueryScales>} scales 設定する値
+   * @returns {Promise<void>}
+   */
+  setScales(scales: Partial<VoicevoxAudioQueryScales>): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      if (typeof scales !== "object" || scales === null) throw new VoicevoxJsError("有効なVoicevoxAudioQueryScalesではありません");
+      const keys: Array<keyof VoicevoxAudioQueryScales> = ["speedScale", "pitchScale", "intonationScale", "volumeScale", "prePhonemeLength", "postPhonemeLength", "outputSamplingRate"];
+      for (const key of keys) {
+        const value = scales[key];
+        if (value !== undefined) checkValidNumber(value, key, key === "outputSamplingRate");
+      }
+      for (const key of keys) {
+        const value = scales[key];
+        if (value !== undefined) this.#voicevoxBase[Core].voicevoxAudioQuerySetScaleV0_16(this[Pointer], key, value);
+      }
+      resolve();
+    });
+  }
+
+  /**
+   * アクセント句の音高・音素長を、特定の声で生成しなおす。
+   * @param {VoicevoxSynthesizer} synthesizer シンセサイザ
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @returns {Promise<void>}
+   */
+  replaceMoraData(synthesizer: VoicevoxSynthesizer, styleId: VoicevoxStyleId): Promise<void> {
+    return this.#replace(synthesizer, styleId, AudioQueryReplaceKind.MORA_DATA);
+  }
+
+  /**
+   * アクセント句の音素長を、特定の声で生成しなおす。
+   * @param {VoicevoxSynthesizer} synthesizer シンセサイザ
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @returns {Promise<void>}
+   */
+  replacePhonemeLength(synthesizer: VoicevoxSynthesizer, styleId: VoicevoxStyleId): Promise<void> {
+    return this.#replace(synthesizer, styleId, AudioQueryReplaceKind.PHONEME_LENGTH);
+  }
+
+  /**
+   * アクセント句の音高を、特定の声で生成しなおす。
+   * @param {VoicevoxSynthesizer} synthesizer シンセサイザ
+   * @param {VoicevoxStyleId} styleId スタイルID
+   * @returns {Promise<void>}
+   */
+  replaceMoraPitch(synthesizer: VoicevoxSynthesizer, styleId: VoicevoxStyleId): Promise<void> {
+    return this.#replace(synthesizer, styleId, AudioQueryReplaceKind.MORA_PITCH);
+  }
+
+  /**
+   * `VoicevoxAudioQuery`を破棄(_destruct_)する。
+   * @returns {Promise<void>}
+   */
+  delete(): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      this.#voicevoxBase[Core].voicevoxAudioQueryDeleteV0_16(this[Pointer]);
+      this[Deleted] = true;
+      resolve();
+    });
+  }
+
+  #replace(synthesizer: VoicevoxSynthesizer, styleId: VoicevoxStyleId, kind: number): Promise<void> {
+    return new Promise<void>((resolve) => {
+      if (this[Deleted]) throw new VoicevoxJsError("VoicevoxAudioQueryは破棄されています");
+      checkValidObject(synthesizer, "synthesizer", VoicevoxSynthesizer, "VoicevoxSynthesizer");
+      if (synthesizer[Deleted]) throw new VoicevoxJsError("VoicevoxSynthesizerは破棄されています");
+      checkValidNumber(styleId, "styleId", true);
+      const { resultCode } = this.#voicevoxBase[Core].voicevoxSynthesizerAudioQueryReplaceV0_16(synthesizer[Pointer], this[Pointer], styleId, kind);
+      if (resultCode !== VoicevoxResultCodeV0_16.VOICEVOX_RESULT_OK) throw new VoicevoxError(this.#voicevoxBase[Core].voicevoxErrorResultToMessageV0_12(resultCode).result);
+      resolve();
+    });
+  }
+}
+
+class VoicevoxVoiceModel {
+  [Pointer]: number;
+  #voicevoxBase: Voicevox;
+  [Deleted]: boolean = false;
+  get deleted(): boolean {
+    return this[Deleted];
   }
   constructor(base: Voicevox, pointer: number) {
     this.#voicevoxBase = base;
@@ -664,6 +1799,7 @@ class VoicevoxVoiceModel {
     return new Promise<void>((resolve) => {
       if (this[Deleted]) throw new VoicevoxJsError("VoicevoxVoiceModelは破棄済みです");
       this.#voicevoxBase[Core].voicevoxVoiceModelDeleteV0_16(this[Pointer]);
+      this[Deleted] = true;
       resolve();
     });
   }
@@ -701,6 +1837,47 @@ function checkVoicevoxInitializeOptions(obj: VoicevoxInitializeOptions) {
   ]);
 }
 
+/**
+ * `VoicevoxAudioQuery#getMoras`の結果。添字はモーラの位置。
+ */
+interface VoicevoxAudioQueryMoras {
+  text: Array<string>;
+  consonant: Array<string | null>;
+  vowel: Array<string>;
+  /** 子音の無いモーラは`NaN` */
+  consonantLength: Float64Array;
+  vowelLength: Float64Array;
+  pitch: Float64Array;
+  /** 句読点のモーラなら1 */
+  isPause: Uint8Array;
+  /** アクセント句ごとの、そのアクセント句のモーラの終わり(句読点のモーラを含む) */
+  accentPhraseEnds: Uint32Array;
+  /** アクセント句ごとのアクセント位置 */
+  accent: Uint32Array;
+  /** アクセント句ごとの、疑問文かどうか(1なら疑問文) */
+  isInterrogative: Uint8Array;
+}
+
+/**
+ * `VoicevoxAudioQuery#setScales`で設定する値。
+ */
+interface VoicevoxAudioQueryScales {
+  /** 全体の話速 */
+  speedScale: number;
+  /** 全体の音高 */
+  pitchScale: number;
+  /** 全体の抑揚 */
+  intonationScale: number;
+  /** 全体の音量 */
+  volumeScale: number;
+  /** 音声の前の無音時間 */
+  prePhonemeLength: number;
+  /** 音声の後の無音時間 */
+  postPhonemeLength: number;
+  /** 音声データの出力サンプリングレート */
+  outputSamplingRate: number;
+}
+
 /**
  * `VoicevoxSynthesizer#synthesis`のオプション。
  */
@@ -709,10 +1886,88 @@ interface VoicevoxSynthesisOptions {
    * 疑問文の調整を有効にする
    */
   enableInterrogativeUpspeak: boolean;
+  /**
+   * 出力するWAVのサンプリングレート。省略するとモデルのまま(24000Hz)。`outputFormat`がG.711の場合は8000Hz。
+   * `VoicevoxSynthesizer#synthesisAudioQuery`・`synthesisToFile`・`synthesisToFd`でのみ使われ、変換はワーカースレッドで行う
+   */
+  outputSamplingRate?: number;
+  /**
+   * 出力形式。省略すると`"wav"`。
+   * `"mulaw"`・`"alaw"`ではヘッダの無いG.711のバイト列(モノラル)、`"pcm"`ではヘッダの無い16ビットリニアPCMを返す。`VoicevoxSynthesizer#synthesisAudioQuery`・`synthesisToFile`・`synthesisToFd`でのみ使われる
+   */
+  outputFormat?: VoicevoxOutputFormat;
+  /**
+   * ラウドネスの目標(LUFS、-70から0)。指定すると合成した音声のIntegrated Loudness(EBU R128)を測り、この値に揃える利得とピークリミッタ(-1dBFS)をかける。
+   * 省略すると正規化しない。測定と補正はワーカースレッドで行う(上げる利得は24dBまで)
+   */
+  targetLoudness?: number;
+  /**
+   * 後処理(無音の切り詰め・フェード・無音の追加)。合成した音声を返す前に、ワーカースレッドで出力形式の変換と同じ1回の走査で行う
+   */
+  postProcess?: VoicevoxPostProcessOptions;
+}
+
+/**
+ * 合成結果の形式。
+ * `"wav-stream"`は大きさの欄を長さ未定(0xFFFFFFFF)にしたヘッダのWAVで、全体の長さが決まる前に流し始める場合(chunkedのHTTPなど)に使う
+ */
+type VoicevoxOutputFormat = "wav" | "mulaw" | "alaw" | "pcm" | "wav-stream";
+
+/**
+ * 後処理のオプション。指定したものだけを、切り詰め→(`outputSamplingRate`の変換→`targetLoudness`の正規化)→フェード→無音の追加の順にかける。
+ * 長さ(ミリ秒)は0から60000まで。
+ */
+interface VoicevoxPostProcessOptions {
+  /**
+   * 前後の、全チャンネルが`thresholdDb`(dBFS、-96から0。省略すると-50)以下の区間を切り詰める。`marginMs`(省略すると0)だけは残す
+   */
+  trim?: { thresholdDb?: number; marginMs?: number };
+  /**
+   * 音声の先頭に線形のフェードインをかける長さ(無音の追加の前にかけるため、足した無音は含まない)
+   */
+  fadeInMs?: number;
+  /**
+   * 音声の末尾に線形のフェードアウトをかける長さ(無音の追加の前にかけるため、足した無音は含まない)
+   */
+  fadeOutMs?: number;
+  /**
+   * 前に足す無音の長さ
+   */
+  padStartMs?: number;
+  /**
+   * 後ろに足す無音の長さ
+   */
+  padEndMs?: number;
+}
+
+function checkPostProcessOptions(obj: VoicevoxPostProcessOptions, interfaceName: string) {
+  if (typeof obj !== "object" || obj === null || Array.isArray(obj)) throw new VoicevoxJsError(`有効な${interfaceName}ではありません(postProcessがオブジェクトでない)`);
+  const inRange = (value: unknown, min: number, max: number) => value === undefined || (typeof value === "number" && value >= min && value <= max);
+  if (obj.trim !== undefined) {
+    if (typeof obj.trim !== "object" || obj.trim === null || !inRange(obj.trim.thresholdDb, -96, 0) || !inRange(obj.trim.marginMs, 0, 60000))
+      throw new VoicevoxJsError(`有効な${interfaceName}ではありません(postProcess.trimの値が範囲にない)`);
+  }
+  for (const key of ["fadeInMs", "fadeOutMs", "padStartMs", "padEndMs"] as const) {
+    if (!inRange(obj[key], 0, 60000)) throw new VoicevoxJsError(`有効な${interfaceName}ではありません(postProcess.${key}が0から60000の範囲にない)`);
+  }
+}
+
+function checkAudioOutputOptions(
+  obj: { outputSamplingRate?: number; outputFormat?: VoicevoxOutputFormat; targetLoudness?: number; postProcess?: VoicevoxPostProcessOptions },
+  interfaceName: string
+) {
+  if (obj.outputSamplingRate !== undefined && (!Number.isSafeInteger(obj.outputSamplingRate) || obj.outputSamplingRate <= 0))
+    throw new VoicevoxJsError(`有効な${interfaceName}ではありません(outputSamplingRateが正の整数でない)`);
+  if (obj.outputFormat !== undefined && !Object.prototype.hasOwnProperty.call(OutputFormat, obj.outputFormat))
+    throw new VoicevoxJsError(`有効な${interfaceName}ではありません(outputFormatがwav, mulaw, alaw, pcm, wav-streamのいずれでもない)`);
+  if (obj.targetLoudness !== undefined && (typeof obj.targetLoudness !== "number" || !(obj.targetLoudness >= -70 && obj.targetLoudness <= 0)))
+    throw new VoicevoxJsError(`有効な${interfaceName}ではありません(targetLoudnessが-70から0の範囲にない)`);
+  if (obj.postProcess !== undefined) checkPostProcessOptions(obj.postProcess, interfaceName);
 }
 
 function checkVoicevoxSynthesisOptions(obj: VoicevoxSynthesisOptions) {
   checkValidOption(obj, "VoicevoxSynthesisOptions", [["enableInterrogativeUpspeak", "boolean"]]);
+  checkAudioOutputOptions(obj, "VoicevoxSynthesisOptions");
 }
 
 /**
@@ -723,10 +1978,182 @@ interface VoicevoxTtsOptions {
    * 疑問文の調整を有効にする
    */
   enableInterrogativeUpspeak: boolean;
+  /**
+   * 出力するWAVのサンプリングレート。省略するとモデルのまま(24000Hz)。`outputFormat`がG.711の場合は8000Hz。
+   * `VoicevoxSynthesizer#tts`でのみ使われ、変換はワーカースレッドで行う
+   */
+  outputSamplingRate?: number;
+  /**
+   * 出力形式。省略すると`"wav"`。
+   * `"mulaw"`・`"alaw"`ではヘッダの無いG.711のバイト列(モノラル)、`"pcm"`ではヘッダの無い16ビットリニアPCMを返す。`VoicevoxSynthesizer#tts`でのみ使われる
+   */
+  outputFormat?: VoicevoxOutputFormat;
+  /**
+   * ラウドネスの目標(LUFS、-70から0)。指定すると合成した音声のIntegrated Loudness(EBU R128)を測り、この値に揃える利得とピークリミッタ(-1dBFS)をかける。
+   * 省略すると正規化しない。測定と補正はワーカースレッドで行う(上げる利得は24dBまで)
+   */
+  targetLoudness?: number;
+  /**
+   * 後処理(無音の切り詰め・フェード・無音の追加)。合成した音声を返す前に、ワーカースレッドで出力形式の変換と同じ1回の走査で行う
+   */
+  postProcess?: VoicevoxPostProcessOptions;
 }
 
 function checkVoicevoxTtsOptions(obj: VoicevoxTtsOptions) {
   checkValidOption(obj, "VoicevoxTtsOptions", [["enableInterrogativeUpspeak", "boolean"]]);
+  checkAudioOutputOptions(obj, "VoicevoxTtsOptions");
+}
+
+/**
+ * `VoicevoxSynthesizer#synthesisFrames`のオプション。
+ */
+interface VoicevoxFrameOptions {
+  /**
+   * 疑問文の調整を有効にする
+   */
+  enableInterrogativeUpspeak: boolean;
+  /**
+   * 1フレームの長さ(ミリ秒)。サンプリングレートとの積が1000の倍数になること
+   */
+  frameMs: number;
+  /**
+   * 1回のコールバックで渡すフレームの数
+   */
+  framesPerBatch: number;
+  /**
+   * 実時間で送出する。各バッチは、その最初のフレームの再生時刻になってから渡される
+   */
+  pace: boolean;
+  /**
+   * サンプリングレート。省略するとモデルのまま(24000Hz)。`outputFormat`がG.711の場合は8000Hz
+   */
+  outputSamplingRate?: number;
+  /**
+   * フレームの形式。省略すると`"pcm"`(ヘッダの無い16ビットリニアPCM)。`"wav"`・`"wav-stream"`は使えない
+   */
+  outputFormat?: Exclude<VoicevoxOutputFormat, "wav" | "wav-stream">;
+  /**
+   * ラウドネスの目標(LUFS、-70から0)。指定すると合成した音声のIntegrated Loudness(EBU R128)を測り、この値に揃える利得とピークリミッタ(-1dBFS)をかける。
+   * 省略すると正規化しない。測定と補正はワーカースレッドで行う(上げる利得は24dBまで)
+   */
+  targetLoudness?: number;
+  /**
+   * 後処理(無音の切り詰め・フェード・無音の追加)。合成した音声を返す前に、ワーカースレッドで出力形式の変換と同じ1回の走査で行う
+   */
+  postProcess?: VoicevoxPostProcessOptions;
+}
+
+function checkVoicevoxFrameOptions(obj: VoicevoxFrameOptions) {
+  checkValidOption(obj, "VoicevoxFrameOptions", [
+    ["enableInterrogativeUpspeak", "boolean"],
+    ["frameMs", "number", true],
+    ["framesPerBatch", "number", true],
+    ["pace", "boolean"],
+  ]);
+  checkAudioOutputOptions(obj, "VoicevoxFrameOptions");
+  const outputFormat = obj.outputFormat as VoicevoxOutputFormat | undefined;
+  if (outputFormat === "wav" || outputFormat === "wav-stream") throw new VoicevoxJsError("有効なVoicevoxFrameOptionsではありません(outputFormatにwav, wav-streamは使えない)");
+  if (obj.frameMs <= 0 || obj.frameMs > 1000) throw new VoicevoxJsError("有効なVoicevoxFrameOptionsではありません(frameMsが1から1000の範囲にない)");
+  if (obj.framesPerBatch <= 0) throw new VoicevoxJsError("有効なVoicevoxFrameOptionsではありません(framesPerBatchが正の値でない)");
+}
+
+/**
+ * `VoicevoxSynthesizer#synthesisStream`のオプション。
+ */
+interface VoicevoxStreamOptions {
+  /**
+   * 疑問文の調整を有効にする
+   */
+  enableInterrogativeUpspeak: boolean;
+  /**
+   * サンプリングレート。省略するとモデルのまま(24000Hz)。`outputFormat`がG.711の場合は8000Hz
+   */
+  outputSamplingRate?: number;
+  /**
+   * 形式。省略すると`"pcm"`(ヘッダの無い16ビットリニアPCM)。`"wav"`では最初にヘッダ(全体の長さ入り)を流す。
+   * `"wav-stream"`ではヘッダ(長さ未定)をPCMの先頭と同じチャンクで流すため、受け取った側は最初のチャンクから再生を始められる
+   */
+  outputFormat?: VoicevoxOutputFormat;
+  /**
+   * ネイティブ側のリングバッファの容量(バイト)。2のべき乗に切り上げる。省略すると64KiB、4096未満は不可
+   */
+  ringBytes?: number;
+  /**
+   * Readableの`highWaterMark`(バイト)。省略すると16KiB
+   */
+  highWaterMark?: number;
+  /**
+   * ラウドネスの目標(LUFS、-70から0)。指定すると合成した音声のIntegrated Loudness(EBU R128)を測り、この値に揃える利得とピークリミッタ(-1dBFS)をかける。
+   * 省略すると正規化しない。測定と補正はワーカースレッドで行う(上げる利得は24dBまで)
+   */
+  targetLoudness?: number;
+  /**
+   * 後処理(無音の切り詰め・フェード・無音の追加)。合成した音声を返す前に、ワーカースレッドで出力形式の変換と同じ1回の走査で行う
+   */
+  postProcess?: VoicevoxPostProcessOptions;
+}
+
+function checkVoicevoxStreamOptions(obj: VoicevoxStreamOptions) {
+  checkValidOption(obj, "VoicevoxStreamOptions", [["enableInterrogativeUpspeak", "boolean"]]);
+  checkAudioOutputOptions(obj, "VoicevoxStreamOptions");
+  if (obj.ringBytes !== undefined && (!Number.isSafeInteger(obj.ringBytes) || obj.ringBytes < 4096 || obj.ringBytes > 0x40000000))
+    throw new VoicevoxJsError("有効なVoicevoxStreamOptionsではありません(ringBytesが4096から2^30の範囲にない)");
+  if (obj.highWaterMark !== undefined && (!Number.isSafeInteger(obj.highWaterMark) || obj.highWaterMark <= 0))
+    throw new VoicevoxJsError("有効なVoicevoxStreamOptionsではありません(highWaterMarkが正の整数でない)");
+}
+
+/**
+ * `VoicevoxSynthesizer#synthesisToFile`のオプション。
+ */
+interface VoicevoxFileOptions extends VoicevoxSynthesisOptions {
+  /**
+   * `outputFormat`が`"wav-stream"`の場合に、書き終えてからヘッダの大きさの欄を本当の値に書き換える。省略すると`false`。
+   * `synthesisToFd`ではシークできるディスクリプタ(追記モード以外のファイル)でのみ使える
+   */
+  patchWavHeader?: boolean;
+}
+
+function checkVoicevoxFileOptions(obj: VoicevoxFileOptions, interfaceName = "VoicevoxFileOptions") {
+  checkValidOption(obj, interfaceName, [["enableInterrogativeUpspeak", "boolean"]]);
+  checkAudioOutputOptions(obj, interfaceName);
+  if (obj.patchWavHeader !== undefined && typeof obj.patchWavHeader !== "boolean")
+    throw new VoicevoxJsError(`有効な${interfaceName}ではありません(patchWavHeaderがbooleanでない)`);
+}
+
+/**
+ * `VoicevoxSynthesizer#synthesisToFd`のオプション。
+ */
+interface VoicevoxFdOptions extends VoicevoxFileOptions {
+  /**
+   * 書き込めるようになるまで待つ時間の上限(ミリ秒)。省略すると無制限。相手が読まなくなった接続で待ち続けないために指定する
+   */
+  timeoutMs?: number;
+}
+
+function checkVoicevoxFdOptions(obj: VoicevoxFdOptions) {
+  checkVoicevoxFileOptions(obj, "VoicevoxFdOptions");
+  if (obj.timeoutMs !== undefined && (!Number.isSafeInteger(obj.timeoutMs) || obj.timeoutMs < 0 || obj.timeoutMs > 0x7fffffff))
+    throw new VoicevoxJsError("有効なVoicevoxFdOptionsではありません(timeoutMsが0から2^31-1の範囲にない)");
+}
+
+/**
+ * `VoicevoxSynthesizer#synthesisToFile`・`synthesisToFd`の結果。
+ */
+interface VoicevoxFileResult {
+  /** 書き込んだバイト数 */
+  bytes: number;
+  /** 音声の長さ(ミリ秒) */
+  durationMs: number;
+}
+
+/**
+ * `VoicevoxSynthesizer#synthesisFrames`の結果。
+ */
+interface VoicevoxFrameStreamResult {
+  /** 渡したフレームの数 */
+  frames: number;
+  /** コールバックが`false`を返して中止したかどうか */
+  cancelled: boolean;
 }
 
 /**
@@ -758,6 +2185,58 @@ interface VoicevoxUserDictWord {
   priority: number;
 }
 
+/**
+ * `VoicevoxUserDict#addWords`に渡す単語の一覧。各項目は`VoicevoxUserDictWord`の同名の項目を単語の数だけ並べたもの
+ */
+interface VoicevoxUserDictWords {
+  surface: Array<string>;
+  pronunciation: Array<string>;
+  accentType: Array<number> | Uint32Array;
+  wordType: Array<VoicevoxUserDictWordType> | Uint32Array;
+  priority: Array<number> | Uint32Array;
+}
+
+function toUint32Array(arr: Array<number> | Uint32Array, name: string): Uint32Array {
+  if (arr instanceof Uint32Array) return arr;
+  checkValidArray(arr, name, "number", true);
+  return Uint32Array.from(arr);
+}
+
+/**
+ * `VoicevoxUserDict#findWords`などで見つかった単語。表記は全角に変換済み
+ */
+interface VoicevoxUserDictFoundWord extends VoicevoxUserDictWord {
+  /**
+   * 単語のUUID
+   */
+  uuid: string;
+}
+
+function toFoundWord(word: { uuid: Buffer; surface: string; pronunciation: string; accentType: number; wordType: number; priority: number }): VoicevoxUserDictFoundWord {
+  return {
+    uuid: bufferToUuid(word.uuid),
+    surface: word.surface,
+    pronunciation: word.pronunciation,
+    accentType: word.accentType,
+    wordType: word.wordType,
+    priority: word.priority,
+  };
+}
+
+/**
+ * `VoicevoxUserDict#loadSnapshot`の結果。i番目の単語のUUIDはそれぞれ`subarray(i * 16, i * 16 + 16)`
+ */
+interface VoicevoxUserDictSnapshotLoadResult {
+  /**
+   * 追加した単語のUUID(16バイト×単語数)
+   */
+  wordUuids: Buffer;
+  /**
+   * 追加した単語の、スナップショットでのUUID(同じ順)
+   */
+  snapshotWordUuids: Buffer;
+}
+
 function checkVoicevoxUserDictWord(obj: VoicevoxUserDictWord) {
   checkValidOption(obj, "VoicevoxUserDictWord", [
     ["accentType", "number", true],
@@ -768,6 +2247,109 @@ function checkVoicevoxUserDictWord(obj: VoicevoxUserDictWord) {
   ]);
 }
 
+/**
+ * `Voicevox#captureStop`の結果。
+ */
+interface VoicevoxCaptureStats {
+  /**
+   * 記録した件数
+   */
+  recorded: number;
+  /**
+   * 書き込み待ちが上限を超えたため捨てた件数
+   */
+  dropped: number;
+  /**
+   * 書き込んだバイト数(ヘッダを含む)
+   */
+  writtenBytes: number;
+}
+
+/**
+ * `Voicevox#getStats`の結果。
+ */
+interface VoicevoxStats {
+  /**
+   * `Voicevox#perfCountersEnable`で有効にした計測の集計
+   */
+  perf: {
+    enabled: boolean;
+    /**
+     * バインディング毎の集計。`counterCalls`はハードウェアカウンタを計測できた呼び出しの数で、`cycles`などはその合計
+     */
+    bindings: {
+      [binding: string]: { calls: number; counterCalls: number; wallNs: number; cycles: number; instructions: number; cacheMisses: number; contextSwitches: number };
+    };
+  };
+  /**
+   * `Voicevox#accentPhraseCacheSetCapacity`で設定したテキスト解析の結果の保持
+   */
+  accentPhraseCache: VoicevoxCacheStats;
+  /**
+   * `Voicevox#kanaCacheSetCapacity`で設定したAquesTalk風記法の記録。
+   * `savedNs`は、記録したときのテキストからのAudioQueryの作成時間と、AquesTalk風記法からの作成時間の差の合計(省けたテキスト解析の時間の見積もり)
+   */
+  kanaCache: VoicevoxCacheStats & { savedNs: number };
+  /**
+   * `Voicevox#bufferPoolSetCapacity`で設定した合成結果のBufferの領域の使い回し
+   */
+  bufferPool: VoicevoxBufferPoolStats;
+}
+
+/**
+ * 合成結果のBufferの領域の使い回しの統計。命中率は`hits / (hits + misses)`
+ */
+interface VoicevoxBufferPoolStats {
+  /** 戻った領域を保持するバイト数の上限 */
+  capacity: number;
+  /** 戻って保持している領域のバイト数と数 */
+  idleBytes: number;
+  idleSlabs: number;
+  /** Bufferとして渡している領域のバイト数と数 */
+  outstandingBytes: number;
+  outstandingSlabs: number;
+  /** 戻った領域を使えた数 */
+  hits: number;
+  /** 新しく確保した数 */
+  misses: number;
+  /** 2MiBを超えるため使い回さなかった数 */
+  oversize: number;
+  /** `Voicevox#releaseBuffer`で手放された数 */
+  released: number;
+}
+
+/**
+ * キャッシュの統計。
+ */
+interface VoicevoxCacheStats {
+  /** 保持する件数の上限 */
+  capacity: number;
+  /** 保持している件数 */
+  entries: number;
+  hits: number;
+  misses: number;
+  /** 上限を超えたために捨てた件数 */
+  evictions: number;
+}
+
+/**
+ * `VoicevoxTenantPool#getStats`の結果。
+ */
+interface VoicevoxTenantPoolStats {
+  /** シンセサイザの最大数 */
+  capacity: number;
+  /** 作成済み(作成中を含む)のシンセサイザの数 */
+  size: number;
+  /** 登録されているテナントの数 */
+  tenants: number;
+  /** 割り当て済みのシンセサイザをそのまま使えた回数 */
+  hits: number;
+  /** シンセサイザの作成・ユーザー辞書の設定が必要だった回数 */
+  misses: number;
+  /** 他のテナントのシンセサイザを使い回した回数 */
+  evictions: number;
+}
+
 interface VoicevoxUserDictsJson {
   [key: string]: VoicevoxUserDictJson;
 }
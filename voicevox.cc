@@ -1,11 +1,33 @@
 #include "voicevox.h"
 #include <napi.h>
 #include "voicevox_core.h"
+#include "capture.h"
+#include "perf_counters.h"
+#include "async_job.h"
+#include "atomic_file.h"
+#include "user_dict_snapshot.h"
+#include "audio_query.h"
+#include "audio_output.h"
+#include "fd_output.h"
+#include "frame_stream.h"
+#include "resampler.h"
+#include "wav.h"
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
 
 #ifdef _WIN32
 #include <windows.h>
-void load(char *path)
+void load(const char *path)
 {
 	SetDllDirectoryA(path);
 	return;
@@ -14,12 +36,9 @@ void load(char *path)
 
 using namespace Napi;
 
-const char *load_string(const Napi::CallbackInfo &info, size_t index)
+std::string load_string(const Napi::CallbackInfo &info, size_t index)
 {
-	std::string text = info[index].As<Napi::String>().Utf8Value() + "\0";
-	char *cstr = new char[text.size() + 1];
-	std::char_traits<char>::copy(cstr, text.c_str(), text.size() + 1);
-	return const_cast<const char *>(cstr);
+	return info[index].As<Napi::String>().Utf8Value();
 }
 
 uint32_t load_uint32_t(const Napi::CallbackInfo &info, size_t index)
@@ -32,6 +51,320 @@ bool load_bool(const Napi::CallbackInfo &info, size_t index)
 	return info[index].As<Napi::Boolean>().Value();
 }
 
+void set_perf_reading(Napi::Env env, Napi::Object &obj, const PerfReading &reading)
+{
+	Napi::Object perf = Napi::Object::New(env);
+	perf.Set("counters", Napi::Boolean::New(env, reading.counters));
+	perf.Set("wallNs", Napi::Number::New(env, static_cast<double>(reading.wall_ns)));
+	perf.Set("cycles", Napi::Number::New(env, static_cast<double>(reading.cycles)));
+	perf.Set("instructions", Napi::Number::New(env, static_cast<double>(reading.instructions)));
+	perf.Set("cacheMisses", Napi::Number::New(env, static_cast<double>(reading.cache_misses)));
+	perf.Set("contextSwitches", Napi::Number::New(env, static_cast<double>(reading.context_switches)));
+	obj.Set("perf", perf);
+}
+
+void set_perf(Napi::Env env, Napi::Object &obj, PerfScope &perf_scope, const char *name)
+{
+	PerfReading reading;
+	if (perf_scope.finish(name, reading))
+		set_perf_reading(env, obj, reading);
+}
+
+/**
+ * 非同期ジョブが使用中のポインタを数える(メインスレッドからのみ触る)
+ */
+void acquire_in_flight(std::unordered_map<uint32_t, uint32_t> &in_flight, uint32_t pointer_name)
+{
+	in_flight[pointer_name]++;
+}
+
+void release_in_flight(std::unordered_map<uint32_t, uint32_t> &in_flight, uint32_t pointer_name)
+{
+	auto it = in_flight.find(pointer_name);
+	if (it != in_flight.end() && --it->second == 0)
+		in_flight.erase(it);
+}
+
+/**
+ * ユーザー辞書に単語をまとめて追加する(ワーカースレッドから呼んでよい)
+ *
+ * 途中で失敗した場合は追加済みの単語を取り除き、辞書を呼び出し前の状態に戻す。
+ * @param make_word `(i, word)`でi番目の単語を作る
+ * @param uuids `count`個分の領域。追加した単語のUUIDを書き込む
+ * @param failed_index 失敗した単語の位置
+ */
+template <class F>
+VoicevoxResultCode add_user_dict_words(DLL &dll, const VoicevoxUserDict *user_dict, size_t count, F make_word, uint8_t (*uuids)[16], size_t &failed_index)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		VoicevoxUserDictWord word;
+		make_word(i, word);
+		VoicevoxResultCode result_code = voicevox_user_dict_add_word_v0_16(dll, user_dict, &word, &uuids[i]);
+		if (result_code != VOICEVOX_RESULT_OK)
+		{
+			failed_index = i;
+			for (size_t j = 0; j < i; j++)
+			{
+				voicevox_user_dict_remove_word_v0_16(dll, user_dict, &uuids[j]);
+			}
+			return result_code;
+		}
+	}
+	return VOICEVOX_RESULT_OK;
+}
+
+Napi::Object user_dict_index_word_to_object(Napi::Env env, const UserDictIndexWord &word)
+{
+	Napi::Object obj = Napi::Object::New(env);
+	obj.Set("uuid", Napi::Buffer<uint8_t>::Copy(env, reinterpret_cast<const uint8_t *>(word.uuid.data()), word.uuid.size()));
+	obj.Set("surface", Napi::String::New(env, word.surface));
+	obj.Set("pronunciation", Napi::String::New(env, word.pronunciation));
+	obj.Set("accentType", Napi::Number::New(env, word.accent_type));
+	obj.Set("wordType", Napi::Number::New(env, word.word_type));
+	obj.Set("priority", Napi::Number::New(env, word.priority));
+	return obj;
+}
+
+Napi::Array user_dict_index_words_to_array(Napi::Env env, const std::vector<const UserDictIndexWord *> &words)
+{
+	Napi::Array array = Napi::Array::New(env, words.size());
+	for (uint32_t i = 0; i < words.size(); i++)
+	{
+		array.Set(i, user_dict_index_word_to_object(env, *words[i]));
+	}
+	return array;
+}
+
+/**
+ * `{"accent_phrases":[...],...}`の形のAudioQueryのJSONを、アクセント句の配列とそれより後ろに分ける
+ * @return `accent_phrases`が先頭のメンバーでない場合は`false`
+ */
+bool split_audio_query_json(const char *json, std::string &accent_phrases, std::string &rest)
+{
+	static const char prefix[] = "{\"accent_phrases\":";
+	if (std::strncmp(json, prefix, sizeof(prefix) - 1) != 0)
+		return false;
+	const char *begin = json + sizeof(prefix) - 1;
+	if (*begin != '[')
+		return false;
+	// 文字列の中の括弧を数えないようにしながら、対応する`]`を探す
+	int depth = 0;
+	bool in_string = false;
+	for (const char *p = begin; *p != '\0'; p++)
+	{
+		if (in_string)
+		{
+			if (*p == '\\' && p[1] != '\0')
+				p++;
+			else if (*p == '"')
+				in_string = false;
+			continue;
+		}
+		if (*p == '"')
+			in_string = true;
+		else if (*p == '[' || *p == '{')
+			depth++;
+		else if ((*p == ']' || *p == '}') && --depth == 0)
+		{
+			accent_phrases.assign(begin, p + 1);
+			rest.assign(p + 1);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * AudioQueryのJSONの`accent_phrases`より後ろ(::split_audio_query_json の`rest`)から`kana`の値を取り出す
+ * @return `kana`が無い、または`\"`, `\\`, `\/`以外のエスケープを含む場合は`false`
+ */
+bool extract_audio_query_kana(const std::string &rest, std::string &kana)
+{
+	static const char key[] = "\"kana\":\"";
+	size_t begin = rest.find(key);
+	if (begin == std::string::npos)
+		return false;
+	kana.clear();
+	for (size_t i = begin + sizeof(key) - 1; i < rest.size(); i++)
+	{
+		char c = rest[i];
+		if (c == '"')
+			return true;
+		if (c == '\\')
+		{
+			if (i + 1 >= rest.size() || (rest[i + 1] != '"' && rest[i + 1] != '\\' && rest[i + 1] != '/'))
+				return false;
+			c = rest[++i];
+		}
+		kana += c;
+	}
+	return false;
+}
+
+/**
+ * 記録済みのAquesTalk風記法から音声合成を行う(`voicevox_synthesizer_tts_from_kana`と同じ処理を、AudioQueryの作成にかかった時間を計りながら行う)。ワーカースレッドから呼んでよい
+ * @param kana_query_ns AudioQueryの作成にかかった時間
+ */
+VoicevoxResultCode tts_from_cached_kana(DLL &dll, const VoicevoxSynthesizer *synthesizer, const std::string &kana, VoicevoxStyleId style_id, const VoicevoxTtsOptions &options, uintptr_t *output_wav_length, uint8_t **output_wav, uint64_t &kana_query_ns)
+{
+	char *audio_query_json = nullptr;
+	uint64_t start_ns = Capture::now();
+	VoicevoxResultCode result_code = voicevox_synthesizer_create_audio_query_from_kana_v0_16(dll, synthesizer, kana.c_str(), style_id, &audio_query_json);
+	kana_query_ns = Capture::now() - start_ns;
+	if (result_code != VOICEVOX_RESULT_OK)
+		return result_code;
+	VoicevoxSynthesisOptions synthesis_options = voicevox_make_default_synthesis_options_v0_14(dll);
+	synthesis_options.enable_interrogative_upspeak = options.enable_interrogative_upspeak;
+	result_code = voicevox_synthesizer_synthesis_v0_16(dll, synthesizer, audio_query_json, style_id, synthesis_options, output_wav_length, output_wav);
+	voicevox_json_free_v0_16(dll, audio_query_json);
+	return result_code;
+}
+
+/**
+ * 合成したWAVを`spec`の形式に変換し、voicevox_coreが確保した領域は解放する。ワーカースレッドから呼んでよい
+ * @param spec `passthrough()`なら何もしない
+ * @param encoded 変換後のバイト列。変換した場合は`output_wav`が`nullptr`になる
+ * @param encoded_format `nullptr`でなければ`encoded`の形式を設定する
+ * @param in_place 長さが増えない変換なら`output_wav`自身に書き戻し、`output_wav_length`だけを変える(`encoded`は空のまま)
+ */
+void encode_output_wav(DLL &dll, const AudioOutputSpec &spec, uint8_t *&output_wav, uintptr_t &output_wav_length, std::vector<uint8_t> &encoded, WavFormat *encoded_format = nullptr, bool in_place = true)
+{
+	if (spec.passthrough() || output_wav == nullptr)
+		return;
+	std::string error;
+	bool encoded_ok;
+	if (in_place)
+	{
+		size_t size = output_wav_length;
+		bool written_in_place = false;
+		encoded_ok = encode_audio_output_in_place(output_wav, size, spec, written_in_place, encoded, error, encoded_format);
+		if (encoded_ok && written_in_place)
+		{
+			output_wav_length = size;
+			return;
+		}
+	}
+	else
+		encoded_ok = encode_audio_output(output_wav, output_wav_length, spec, encoded, error, encoded_format);
+	voicevox_wav_free_v0_12(dll, output_wav);
+	output_wav = nullptr;
+	output_wav_length = 0;
+	if (!encoded_ok)
+		throw std::runtime_error(error);
+}
+
+/**
+ * 非同期の合成で、`index`番目のサンプリングレートと`index + 1`番目の出力形式を読む(省略時は0)
+ * @return 範囲外の場合は例外を設定して`false`を返す
+ */
+bool load_audio_output_spec(const Napi::CallbackInfo &info, size_t index, AudioOutputSpec &spec)
+{
+	if (info.Length() > index && info[index].IsNumber())
+		spec.sample_rate = load_uint32_t(info, index);
+	if (info.Length() > index + 1 && info[index + 1].IsNumber())
+		spec.format = load_uint32_t(info, index + 1);
+	if (spec.sample_rate > RESAMPLER_MAX_RATE)
+	{
+		Napi::Error::New(info.Env(), "サンプリングレートが大きすぎます").ThrowAsJavaScriptException();
+		return false;
+	}
+	if (spec.format > AUDIO_OUTPUT_WAV_STREAM)
+	{
+		Napi::Error::New(info.Env(), "対応していない出力形式です").ThrowAsJavaScriptException();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * 非同期の合成で、`index`番目の目標のラウドネス(LUFS)を読む。省略時は正規化しない
+ * @return 範囲外の場合は例外を設定して`false`を返す
+ */
+bool load_audio_output_loudness(const Napi::CallbackInfo &info, size_t index, AudioOutputSpec &spec)
+{
+	if (info.Length() <= index || !info[index].IsNumber())
+		return true;
+	double target = info[index].As<Napi::Number>().DoubleValue();
+	if (!(target >= LOUDNESS_MIN_TARGET && target <= LOUDNESS_MAX_TARGET))
+	{
+		Napi::Error::New(info.Env(), "目標のラウドネスが範囲外です").ThrowAsJavaScriptException();
+		return false;
+	}
+	spec.normalize = true;
+	spec.target_loudness = target;
+	return true;
+}
+
+/**
+ * 後処理のオプションの`key`の値を読む。省略時は`fallback`
+ * @return 数値でないか`[min, max]`の範囲外の場合は`false`
+ */
+bool load_post_process_number(const Napi::Object &options, const char *key, double min, double max, double fallback, double &value)
+{
+	Napi::Value raw = options.Get(key);
+	if (raw.IsUndefined())
+	{
+		value = fallback;
+		return true;
+	}
+	if (!raw.IsNumber())
+		return false;
+	value = raw.As<Napi::Number>().DoubleValue();
+	return value >= min && value <= max;
+}
+
+/**
+ * 非同期の合成で、`index`番目の後処理のオプション(`{ trim, fadeInMs, fadeOutMs, padStartMs, padEndMs }`)を読む。省略時は後処理をしない。
+ * 切り詰め→(サンプリングレートの変換→正規化)→フェード→無音の追加の順にかかる
+ * @return 不正な場合は例外を設定して`false`を返す
+ */
+bool load_audio_post_process(const Napi::CallbackInfo &info, size_t index, AudioOutputSpec &spec)
+{
+	if (info.Length() <= index || info[index].IsUndefined() || info[index].IsNull())
+		return true;
+	Napi::Env env = info.Env();
+	if (!info[index].IsObject() || info[index].IsArray())
+	{
+		Napi::Error::New(env, "後処理のオプションがオブジェクトではありません").ThrowAsJavaScriptException();
+		return false;
+	}
+	Napi::Object options = info[index].As<Napi::Object>();
+	Napi::Value trim = options.Get("trim");
+	if (!trim.IsUndefined())
+	{
+		double threshold_db = 0.0;
+		double margin_ms = 0.0;
+		if (!trim.IsObject() ||
+				!load_post_process_number(trim.As<Napi::Object>(), "thresholdDb", -96, 0, spec.trim_threshold_db, threshold_db) ||
+				!load_post_process_number(trim.As<Napi::Object>(), "marginMs", 0, AUDIO_OUTPUT_MAX_POST_MS, 0, margin_ms))
+		{
+			Napi::Error::New(env, "後処理の値が不正です: trim").ThrowAsJavaScriptException();
+			return false;
+		}
+		spec.trim = true;
+		spec.trim_threshold_db = threshold_db;
+		spec.trim_margin_ms = static_cast<uint32_t>(margin_ms);
+	}
+	const std::pair<const char *, uint32_t *> lengths[] = {
+			{"fadeInMs", &spec.fade_in_ms},
+			{"fadeOutMs", &spec.fade_out_ms},
+			{"padStartMs", &spec.pad_start_ms},
+			{"padEndMs", &spec.pad_end_ms},
+	};
+	for (const auto &length : lengths)
+	{
+		double ms = 0.0;
+		if (!load_post_process_number(options, length.first, 0, AUDIO_OUTPUT_MAX_POST_MS, 0, ms))
+		{
+			Napi::Error::New(env, std::string("後処理の値が不正です: ") + length.first).ThrowAsJavaScriptException();
+			return false;
+		}
+		*length.second = static_cast<uint32_t>(ms);
+	}
+	return true;
+}
+
 std::string copy_str(const char *str)
 {
 	std::string r("");
@@ -55,6 +388,8 @@ Napi::Object Voicevox::Init(Napi::Env env, Napi::Object exports)
 	Napi::Function func = DefineClass(env, "Voicevox", {
 																												 InstanceMethod("voicevoxOpenJtalkRcNewV0_16", &Voicevox::voicevoxOpenJtalkRcNewV0_16),
 																												 InstanceMethod("voicevoxOpenJtalkRcUseUserDictV0_16", &Voicevox::voicevoxOpenJtalkRcUseUserDictV0_16),
+																												 InstanceMethod("voicevoxOpenJtalkRcNewAsyncV0_16", &Voicevox::voicevoxOpenJtalkRcNewAsyncV0_16),
+																												 InstanceMethod("voicevoxOpenJtalkRcUseUserDictAsyncV0_16", &Voicevox::voicevoxOpenJtalkRcUseUserDictAsyncV0_16),
 																												 InstanceMethod("voicevoxOpenJtalkRcDeleteV0_16", &Voicevox::voicevoxOpenJtalkRcDeleteV0_16),
 																												 InstanceMethod("voicevoxGetVersionV0_14", &Voicevox::voicevoxGetVersionV0_14),
 																												 InstanceMethod("voicevoxVoiceModelNewFromPathV0_16", &Voicevox::voicevoxVoiceModelNewFromPathV0_16),
@@ -63,6 +398,7 @@ Napi::Object Voicevox::Init(Napi::Env env, Napi::Object exports)
 																												 InstanceMethod("voicevoxVoiceModelDeleteV0_16", &Voicevox::voicevoxVoiceModelDeleteV0_16),
 																												 InstanceMethod("voicevoxSynthesizerNewV0_16", &Voicevox::voicevoxSynthesizerNewV0_16),
 																												 InstanceMethod("voicevoxSynthesizerDeleteV0_16", &Voicevox::voicevoxSynthesizerDeleteV0_16),
+																												 InstanceMethod("voicevoxSynthesizerSwapOpenJtalkAsyncV0_16", &Voicevox::voicevoxSynthesizerSwapOpenJtalkAsyncV0_16),
 																												 InstanceMethod("voicevoxSynthesizerLoadVoiceModelV0_16", &Voicevox::voicevoxSynthesizerLoadVoiceModelV0_16),
 																												 InstanceMethod("voicevoxSynthesizerUnloadVoiceModelV0_16", &Voicevox::voicevoxSynthesizerUnloadVoiceModelV0_16),
 																												 InstanceMethod("voicevoxSynthesizerIsGpuModeV0_16", &Voicevox::voicevoxSynthesizerIsGpuModeV0_16),
@@ -79,16 +415,43 @@ Napi::Object Voicevox::Init(Napi::Env env, Napi::Object exports)
 																												 InstanceMethod("voicevoxSynthesizerSynthesisV0_16", &Voicevox::voicevoxSynthesizerSynthesisV0_16),
 																												 InstanceMethod("voicevoxSynthesizerTtsFromKanaV0_16", &Voicevox::voicevoxSynthesizerTtsFromKanaV0_16),
 																												 InstanceMethod("voicevoxSynthesizerTtsV0_16", &Voicevox::voicevoxSynthesizerTtsV0_16),
+																												 InstanceMethod("voicevoxSynthesizerTtsAsyncV0_16", &Voicevox::voicevoxSynthesizerTtsAsyncV0_16),
+																												 InstanceMethod("voicevoxAudioQueryNewV0_16", &Voicevox::voicevoxAudioQueryNewV0_16),
+																												 InstanceMethod("voicevoxSynthesizerCreateAudioQueryHandleV0_16", &Voicevox::voicevoxSynthesizerCreateAudioQueryHandleV0_16),
+																												 InstanceMethod("voicevoxAudioQueryToJsonV0_16", &Voicevox::voicevoxAudioQueryToJsonV0_16),
+																												 InstanceMethod("voicevoxAudioQueryGetMorasV0_16", &Voicevox::voicevoxAudioQueryGetMorasV0_16),
+																												 InstanceMethod("voicevoxAudioQuerySetMoraPitchV0_16", &Voicevox::voicevoxAudioQuerySetMoraPitchV0_16),
+																												 InstanceMethod("voicevoxAudioQuerySetMoraLengthV0_16", &Voicevox::voicevoxAudioQuerySetMoraLengthV0_16),
+																												 InstanceMethod("voicevoxAudioQuerySetPitchesV0_16", &Voicevox::voicevoxAudioQuerySetPitchesV0_16),
+																												 InstanceMethod("voicevoxAudioQuerySetScaleV0_16", &Voicevox::voicevoxAudioQuerySetScaleV0_16),
+																												 InstanceMethod("voicevoxSynthesizerAudioQueryReplaceV0_16", &Voicevox::voicevoxSynthesizerAudioQueryReplaceV0_16),
+																												 InstanceMethod("voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16", &Voicevox::voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16),
+																												 InstanceMethod("voicevoxSynthesizerSynthesisFramesAsyncV0_16", &Voicevox::voicevoxSynthesizerSynthesisFramesAsyncV0_16),
+																												 InstanceMethod("voicevoxSynthesizerSynthesisToFileAsyncV0_16", &Voicevox::voicevoxSynthesizerSynthesisToFileAsyncV0_16),
+																												 InstanceMethod("voicevoxSynthesizerSynthesisToFdAsyncV0_16", &Voicevox::voicevoxSynthesizerSynthesisToFdAsyncV0_16),
+																												 InstanceMethod("voicevoxSynthesizerSynthesisStreamV0_16", &Voicevox::voicevoxSynthesizerSynthesisStreamV0_16),
+																												 InstanceMethod("voicevoxPcmStreamReadV0_16", &Voicevox::voicevoxPcmStreamReadV0_16),
+																												 InstanceMethod("voicevoxPcmStreamDeleteV0_16", &Voicevox::voicevoxPcmStreamDeleteV0_16),
+																												 InstanceMethod("voicevoxAudioQueryDeleteV0_16", &Voicevox::voicevoxAudioQueryDeleteV0_16),
 																												 InstanceMethod("voicevoxErrorResultToMessageV0_12", &Voicevox::voicevoxErrorResultToMessageV0_12),
 																												 InstanceMethod("voicevoxUserDictNewV0_16", &Voicevox::voicevoxUserDictNewV0_16),
 																												 InstanceMethod("voicevoxUserDictLoadV0_16", &Voicevox::voicevoxUserDictLoadV0_16),
 																												 InstanceMethod("voicevoxUserDictAddWordV0_16", &Voicevox::voicevoxUserDictAddWordV0_16),
+																												 InstanceMethod("voicevoxUserDictAddWordsAsyncV0_16", &Voicevox::voicevoxUserDictAddWordsAsyncV0_16),
 																												 InstanceMethod("voicevoxUserDictUpdateWordV0_16", &Voicevox::voicevoxUserDictUpdateWordV0_16),
 																												 InstanceMethod("voicevoxUserDictRemoveWordV0_16", &Voicevox::voicevoxUserDictRemoveWordV0_16),
 																												 InstanceMethod("voicevoxUserDictToJsonV0_16", &Voicevox::voicevoxUserDictToJsonV0_16),
 																												 InstanceMethod("voicevoxUserDictImportV0_16", &Voicevox::voicevoxUserDictImportV0_16),
 																												 InstanceMethod("voicevoxUserDictSaveV0_16", &Voicevox::voicevoxUserDictSaveV0_16),
 																												 InstanceMethod("voicevoxUserDictDeleteV0_16", &Voicevox::voicevoxUserDictDeleteV0_16),
+																												 InstanceMethod("voicevoxUserDictFindWordV0_16", &Voicevox::voicevoxUserDictFindWordV0_16),
+																												 InstanceMethod("voicevoxUserDictFindWordsBySurfaceV0_16", &Voicevox::voicevoxUserDictFindWordsBySurfaceV0_16),
+																												 InstanceMethod("voicevoxUserDictFindWordsByPrefixV0_16", &Voicevox::voicevoxUserDictFindWordsByPrefixV0_16),
+																												 InstanceMethod("voicevoxUserDictSaveSnapshotAsyncV0_16", &Voicevox::voicevoxUserDictSaveSnapshotAsyncV0_16),
+																												 InstanceMethod("voicevoxUserDictLoadSnapshotAsyncV0_16", &Voicevox::voicevoxUserDictLoadSnapshotAsyncV0_16),
+																												 InstanceMethod("voicevoxUserDictLoadAsyncV0_16", &Voicevox::voicevoxUserDictLoadAsyncV0_16),
+																												 InstanceMethod("voicevoxUserDictSaveAsyncV0_16", &Voicevox::voicevoxUserDictSaveAsyncV0_16),
+																												 InstanceMethod("voicevoxUserDictImportAsyncV0_16", &Voicevox::voicevoxUserDictImportAsyncV0_16),
 																												 InstanceMethod("voicevoxInitializeV0_14", &Voicevox::voicevoxInitializeV0_14),
 																												 InstanceMethod("voicevoxLoadModelV0_14", &Voicevox::voicevoxLoadModelV0_14),
 																												 InstanceMethod("voicevoxIsGpuModeV0_14", &Voicevox::voicevoxIsGpuModeV0_14),
@@ -124,6 +487,17 @@ Napi::Object Voicevox::Init(Napi::Env env, Napi::Object exports)
 																												 InstanceMethod("yukarinSForwardV0_5", &Voicevox::yukarinSForwardV0_5),
 																												 InstanceMethod("yukarinSaForwardV0_5", &Voicevox::yukarinSaForwardV0_5),
 																												 InstanceMethod("decodeForwardV0_5", &Voicevox::decodeForwardV0_5),
+																												 InstanceMethod("nativeHeapUsage", &Voicevox::nativeHeapUsage),
+																												 InstanceMethod("captureStart", &Voicevox::captureStart),
+																												 InstanceMethod("captureStop", &Voicevox::captureStop),
+																												 InstanceMethod("perfCountersEnable", &Voicevox::perfCountersEnable),
+																												 InstanceMethod("getStats", &Voicevox::getStats),
+																												 InstanceMethod("accentPhraseCacheSetCapacity", &Voicevox::accentPhraseCacheSetCapacity),
+																												 InstanceMethod("kanaCacheSetCapacity", &Voicevox::kanaCacheSetCapacity),
+																												 InstanceMethod("bufferPoolSetCapacity", &Voicevox::bufferPoolSetCapacity),
+																												 InstanceMethod("bufferPoolRelease", &Voicevox::bufferPoolRelease),
+																												 InstanceMethod("resamplePcmAsync", &Voicevox::resamplePcmAsync),
+																												 InstanceMethod("resampleWavAsync", &Voicevox::resampleWavAsync),
 																										 });
 
 	Napi::FunctionReference *constructor = new Napi::FunctionReference();
@@ -135,14 +509,14 @@ Napi::Object Voicevox::Init(Napi::Env env, Napi::Object exports)
 }
 
 Voicevox::Voicevox(const Napi::CallbackInfo &info)
-		: Napi::ObjectWrap<Voicevox>(info)
+		: Napi::ObjectWrap<Voicevox>(info), accent_phrase_cache(ACCENT_PHRASE_CACHE_DEFAULT_CAPACITY), kana_cache(0)
 {
-	const char *voicevox_core = load_string(info, 0);
+	std::string voicevox_core = load_string(info, 0);
 #ifdef _WIN32
-	const char *other_dll = load_string(info, 1);
-	load(other_dll);
+	std::string other_dll = load_string(info, 1);
+	load(other_dll.c_str());
 #endif
-	dll = dll_load(voicevox_core);
+	dll = dll_load(voicevox_core.c_str());
 }
 
 Voicevox::~Voicevox()
@@ -150,15 +524,143 @@ Voicevox::~Voicevox()
 	dll_free(dll);
 }
 
+/**
+ * 非同期ジョブが使用中のシンセサイザを数える(メインスレッドからのみ触る)
+ */
+void Voicevox::acquire_synthesizer(uintptr_t synthesizer)
+{
+	this->synthesizer_in_flight[synthesizer]++;
+}
+
+void Voicevox::release_synthesizer(uintptr_t synthesizer)
+{
+	auto it = this->synthesizer_in_flight.find(synthesizer);
+	if (it == this->synthesizer_in_flight.end() || --it->second != 0)
+		return;
+	this->synthesizer_in_flight.erase(it);
+	if (!this->retired_synthesizers.erase(synthesizer))
+		return;
+	try
+	{
+		voicevox_synthesizer_delete_v0_16(this->dll, reinterpret_cast<VoicevoxSynthesizer *>(synthesizer));
+	}
+	catch (const std::exception &)
+	{
+		// 遅れて行う解放の失敗は返す先が無い
+	}
+}
+
+/**
+ * ユーザー辞書の索引を、voicevox_coreの辞書の内容から作り直す(ファイルから読み込んだ場合など、追加された単語が分からないとき)
+ */
+bool Voicevox::rebuild_user_dict_index(uint32_t user_dict_pointer_name)
+{
+	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
+	char *output_json = nullptr;
+	if (voicevox_user_dict_to_json_v0_16(this->dll, user_dict, &output_json) != VOICEVOX_RESULT_OK)
+		return false;
+	bool result = this->user_dict_indexes[user_dict_pointer_name].rebuild(output_json);
+	voicevox_json_free_v0_16(this->dll, output_json);
+	return result;
+}
+
+/**
+ * テキスト解析の結果を使い回すためのキー。シンセサイザの使うOpenJtalkRcとそのユーザー辞書が同じ間だけ同じになる
+ * @return 使うOpenJtalkRcが分からない場合は空
+ */
+std::string Voicevox::text_analysis_cache_key(uint32_t synthesizer_pointer_name, const std::string &text)
+{
+	auto it = this->synthesizer_open_jtalks.find(synthesizer_pointer_name);
+	if (it == this->synthesizer_open_jtalks.end())
+		return std::string();
+	auto revision = this->open_jtalk_revisions.find(it->second);
+	if (revision == this->open_jtalk_revisions.end())
+		return std::string();
+	return std::to_string(it->second) + ":" + std::to_string(revision->second) + "\n" + text;
+}
+
+/**
+ * ttsの前に、同じテキストのAquesTalk風記法が記録されていれば取り出す(記録が無効なら何もしない)
+ * @return 次にkana_cacheを変更するまで有効
+ */
+const KanaCacheEntry *Voicevox::find_kana(uint32_t synthesizer_pointer_name, const std::string &text)
+{
+	if (this->kana_cache.capacity() == 0)
+		return nullptr;
+	std::string cache_key = this->text_analysis_cache_key(synthesizer_pointer_name, text);
+	const KanaCacheEntry *cached = cache_key.empty() ? nullptr : this->kana_cache.find(cache_key);
+	this->kana_cache.record(cached != nullptr);
+	return cached;
+}
+
+/**
+ * テキストからAudioQueryのJSONを作る。同じテキストを解析済みなら、アクセント句の音高・長さだけをこのスタイルで作り直す
+ */
+VoicevoxResultCode Voicevox::create_audio_query_json(uint32_t synthesizer_pointer_name, const std::string &text, VoicevoxStyleId style_id, std::string &audio_query_json)
+{
+	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	std::string cache_key = this->text_analysis_cache_key(synthesizer_pointer_name, text);
+	AccentPhraseCacheEntry *cached = cache_key.empty() ? nullptr : this->accent_phrase_cache.find(cache_key);
+	if (cached != nullptr && !cached->audio_query_rest.empty())
+	{
+		char *output_accent_phrases_json;
+		VoicevoxResultCode result_code = voicevox_synthesizer_replace_mora_data_v0_16(this->dll, synthesizer, cached->accent_phrases.c_str(), style_id, &output_accent_phrases_json);
+		if (result_code == VOICEVOX_RESULT_OK)
+		{
+			this->accent_phrase_cache.record(true);
+			KanaCacheEntry kana_entry{std::string(), cached->text_query_ns};
+			if (this->kana_cache.capacity() > 0 && extract_audio_query_kana(cached->audio_query_rest, kana_entry.kana))
+				this->kana_cache.put(cache_key, std::move(kana_entry));
+			audio_query_json = "{\"accent_phrases\":" + copy_str(output_accent_phrases_json) + cached->audio_query_rest;
+			voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+			return result_code;
+		}
+	}
+	if (!cache_key.empty())
+		this->accent_phrase_cache.record(false);
+	char *output_audio_query_json;
+	uint64_t start_ns = Capture::now();
+	VoicevoxResultCode result_code = voicevox_synthesizer_create_audio_query_v0_16(this->dll, synthesizer, text.c_str(), style_id, &output_audio_query_json);
+	uint64_t text_query_ns = Capture::now() - start_ns;
+	if (result_code != VOICEVOX_RESULT_OK)
+		return result_code;
+	audio_query_json = copy_str(output_audio_query_json);
+	AccentPhraseCacheEntry entry{std::string(), std::string(), text_query_ns};
+	if (!cache_key.empty() && split_audio_query_json(output_audio_query_json, entry.accent_phrases, entry.audio_query_rest))
+	{
+		// 以降のtts用に、テキスト解析の結果のAquesTalk風記法を記録する
+		KanaCacheEntry kana_entry{std::string(), text_query_ns};
+		if (this->kana_cache.capacity() > 0 && extract_audio_query_kana(entry.audio_query_rest, kana_entry.kana))
+			this->kana_cache.put(cache_key, std::move(kana_entry));
+		this->accent_phrase_cache.put(cache_key, std::move(entry));
+	}
+	voicevox_json_free_v0_16(this->dll, output_audio_query_json);
+	return result_code;
+}
+
+/**
+ * シンセサイザを解放する。非同期ジョブが使用中なら、最後のジョブが完了した時点で解放する
+ */
+void Voicevox::retire_synthesizer(uintptr_t synthesizer)
+{
+	if (this->synthesizer_in_flight.count(synthesizer))
+	{
+		this->retired_synthesizers.insert(synthesizer);
+		return;
+	}
+	voicevox_synthesizer_delete_v0_16(this->dll, reinterpret_cast<VoicevoxSynthesizer *>(synthesizer));
+}
+
 Napi::Value Voicevox::voicevoxOpenJtalkRcNewV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *open_jtalk_dic_dir = load_string(info, 0);
+	std::string open_jtalk_dic_dir = load_string(info, 0);
 	uint32_t open_jtalk_pointer_name = load_uint32_t(info, 1);
 	OpenJtalkRc *out_open_jtalk;
-	VoicevoxResultCode resultCode = voicevox_open_jtalk_rc_new_v0_16(this->dll, open_jtalk_dic_dir, &out_open_jtalk);
+	VoicevoxResultCode resultCode = voicevox_open_jtalk_rc_new_v0_16(this->dll, open_jtalk_dic_dir.c_str(), &out_open_jtalk);
 	this->open_jtalk_pointers.emplace(open_jtalk_pointer_name, reinterpret_cast<uintptr_t>(out_open_jtalk));
+	this->open_jtalk_revisions[open_jtalk_pointer_name] = ++this->open_jtalk_revision_counter;
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -177,10 +679,90 @@ Napi::Value Voicevox::voicevoxOpenJtalkRcUseUserDictV0_16(const Napi::CallbackIn
 	const OpenJtalkRc *open_jtalk = reinterpret_cast<const OpenJtalkRc *>(this->open_jtalk_pointers.at(open_jtalk_pointer_name));
 	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
 	VoicevoxResultCode resultCode = voicevox_open_jtalk_rc_use_user_dict_v0_16(this->dll, open_jtalk, user_dict);
+	// 失敗した場合も辞書が変わっていないとは限らないため、解析結果は使い回さない
+	this->open_jtalk_revisions[open_jtalk_pointer_name] = ++this->open_jtalk_revision_counter;
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
 
+Napi::Value Voicevox::voicevoxOpenJtalkRcNewAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	std::string open_jtalk_dic_dir = load_string(info, 0);
+	uint32_t open_jtalk_pointer_name = load_uint32_t(info, 1);
+	if (this->open_jtalk_pointers.count(open_jtalk_pointer_name) || this->open_jtalk_in_flight.count(open_jtalk_pointer_name))
+	{
+		Napi::Error::New(env, "open_jtalkのポインタ名は既に使われています").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	acquire_in_flight(this->open_jtalk_in_flight, open_jtalk_pointer_name);
+	auto result_code = std::make_shared<VoicevoxResultCode>(VOICEVOX_RESULT_OK);
+	auto out_open_jtalk = std::make_shared<OpenJtalkRc *>(nullptr);
+	return AsyncJob::Queue(
+			info,
+			[this, open_jtalk_dic_dir, result_code, out_open_jtalk]()
+			{
+				*result_code = voicevox_open_jtalk_rc_new_v0_16(this->dll, open_jtalk_dic_dir.c_str(), out_open_jtalk.get());
+			},
+			[this, open_jtalk_pointer_name]()
+			{
+				release_in_flight(this->open_jtalk_in_flight, open_jtalk_pointer_name);
+			},
+			[this, open_jtalk_pointer_name, result_code, out_open_jtalk](Napi::Env env)
+			{
+				if (*result_code == VOICEVOX_RESULT_OK)
+				{
+					this->open_jtalk_pointers.emplace(open_jtalk_pointer_name, reinterpret_cast<uintptr_t>(*out_open_jtalk));
+					this->open_jtalk_revisions[open_jtalk_pointer_name] = ++this->open_jtalk_revision_counter;
+				}
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, *result_code));
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::voicevoxOpenJtalkRcUseUserDictAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t open_jtalk_pointer_name = load_uint32_t(info, 0);
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 1);
+	if (!this->open_jtalk_pointers.count(open_jtalk_pointer_name))
+	{
+		Napi::Error::New(env, "open_jtalkのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	if (!this->user_dict_pointers.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const OpenJtalkRc *open_jtalk = reinterpret_cast<const OpenJtalkRc *>(this->open_jtalk_pointers.at(open_jtalk_pointer_name));
+	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
+	// 実行中に解放されないよう、両方を使用中にする
+	acquire_in_flight(this->open_jtalk_in_flight, open_jtalk_pointer_name);
+	acquire_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+	auto result_code = std::make_shared<VoicevoxResultCode>(VOICEVOX_RESULT_OK);
+	return AsyncJob::Queue(
+			info,
+			[this, open_jtalk, user_dict, result_code]()
+			{
+				*result_code = voicevox_open_jtalk_rc_use_user_dict_v0_16(this->dll, open_jtalk, user_dict);
+			},
+			[this, open_jtalk_pointer_name, user_dict_pointer_name]()
+			{
+				release_in_flight(this->open_jtalk_in_flight, open_jtalk_pointer_name);
+				release_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+			},
+			[this, open_jtalk_pointer_name, result_code](Napi::Env env)
+			{
+				// 辞書を置き換えている間の解析結果も含め、以前のものは使い回さない
+				this->open_jtalk_revisions[open_jtalk_pointer_name] = ++this->open_jtalk_revision_counter;
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, *result_code));
+				return obj;
+			});
+}
+
 Napi::Value Voicevox::voicevoxOpenJtalkRcDeleteV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
@@ -191,6 +773,11 @@ Napi::Value Voicevox::voicevoxOpenJtalkRcDeleteV0_16(const Napi::CallbackInfo &i
 		Napi::Error::New(env, "open_jtalkのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
+	if (this->open_jtalk_in_flight.count(open_jtalk_pointer_name))
+	{
+		Napi::Error::New(env, "open_jtalkは処理中のため解放できません").ThrowAsJavaScriptException();
+		return obj;
+	}
 	OpenJtalkRc *open_jtalk = reinterpret_cast<OpenJtalkRc *>(this->open_jtalk_pointers.at(open_jtalk_pointer_name));
 	try
 	{
@@ -202,6 +789,11 @@ Napi::Value Voicevox::voicevoxOpenJtalkRcDeleteV0_16(const Napi::CallbackInfo &i
 		return obj;
 	}
 	this->open_jtalk_pointers.erase(open_jtalk_pointer_name);
+	// ポインタ名が使い回されたときに以前の解析結果を使わないよう、番号を消す。
+	// このOpenJtalkRcを使っていたシンセサイザは、以降は解析結果を使い回さない
+	this->open_jtalk_revisions.erase(open_jtalk_pointer_name);
+	for (auto it = this->synthesizer_open_jtalks.begin(); it != this->synthesizer_open_jtalks.end();)
+		it = it->second == open_jtalk_pointer_name ? this->synthesizer_open_jtalks.erase(it) : std::next(it);
 	return obj;
 }
 
@@ -227,11 +819,13 @@ Napi::Value Voicevox::voicevoxVoiceModelNewFromPathV0_16(const Napi::CallbackInf
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *path = load_string(info, 0);
+	std::string path = load_string(info, 0);
 	VoicevoxVoiceModel *out_model;
 	uint32_t model_pointer_name = load_uint32_t(info, 1);
-	VoicevoxResultCode resultCode = voicevox_voice_model_new_from_path_v0_16(this->dll, path, &out_model);
+	VoicevoxResultCode resultCode = voicevox_voice_model_new_from_path_v0_16(this->dll, path.c_str(), &out_model);
 	this->model_pointers.emplace(model_pointer_name, reinterpret_cast<uintptr_t>(out_model));
+	if (resultCode == VOICEVOX_RESULT_OK)
+		this->model_paths[model_pointer_name] = path;
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -298,6 +892,7 @@ Napi::Value Voicevox::voicevoxVoiceModelDeleteV0_16(const Napi::CallbackInfo &in
 		return obj;
 	}
 	this->model_pointers.erase(model_pointer_name);
+	this->model_paths.erase(model_pointer_name);
 	return obj;
 }
 
@@ -328,6 +923,9 @@ Napi::Value Voicevox::voicevoxSynthesizerNewV0_16(const Napi::CallbackInfo &info
 	options.cpu_num_threads = static_cast<uint16_t>(load_uint32_t(info, 3));
 	VoicevoxResultCode resultCode = voicevox_synthesizer_new_v0_16(this->dll, open_jtalk, options, &out_synthesizer);
 	this->synthesizer_pointers.emplace(out_synthesizer_pointer_name, reinterpret_cast<uintptr_t>(out_synthesizer));
+	// OpenJtalkRcの切り替え時に同じ設定でシンセサイザを作り直すため
+	this->synthesizer_options.emplace(out_synthesizer_pointer_name, options);
+	this->synthesizer_open_jtalks[out_synthesizer_pointer_name] = open_jtalk_pointer_name;
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -342,10 +940,14 @@ Napi::Value Voicevox::voicevoxSynthesizerDeleteV0_16(const Napi::CallbackInfo &i
 		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
-	VoicevoxSynthesizer *synthesizer = reinterpret_cast<VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	if (this->synthesizer_swap_in_flight.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerはOpenJtalkRcの切り替え中のため解放できません").ThrowAsJavaScriptException();
+		return obj;
+	}
 	try
 	{
-		voicevox_synthesizer_delete_v0_16(this->dll, synthesizer);
+		this->retire_synthesizer(this->synthesizer_pointers.at(synthesizer_pointer_name));
 	}
 	catch (const std::exception &e)
 	{
@@ -353,9 +955,97 @@ Napi::Value Voicevox::voicevoxSynthesizerDeleteV0_16(const Napi::CallbackInfo &i
 		return obj;
 	}
 	this->synthesizer_pointers.erase(synthesizer_pointer_name);
+	this->synthesizer_options.erase(synthesizer_pointer_name);
+	this->synthesizer_open_jtalks.erase(synthesizer_pointer_name);
+	this->synthesizer_model_paths.erase(synthesizer_pointer_name);
 	return obj;
 }
 
+Napi::Value Voicevox::voicevoxSynthesizerSwapOpenJtalkAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	uint32_t open_jtalk_pointer_name = load_uint32_t(info, 1);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	if (!this->open_jtalk_pointers.count(open_jtalk_pointer_name))
+	{
+		Napi::Error::New(env, "open_jtalkのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	if (this->synthesizer_swap_in_flight.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerは既にOpenJtalkRcの切り替え中です").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const OpenJtalkRc *open_jtalk = reinterpret_cast<const OpenJtalkRc *>(this->open_jtalk_pointers.at(open_jtalk_pointer_name));
+	VoicevoxInitializeOptions options = this->synthesizer_options.at(synthesizer_pointer_name);
+	// 新しいシンセサイザには、今のシンセサイザに読み込んだ音声モデルを全て読み込む。音声モデルは閉じられていることがあるため、ファイルから開き直す
+	std::vector<std::string> model_paths;
+	for (const auto &model : this->synthesizer_model_paths[synthesizer_pointer_name])
+		model_paths.push_back(model.second);
+	acquire_in_flight(this->synthesizer_swap_in_flight, synthesizer_pointer_name);
+	acquire_in_flight(this->open_jtalk_in_flight, open_jtalk_pointer_name);
+	auto result_code = std::make_shared<VoicevoxResultCode>(VOICEVOX_RESULT_OK);
+	auto out_synthesizer = std::make_shared<VoicevoxSynthesizer *>(nullptr);
+	return AsyncJob::Queue(
+			info,
+			[this, open_jtalk, options, model_paths, result_code, out_synthesizer]()
+			{
+				*result_code = voicevox_synthesizer_new_v0_16(this->dll, open_jtalk, options, out_synthesizer.get());
+				if (*result_code != VOICEVOX_RESULT_OK)
+				{
+					*out_synthesizer = nullptr;
+					return;
+				}
+				for (const std::string &path : model_paths)
+				{
+					VoicevoxVoiceModel *model = nullptr;
+					*result_code = voicevox_voice_model_new_from_path_v0_16(this->dll, path.c_str(), &model);
+					if (*result_code == VOICEVOX_RESULT_OK)
+					{
+						*result_code = voicevox_synthesizer_load_voice_model_v0_16(this->dll, *out_synthesizer, model);
+						voicevox_voice_model_delete_v0_16(this->dll, model);
+					}
+					if (*result_code != VOICEVOX_RESULT_OK)
+					{
+						voicevox_synthesizer_delete_v0_16(this->dll, *out_synthesizer);
+						*out_synthesizer = nullptr;
+						return;
+					}
+				}
+			},
+			[this, synthesizer_pointer_name, open_jtalk_pointer_name]()
+			{
+				release_in_flight(this->synthesizer_swap_in_flight, synthesizer_pointer_name);
+				release_in_flight(this->open_jtalk_in_flight, open_jtalk_pointer_name);
+			},
+			[this, synthesizer_pointer_name, open_jtalk_pointer_name, result_code, out_synthesizer](Napi::Env env)
+			{
+				if (*result_code == VOICEVOX_RESULT_OK)
+				{
+					// メインスレッドでポインタ名の指す先を差し替えるため、以降の呼び出しは全て新しいシンセサイザを使う
+					uintptr_t old_synthesizer = this->synthesizer_pointers.at(synthesizer_pointer_name);
+					this->synthesizer_pointers[synthesizer_pointer_name] = reinterpret_cast<uintptr_t>(*out_synthesizer);
+					this->synthesizer_open_jtalks[synthesizer_pointer_name] = open_jtalk_pointer_name;
+					try
+					{
+						this->retire_synthesizer(old_synthesizer);
+					}
+					catch (const std::exception &e)
+					{
+						throw Napi::Error::New(env, e.what());
+					}
+				}
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, *result_code));
+				return obj;
+			});
+}
+
 Napi::Value Voicevox::voicevoxSynthesizerLoadVoiceModelV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
@@ -366,6 +1056,12 @@ Napi::Value Voicevox::voicevoxSynthesizerLoadVoiceModelV0_16(const Napi::Callbac
 		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
+	// 切り替え中の変更は新しいシンセサイザに引き継がれないため、受け付けない
+	if (this->synthesizer_swap_in_flight.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerはOpenJtalkRcの切り替え中のため音声モデルを読み込めません").ThrowAsJavaScriptException();
+		return obj;
+	}
 	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
 	uint32_t model_pointer_name = load_uint32_t(info, 1);
 	if (!this->model_pointers.count(model_pointer_name))
@@ -375,6 +1071,8 @@ Napi::Value Voicevox::voicevoxSynthesizerLoadVoiceModelV0_16(const Napi::Callbac
 	}
 	const VoicevoxVoiceModel *model = reinterpret_cast<const VoicevoxVoiceModel *>(this->model_pointers.at(model_pointer_name));
 	VoicevoxResultCode resultCode = voicevox_synthesizer_load_voice_model_v0_16(this->dll, synthesizer, model);
+	if (resultCode == VOICEVOX_RESULT_OK && this->model_paths.count(model_pointer_name))
+		this->synthesizer_model_paths[synthesizer_pointer_name][voicevox_voice_model_id_v0_16(this->dll, model)] = this->model_paths.at(model_pointer_name);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -389,9 +1087,17 @@ Napi::Value Voicevox::voicevoxSynthesizerUnloadVoiceModelV0_16(const Napi::Callb
 		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
+	// 切り替え中の変更は新しいシンセサイザに引き継がれないため、受け付けない
+	if (this->synthesizer_swap_in_flight.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerはOpenJtalkRcの切り替え中のため音声モデルを破棄できません").ThrowAsJavaScriptException();
+		return obj;
+	}
 	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	VoicevoxVoiceModelId model_id = load_string(info, 1);
-	VoicevoxResultCode resultCode = voicevox_synthesizer_unload_voice_model_v0_16(this->dll, synthesizer, model_id);
+	std::string model_id = load_string(info, 1);
+	VoicevoxResultCode resultCode = voicevox_synthesizer_unload_voice_model_v0_16(this->dll, synthesizer, model_id.c_str());
+	if (resultCode == VOICEVOX_RESULT_OK)
+		this->synthesizer_model_paths[synthesizer_pointer_name].erase(model_id);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -432,11 +1138,11 @@ Napi::Value Voicevox::voicevoxSynthesizerIsLoadedVoiceModelV0_16(const Napi::Cal
 		return obj;
 	}
 	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	VoicevoxVoiceModelId model_id = load_string(info, 1);
+	std::string model_id = load_string(info, 1);
 	bool result;
 	try
 	{
-		result = voicevox_synthesizer_is_loaded_voice_model_v0_16(this->dll, synthesizer, model_id);
+		result = voicevox_synthesizer_is_loaded_voice_model_v0_16(this->dll, synthesizer, model_id.c_str());
 	}
 	catch (const std::exception &e)
 	{
@@ -513,10 +1219,14 @@ Napi::Value Voicevox::voicevoxSynthesizerCreateAudioQueryFromKanaV0_16(const Nap
 		return obj;
 	}
 	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *kana = load_string(info, 1);
+	std::string kana = load_string(info, 1);
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
 	char *output_audio_query_json;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_create_audio_query_from_kana_v0_16(this->dll, synthesizer, kana, style_id, &output_audio_query_json);
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode = voicevox_synthesizer_create_audio_query_from_kana_v0_16(this->dll, synthesizer, kana.c_str(), style_id, &output_audio_query_json);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerCreateAudioQueryFromKanaV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_CREATE_AUDIO_QUERY_FROM_KANA_V0_16, style_id, kana, 0, resultCode, arrival_ns);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	obj.Set("result", Napi::String::New(env, copy_str(output_audio_query_json)));
 	try
@@ -541,13 +1251,25 @@ Napi::Value Voicevox::voicevoxSynthesizerCreateAudioQueryV0_16(const Napi::Callb
 		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
-	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *text = load_string(info, 1);
+	std::string text = load_string(info, 1);
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
-	char *output_audio_query_json;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_create_audio_query_v0_16(this->dll, synthesizer, text, style_id, &output_audio_query_json);
+	std::string audio_query_json;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode;
+	try
+	{
+		resultCode = this->create_audio_query_json(synthesizer_pointer_name, text, style_id, audio_query_json);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerCreateAudioQueryV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_CREATE_AUDIO_QUERY_V0_16, style_id, text, 0, resultCode, arrival_ns);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
-	obj.Set("result", Napi::String::New(env, copy_str(output_audio_query_json)));
+	obj.Set("result", Napi::String::New(env, audio_query_json));
 	return obj;
 }
 
@@ -562,10 +1284,14 @@ Napi::Value Voicevox::voicevoxSynthesizerCreateAccentPhrasesFromKanaV0_16(const
 		return obj;
 	}
 	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *kana = load_string(info, 1);
+	std::string kana = load_string(info, 1);
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
 	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_create_accent_phrases_from_kana_v0_16(this->dll, synthesizer, kana, style_id, &output_accent_phrases_json);
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode = voicevox_synthesizer_create_accent_phrases_from_kana_v0_16(this->dll, synthesizer, kana.c_str(), style_id, &output_accent_phrases_json);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerCreateAccentPhrasesFromKanaV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_CREATE_ACCENT_PHRASES_FROM_KANA_V0_16, style_id, kana, 0, resultCode, arrival_ns);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
 	try
@@ -591,12 +1317,41 @@ Napi::Value Voicevox::voicevoxSynthesizerCreateAccentPhrasesV0_16(const Napi::Ca
 		return obj;
 	}
 	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *text = load_string(info, 1);
+	std::string text = load_string(info, 1);
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
 	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_create_accent_phrases_v0_16(this->dll, synthesizer, text, style_id, &output_accent_phrases_json);
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	std::string cache_key = this->text_analysis_cache_key(synthesizer_pointer_name, text);
+	AccentPhraseCacheEntry *cached = cache_key.empty() ? nullptr : this->accent_phrase_cache.find(cache_key);
+	VoicevoxResultCode resultCode;
+	if (cached != nullptr)
+	{
+		// 同じテキストを解析済みなら、音高・長さだけをこのスタイルで作り直す
+		this->accent_phrase_cache.record(true);
+		resultCode = voicevox_synthesizer_replace_mora_data_v0_16(this->dll, synthesizer, cached->accent_phrases.c_str(), style_id, &output_accent_phrases_json);
+	}
+	else
+	{
+		if (!cache_key.empty())
+			this->accent_phrase_cache.record(false);
+		resultCode = voicevox_synthesizer_create_accent_phrases_v0_16(this->dll, synthesizer, text.c_str(), style_id, &output_accent_phrases_json);
+		if (resultCode == VOICEVOX_RESULT_OK && !cache_key.empty())
+			this->accent_phrase_cache.put(cache_key, AccentPhraseCacheEntry{copy_str(output_accent_phrases_json), std::string(), 0});
+	}
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerCreateAccentPhrasesV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_CREATE_ACCENT_PHRASES_V0_16, style_id, text, 0, resultCode, arrival_ns);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
+	try
+	{
+		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
 	return obj;
 }
 
@@ -611,83 +1366,1055 @@ Napi::Value Voicevox::voicevoxSynthesizerReplaceMoraDataV0_16(const Napi::Callba
 		return obj;
 	}
 	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *accent_phrases_json = load_string(info, 1);
+	std::string accent_phrases_json = load_string(info, 1);
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
 	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_replace_mora_data_v0_16(this->dll, synthesizer, accent_phrases_json, style_id, &output_accent_phrases_json);
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode = voicevox_synthesizer_replace_mora_data_v0_16(this->dll, synthesizer, accent_phrases_json.c_str(), style_id, &output_accent_phrases_json);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerReplaceMoraDataV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_REPLACE_MORA_DATA_V0_16, style_id, accent_phrases_json, 0, resultCode, arrival_ns);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
 	try
 	{
-		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerReplacePhonemeLengthV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	std::string accent_phrases_json = load_string(info, 1);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	char *output_accent_phrases_json;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode = voicevox_synthesizer_replace_phoneme_length_v0_16(this->dll, synthesizer, accent_phrases_json.c_str(), style_id, &output_accent_phrases_json);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerReplacePhonemeLengthV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_REPLACE_PHONEME_LENGTH_V0_16, style_id, accent_phrases_json, 0, resultCode, arrival_ns);
+	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
+	try
+	{
+		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerReplaceMoraPitchV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	std::string accent_phrases_json = load_string(info, 1);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	char *output_accent_phrases_json;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode = voicevox_synthesizer_replace_mora_pitch_v0_16(this->dll, synthesizer, accent_phrases_json.c_str(), style_id, &output_accent_phrases_json);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerReplaceMoraPitchV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_REPLACE_MORA_PITCH_V0_16, style_id, accent_phrases_json, 0, resultCode, arrival_ns);
+	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
+	try
+	{
+		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerSynthesisV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	std::string audio_query_json = load_string(info, 1);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	VoicevoxSynthesisOptions options;
+	try
+	{
+		options = voicevox_make_default_synthesis_options_v0_14(this->dll);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	uintptr_t output_wav_length = 0;
+	uint8_t *output_wav = nullptr;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode = voicevox_synthesizer_synthesis_v0_16(this->dll, synthesizer, audio_query_json.c_str(), style_id, options, &output_wav_length, &output_wav);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerSynthesisV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_SYNTHESIS_V0_16, style_id, audio_query_json, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, resultCode, arrival_ns);
+	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	obj.Set("result", this->buffer_pool->copy(env, output_wav, output_wav_length));
+	if (output_wav != nullptr)
+	{
+		try
+		{
+			voicevox_wav_free_v0_12(this->dll, output_wav);
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerTtsFromKanaV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	std::string kana = load_string(info, 1);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	VoicevoxTtsOptions options;
+	try
+	{
+		options = voicevox_make_default_tts_options_v0_16(this->dll);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	uintptr_t output_wav_length = 0;
+	uint8_t *output_wav = nullptr;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode = voicevox_synthesizer_tts_from_kana_v0_16(this->dll, synthesizer, kana.c_str(), style_id, options, &output_wav_length, &output_wav);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerTtsFromKanaV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_TTS_FROM_KANA_V0_16, style_id, kana, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, resultCode, arrival_ns);
+	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	obj.Set("result", this->buffer_pool->copy(env, output_wav, output_wav_length));
+	if (output_wav != nullptr)
+	{
+		try
+		{
+			voicevox_wav_free_v0_12(this->dll, output_wav);
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerTtsV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	std::string text = load_string(info, 1);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	VoicevoxTtsOptions options = voicevox_make_default_tts_options_v0_16(this->dll);
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	uintptr_t output_wav_length = 0;
+	uint8_t *output_wav = nullptr;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	const KanaCacheEntry *cached = this->find_kana(synthesizer_pointer_name, text);
+	VoicevoxResultCode resultCode;
+	if (cached != nullptr)
+	{
+		uint64_t kana_query_ns = 0;
+		resultCode = tts_from_cached_kana(this->dll, synthesizer, cached->kana, style_id, options, &output_wav_length, &output_wav, kana_query_ns);
+		if (cached->text_query_ns > kana_query_ns)
+			this->kana_cache_saved_ns += cached->text_query_ns - kana_query_ns;
+	}
+	else
+		resultCode = voicevox_synthesizer_tts_v0_16(this->dll, synthesizer, text.c_str(), style_id, options, &output_wav_length, &output_wav);
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerTtsV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_TTS_V0_16, style_id, text, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, resultCode, arrival_ns);
+	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	obj.Set("result", this->buffer_pool->copy(env, output_wav, output_wav_length));
+	if (output_wav != nullptr)
+	{
+		try
+		{
+			voicevox_wav_free_v0_12(this->dll, output_wav);
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerTtsAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	uintptr_t synthesizer = this->synthesizer_pointers.at(synthesizer_pointer_name);
+	std::string text = load_string(info, 1);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	VoicevoxTtsOptions options = voicevox_make_default_tts_options_v0_16(this->dll);
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	AudioOutputSpec output_spec;
+	if (!load_audio_output_spec(info, 4, output_spec) || !load_audio_output_loudness(info, 6, output_spec) || !load_audio_post_process(info, 7, output_spec))
+		return env.Undefined();
+	uint64_t arrival_ns = Capture::now();
+	CaptureOptions capture_options;
+	capture_options.variant = CAPTURE_VARIANT_ASYNC;
+	capture_options.output = output_spec;
+	// 実行中にOpenJtalkRcが切り替わったり解放されたりしても、このシンセサイザは完了するまで解放しない
+	this->acquire_synthesizer(synthesizer);
+	struct TtsResult
+	{
+		VoicevoxResultCode result_code = VOICEVOX_RESULT_OK;
+		uintptr_t output_wav_length = 0;
+		uint8_t *output_wav = nullptr;
+		/** 出力形式を変換した場合はその結果(`output_wav`は解放済み。`output_wav`自身に書き戻した場合は空) */
+		std::vector<uint8_t> encoded;
+		bool measured = false;
+		PerfReading reading;
+		/** 記録済みのAquesTalk風記法を使う場合はその内容 */
+		bool from_kana = false;
+		KanaCacheEntry kana;
+		uint64_t kana_query_ns = 0;
+	};
+	auto tts_result = std::make_shared<TtsResult>();
+	// キャッシュはメインスレッドでのみ触るため、ここで取り出しておく
+	const KanaCacheEntry *cached = this->find_kana(synthesizer_pointer_name, text);
+	if (cached != nullptr)
+	{
+		tts_result->from_kana = true;
+		tts_result->kana = *cached;
+	}
+	return AsyncJob::Queue(
+			info,
+			[this, synthesizer, text, style_id, options, output_spec, tts_result]()
+			{
+				PerfScope perf_scope(this->perf);
+				if (tts_result->from_kana)
+					tts_result->result_code = tts_from_cached_kana(this->dll, reinterpret_cast<const VoicevoxSynthesizer *>(synthesizer), tts_result->kana.kana, style_id, options, &tts_result->output_wav_length, &tts_result->output_wav, tts_result->kana_query_ns);
+				else
+					tts_result->result_code = voicevox_synthesizer_tts_v0_16(this->dll, reinterpret_cast<const VoicevoxSynthesizer *>(synthesizer), text.c_str(), style_id, options, &tts_result->output_wav_length, &tts_result->output_wav);
+				if (tts_result->result_code == VOICEVOX_RESULT_OK)
+					encode_output_wav(this->dll, output_spec, tts_result->output_wav, tts_result->output_wav_length, tts_result->encoded);
+				tts_result->measured = perf_scope.finish("voicevoxSynthesizerTtsAsyncV0_16", tts_result->reading);
+			},
+			[this, synthesizer]()
+			{
+				this->release_synthesizer(synthesizer);
+			},
+			[this, text, style_id, options, arrival_ns, capture_options, tts_result](Napi::Env env)
+			{
+				if (tts_result->from_kana && tts_result->kana.text_query_ns > tts_result->kana_query_ns)
+					this->kana_cache_saved_ns += tts_result->kana.text_query_ns - tts_result->kana_query_ns;
+				this->capture.record(CAPTURE_SYNTHESIZER_TTS_V0_16, style_id, text, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, tts_result->result_code, arrival_ns, capture_options);
+				Napi::Object obj = Napi::Object::New(env);
+				if (tts_result->measured)
+					set_perf_reading(env, obj, tts_result->reading);
+				obj.Set("resultCode", Napi::Number::New(env, tts_result->result_code));
+				if (tts_result->output_wav != nullptr)
+					obj.Set("result", this->buffer_pool->copy(env, tts_result->output_wav, tts_result->output_wav_length));
+				else
+					obj.Set("result", this->buffer_pool->copy(env, tts_result->encoded.data(), tts_result->encoded.size()));
+				if (tts_result->output_wav != nullptr)
+				{
+					try
+					{
+						voicevox_wav_free_v0_12(this->dll, tts_result->output_wav);
+					}
+					catch (const std::exception &e)
+					{
+						throw Napi::Error::New(env, e.what());
+					}
+				}
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::voicevoxAudioQueryNewV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	std::string audio_query_json = load_string(info, 0);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 1);
+	AudioQuery query;
+	if (!query.parse(audio_query_json.c_str()))
+	{
+		Napi::Error::New(env, "AudioQueryのJSONを解釈できませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	this->audio_queries[audio_query_pointer_name] = std::move(query);
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerCreateAudioQueryHandleV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	std::string text = load_string(info, 1);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 3);
+	std::string audio_query_json;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode;
+	try
+	{
+		resultCode = this->create_audio_query_json(synthesizer_pointer_name, text, style_id, audio_query_json);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerCreateAudioQueryHandleV0_16");
+	this->capture.record(CAPTURE_SYNTHESIZER_CREATE_AUDIO_QUERY_V0_16, style_id, text, 0, resultCode, arrival_ns);
+	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	if (resultCode != VOICEVOX_RESULT_OK)
+		return obj;
+	AudioQuery query;
+	if (!query.parse(audio_query_json.c_str()))
+	{
+		Napi::Error::New(env, "AudioQueryのJSONを解釈できませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	this->audio_queries[audio_query_pointer_name] = std::move(query);
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxAudioQueryToJsonV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 0);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	obj.Set("result", Napi::String::New(env, this->audio_queries.at(audio_query_pointer_name).to_json()));
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxAudioQueryGetMorasV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 0);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	const AudioQuery &query = this->audio_queries.at(audio_query_pointer_name);
+	size_t mora_count = query.mora_count();
+	size_t accent_phrase_count = query.accent_phrase_count();
+	Napi::Array text = Napi::Array::New(env, mora_count);
+	Napi::Array consonant = Napi::Array::New(env, mora_count);
+	Napi::Array vowel = Napi::Array::New(env, mora_count);
+	Napi::Float64Array consonant_length = Napi::Float64Array::New(env, mora_count);
+	Napi::Float64Array vowel_length = Napi::Float64Array::New(env, mora_count);
+	Napi::Float64Array pitch = Napi::Float64Array::New(env, mora_count);
+	Napi::Uint8Array is_pause = Napi::Uint8Array::New(env, mora_count);
+	for (uint32_t i = 0; i < mora_count; i++)
+	{
+		text.Set(i, Napi::String::New(env, query.mora_text[i]));
+		vowel.Set(i, Napi::String::New(env, query.mora_vowel[i]));
+		if (query.mora_has_consonant[i])
+		{
+			consonant.Set(i, Napi::String::New(env, query.mora_consonant[i]));
+			consonant_length[i] = query.mora_consonant_length[i];
+		}
+		else
+		{
+			consonant.Set(i, env.Null());
+			consonant_length[i] = std::nan("");
+		}
+		vowel_length[i] = query.mora_vowel_length[i];
+		pitch[i] = query.mora_pitch[i];
+		is_pause[i] = query.mora_is_pause[i];
+	}
+	Napi::Uint32Array accent_phrase_ends = Napi::Uint32Array::New(env, accent_phrase_count);
+	Napi::Uint32Array accent = Napi::Uint32Array::New(env, accent_phrase_count);
+	Napi::Uint8Array is_interrogative = Napi::Uint8Array::New(env, accent_phrase_count);
+	for (size_t i = 0; i < accent_phrase_count; i++)
+	{
+		accent_phrase_ends[i] = query.phrase_mora_end[i];
+		accent[i] = query.phrase_accent[i];
+		is_interrogative[i] = query.phrase_is_interrogative[i];
+	}
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("text", text);
+	result.Set("consonant", consonant);
+	result.Set("vowel", vowel);
+	result.Set("consonantLength", consonant_length);
+	result.Set("vowelLength", vowel_length);
+	result.Set("pitch", pitch);
+	result.Set("isPause", is_pause);
+	result.Set("accentPhraseEnds", accent_phrase_ends);
+	result.Set("accent", accent);
+	result.Set("isInterrogative", is_interrogative);
+	obj.Set("result", result);
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxAudioQuerySetMoraPitchV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 0);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	AudioQuery &query = this->audio_queries.at(audio_query_pointer_name);
+	uint32_t mora_index = load_uint32_t(info, 1);
+	if (mora_index >= query.mora_count())
+	{
+		Napi::Error::New(env, "モーラの位置が範囲外です").ThrowAsJavaScriptException();
+		return obj;
+	}
+	query.mora_pitch[mora_index] = info[2].As<Napi::Number>().DoubleValue();
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxAudioQuerySetMoraLengthV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 0);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	AudioQuery &query = this->audio_queries.at(audio_query_pointer_name);
+	uint32_t mora_index = load_uint32_t(info, 1);
+	if (mora_index >= query.mora_count())
+	{
+		Napi::Error::New(env, "モーラの位置が範囲外です").ThrowAsJavaScriptException();
+		return obj;
+	}
+	// NaNは変更しない。子音の無いモーラの子音の長さは無視する
+	double consonant_length = info[2].As<Napi::Number>().DoubleValue();
+	double vowel_length = info[3].As<Napi::Number>().DoubleValue();
+	if (!std::isnan(consonant_length) && query.mora_has_consonant[mora_index])
+		query.mora_consonant_length[mora_index] = consonant_length;
+	if (!std::isnan(vowel_length))
+		query.mora_vowel_length[mora_index] = vowel_length;
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxAudioQuerySetPitchesV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 0);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	AudioQuery &query = this->audio_queries.at(audio_query_pointer_name);
+	Napi::Float64Array pitches = info[1].As<Napi::Float64Array>();
+	if (pitches.ElementLength() != query.mora_count())
+	{
+		Napi::Error::New(env, "音高の数がモーラの数と一致しません").ThrowAsJavaScriptException();
+		return obj;
+	}
+	std::copy(pitches.Data(), pitches.Data() + pitches.ElementLength(), query.mora_pitch.begin());
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxAudioQuerySetScaleV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 0);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	AudioQuery &query = this->audio_queries.at(audio_query_pointer_name);
+	std::string key = load_string(info, 1);
+	double value = info[2].As<Napi::Number>().DoubleValue();
+	if (key == "speedScale")
+		query.speed_scale = value;
+	else if (key == "pitchScale")
+		query.pitch_scale = value;
+	else if (key == "intonationScale")
+		query.intonation_scale = value;
+	else if (key == "volumeScale")
+		query.volume_scale = value;
+	else if (key == "prePhonemeLength")
+		query.pre_phoneme_length = value;
+	else if (key == "postPhonemeLength")
+		query.post_phoneme_length = value;
+	else if (key == "outputSamplingRate")
+		query.output_sampling_rate = static_cast<uint32_t>(value);
+	else
+	{
+		Napi::Error::New(env, "存在しない項目です: " + key).ThrowAsJavaScriptException();
+		return obj;
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerAudioQueryReplaceV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 1);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	AudioQuery &query = this->audio_queries.at(audio_query_pointer_name);
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	uint32_t kind = load_uint32_t(info, 3);
+	std::string accent_phrases_json = query.accent_phrases_to_json();
+	char *output_accent_phrases_json = nullptr;
+	PerfScope perf_scope(this->perf);
+	uint64_t arrival_ns = Capture::now();
+	VoicevoxResultCode resultCode;
+	CaptureBinding capture_binding;
+	switch (kind)
+	{
+	case AUDIO_QUERY_REPLACE_MORA_DATA:
+		resultCode = voicevox_synthesizer_replace_mora_data_v0_16(this->dll, synthesizer, accent_phrases_json.c_str(), style_id, &output_accent_phrases_json);
+		capture_binding = CAPTURE_SYNTHESIZER_REPLACE_MORA_DATA_V0_16;
+		break;
+	case AUDIO_QUERY_REPLACE_PHONEME_LENGTH:
+		resultCode = voicevox_synthesizer_replace_phoneme_length_v0_16(this->dll, synthesizer, accent_phrases_json.c_str(), style_id, &output_accent_phrases_json);
+		capture_binding = CAPTURE_SYNTHESIZER_REPLACE_PHONEME_LENGTH_V0_16;
+		break;
+	case AUDIO_QUERY_REPLACE_MORA_PITCH:
+		resultCode = voicevox_synthesizer_replace_mora_pitch_v0_16(this->dll, synthesizer, accent_phrases_json.c_str(), style_id, &output_accent_phrases_json);
+		capture_binding = CAPTURE_SYNTHESIZER_REPLACE_MORA_PITCH_V0_16;
+		break;
+	default:
+		Napi::Error::New(env, "存在しない置き換えの種類です").ThrowAsJavaScriptException();
+		return obj;
+	}
+	set_perf(env, obj, perf_scope, "voicevoxSynthesizerAudioQueryReplaceV0_16");
+	this->capture.record(capture_binding, style_id, accent_phrases_json, 0, resultCode, arrival_ns);
+	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	if (resultCode != VOICEVOX_RESULT_OK)
+		return obj;
+	bool parsed = query.parse_accent_phrases(output_accent_phrases_json);
+	try
+	{
+		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return obj;
+	}
+	if (!parsed)
+	{
+		Napi::Error::New(env, "アクセント句のJSONを解釈できませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	uintptr_t synthesizer = this->synthesizer_pointers.at(synthesizer_pointer_name);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 1);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	VoicevoxSynthesisOptions options;
+	try
+	{
+		options = voicevox_make_default_synthesis_options_v0_14(this->dll);
+	}
+	catch (const std::exception &e)
+	{
+		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	AudioOutputSpec output_spec;
+	if (!load_audio_output_spec(info, 4, output_spec) || !load_audio_output_loudness(info, 6, output_spec) || !load_audio_post_process(info, 7, output_spec))
+		return env.Undefined();
+	// JSONにするのはここだけ。以降はAudioQueryを変更・破棄してもこの合成には影響しない
+	std::string audio_query_json = this->audio_queries.at(audio_query_pointer_name).to_json();
+	uint64_t arrival_ns = Capture::now();
+	CaptureOptions capture_options;
+	capture_options.variant = CAPTURE_VARIANT_ASYNC;
+	capture_options.output = output_spec;
+	this->acquire_synthesizer(synthesizer);
+	struct SynthesisResult
+	{
+		VoicevoxResultCode result_code = VOICEVOX_RESULT_OK;
+		uintptr_t output_wav_length = 0;
+		uint8_t *output_wav = nullptr;
+		/** 出力形式を変換した場合はその結果(`output_wav`は解放済み。`output_wav`自身に書き戻した場合は空) */
+		std::vector<uint8_t> encoded;
+		bool measured = false;
+		PerfReading reading;
+	};
+	auto synthesis_result = std::make_shared<SynthesisResult>();
+	return AsyncJob::Queue(
+			info,
+			[this, synthesizer, audio_query_json, style_id, options, output_spec, synthesis_result]()
+			{
+				PerfScope perf_scope(this->perf);
+				synthesis_result->result_code = voicevox_synthesizer_synthesis_v0_16(this->dll, reinterpret_cast<const VoicevoxSynthesizer *>(synthesizer), audio_query_json.c_str(), style_id, options, &synthesis_result->output_wav_length, &synthesis_result->output_wav);
+				if (synthesis_result->result_code == VOICEVOX_RESULT_OK)
+					encode_output_wav(this->dll, output_spec, synthesis_result->output_wav, synthesis_result->output_wav_length, synthesis_result->encoded);
+				synthesis_result->measured = perf_scope.finish("voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16", synthesis_result->reading);
+			},
+			[this, synthesizer]()
+			{
+				this->release_synthesizer(synthesizer);
+			},
+			[this, audio_query_json, style_id, options, arrival_ns, capture_options, synthesis_result](Napi::Env env)
+			{
+				this->capture.record(CAPTURE_SYNTHESIZER_SYNTHESIS_V0_16, style_id, audio_query_json, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, synthesis_result->result_code, arrival_ns, capture_options);
+				Napi::Object obj = Napi::Object::New(env);
+				if (synthesis_result->measured)
+					set_perf_reading(env, obj, synthesis_result->reading);
+				obj.Set("resultCode", Napi::Number::New(env, synthesis_result->result_code));
+				if (synthesis_result->output_wav != nullptr)
+					obj.Set("result", this->buffer_pool->copy(env, synthesis_result->output_wav, synthesis_result->output_wav_length));
+				else
+					obj.Set("result", this->buffer_pool->copy(env, synthesis_result->encoded.data(), synthesis_result->encoded.size()));
+				if (synthesis_result->output_wav != nullptr)
+				{
+					try
+					{
+						voicevox_wav_free_v0_12(this->dll, synthesis_result->output_wav);
+					}
+					catch (const std::exception &e)
+					{
+						throw Napi::Error::New(env, e.what());
+					}
+				}
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::voicevoxSynthesizerSynthesisFramesAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
+	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	{
+		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	uintptr_t synthesizer = this->synthesizer_pointers.at(synthesizer_pointer_name);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 1);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
+	VoicevoxSynthesisOptions options;
+	try
+	{
+		options = voicevox_make_default_synthesis_options_v0_14(this->dll);
 	}
 	catch (const std::exception &e)
 	{
 		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
-		return obj;
+		return env.Undefined();
 	}
-	return obj;
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	AudioOutputSpec output_spec;
+	if (!load_audio_output_spec(info, 4, output_spec) || !load_audio_output_loudness(info, 10, output_spec) || !load_audio_post_process(info, 11, output_spec))
+		return env.Undefined();
+	if (output_spec.format == AUDIO_OUTPUT_WAV || output_spec.format == AUDIO_OUTPUT_WAV_STREAM)
+	{
+		Napi::Error::New(env, "フレームの出力形式にWAVは使えません").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	uint32_t frame_ms = load_uint32_t(info, 6);
+	uint32_t frames_per_batch = load_uint32_t(info, 7);
+	bool pace = load_bool(info, 8);
+	if (frame_ms == 0 || frame_ms > 1000 || frames_per_batch == 0)
+	{
+		Napi::Error::New(env, "フレームの長さか数が正しくありません").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	// コールバックは配信を始めるまでここで保持する
+	auto callback = std::make_shared<Napi::FunctionReference>(Napi::Persistent(info[9].As<Napi::Function>()));
+	std::string audio_query_json = this->audio_queries.at(audio_query_pointer_name).to_json();
+	uint64_t arrival_ns = Capture::now();
+	CaptureOptions capture_options;
+	capture_options.variant = CAPTURE_VARIANT_FRAMES;
+	capture_options.output = output_spec;
+	capture_options.frame_ms = frame_ms;
+	capture_options.frames_per_batch = frames_per_batch;
+	capture_options.pace = pace;
+	this->acquire_synthesizer(synthesizer);
+	struct FramesResult
+	{
+		VoicevoxResultCode result_code = VOICEVOX_RESULT_OK;
+		uintptr_t output_wav_length = 0;
+		uint8_t *output_wav = nullptr;
+		std::vector<uint8_t> encoded;
+		WavFormat encoded_format;
+		size_t frame_bytes = 0;
+		bool measured = false;
+		PerfReading reading;
+	};
+	auto frames_result = std::make_shared<FramesResult>();
+	return AsyncJob::Queue(
+			info,
+			[this, synthesizer, audio_query_json, style_id, options, output_spec, frame_ms, frames_result]()
+			{
+				PerfScope perf_scope(this->perf);
+				frames_result->result_code = voicevox_synthesizer_synthesis_v0_16(this->dll, reinterpret_cast<const VoicevoxSynthesizer *>(synthesizer), audio_query_json.c_str(), style_id, options, &frames_result->output_wav_length, &frames_result->output_wav);
+				if (frames_result->result_code == VOICEVOX_RESULT_OK)
+					encode_output_wav(this->dll, output_spec, frames_result->output_wav, frames_result->output_wav_length, frames_result->encoded, &frames_result->encoded_format, false);
+				frames_result->measured = perf_scope.finish("voicevoxSynthesizerSynthesisFramesAsyncV0_16", frames_result->reading);
+				if (frames_result->result_code != VOICEVOX_RESULT_OK)
+					return;
+				const WavFormat &format = frames_result->encoded_format;
+				uint64_t frame_samples = static_cast<uint64_t>(format.sample_rate) * frame_ms;
+				if (frame_samples % 1000 != 0)
+					throw std::runtime_error("サンプリングレート" + std::to_string(format.sample_rate) + "Hzでは" + std::to_string(frame_ms) + "ミリ秒のフレームを作れません");
+				frames_result->frame_bytes = static_cast<size_t>(frame_samples / 1000) * format.channels * (format.bits_per_sample / 8);
+			},
+			[this, synthesizer]()
+			{
+				this->release_synthesizer(synthesizer);
+			},
+			[this, audio_query_json, style_id, options, arrival_ns, capture_options, frame_ms, frames_per_batch, pace, callback, frames_result](Napi::Env env) -> Napi::Value
+			{
+				this->capture.record(CAPTURE_SYNTHESIZER_SYNTHESIS_V0_16, style_id, audio_query_json, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, frames_result->result_code, arrival_ns, capture_options);
+				auto make_result = [frames_result](Napi::Env env)
+				{
+					Napi::Object obj = Napi::Object::New(env);
+					if (frames_result->measured)
+						set_perf_reading(env, obj, frames_result->reading);
+					obj.Set("resultCode", Napi::Number::New(env, frames_result->result_code));
+					return obj;
+				};
+				if (frames_result->result_code != VOICEVOX_RESULT_OK)
+				{
+					Napi::Object obj = make_result(env);
+					Napi::Object result = Napi::Object::New(env);
+					result.Set("frames", Napi::Number::New(env, 0));
+					result.Set("cancelled", Napi::Boolean::New(env, false));
+					obj.Set("result", result);
+					return obj;
+				}
+				FrameStream::Options stream_options;
+				stream_options.frame_bytes = frames_result->frame_bytes;
+				stream_options.frames_per_batch = frames_per_batch;
+				stream_options.frame_ns = static_cast<uint64_t>(frame_ms) * 1000000;
+				stream_options.pace = pace;
+				switch (frames_result->encoded_format.format)
+				{
+				case WAV_FORMAT_MULAW:
+					stream_options.silence = 0xff;
+					break;
+				case WAV_FORMAT_ALAW:
+					stream_options.silence = 0xd5;
+					break;
+				default:
+					stream_options.silence = 0;
+				}
+				// このPromiseで解決すると、JSには配信を終えた時点で結果が返る
+				return FrameStream::start(env, callback->Value(), std::move(frames_result->encoded), stream_options, make_result);
+			});
 }
 
-Napi::Value Voicevox::voicevoxSynthesizerReplacePhonemeLengthV0_16(const Napi::CallbackInfo &info)
+Napi::Value Voicevox::voicevoxSynthesizerSynthesisToFileAsyncV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
-	Napi::Object obj = Napi::Object::New(env);
 	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
 	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
 	{
 		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
-		return obj;
+		return env.Undefined();
+	}
+	uintptr_t synthesizer = this->synthesizer_pointers.at(synthesizer_pointer_name);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 1);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
 	}
-	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *accent_phrases_json = load_string(info, 1);
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
-	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_replace_phoneme_length_v0_16(this->dll, synthesizer, accent_phrases_json, style_id, &output_accent_phrases_json);
-	obj.Set("resultCode", Napi::Number::New(env, resultCode));
-	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
+	VoicevoxSynthesisOptions options;
 	try
 	{
-		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+		options = voicevox_make_default_synthesis_options_v0_14(this->dll);
 	}
 	catch (const std::exception &e)
 	{
 		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
-		return obj;
+		return env.Undefined();
 	}
-	return obj;
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	AudioOutputSpec output_spec;
+	if (!load_audio_output_spec(info, 4, output_spec) || !load_audio_output_loudness(info, 8, output_spec) || !load_audio_post_process(info, 9, output_spec))
+		return env.Undefined();
+	std::string path = load_string(info, 6);
+	// 一時ファイルは置き換えるまで見えないため、書き終えてからヘッダを書き換えるのと最初から本当の大きさを書くのは同じ
+	if (output_spec.format == AUDIO_OUTPUT_WAV_STREAM && load_bool(info, 7))
+		output_spec.format = AUDIO_OUTPUT_WAV;
+	std::string audio_query_json = this->audio_queries.at(audio_query_pointer_name).to_json();
+	uint64_t arrival_ns = Capture::now();
+	CaptureOptions capture_options;
+	capture_options.variant = CAPTURE_VARIANT_FILE;
+	capture_options.output = output_spec;
+	this->acquire_synthesizer(synthesizer);
+	struct FileResult
+	{
+		VoicevoxResultCode result_code = VOICEVOX_RESULT_OK;
+		uint64_t written = 0;
+		double duration_ms = 0;
+		bool measured = false;
+		PerfReading reading;
+	};
+	auto file_result = std::make_shared<FileResult>();
+	return AsyncJob::Queue(
+			info,
+			[this, synthesizer, audio_query_json, style_id, options, output_spec, path, file_result]()
+			{
+				uintptr_t output_wav_length = 0;
+				uint8_t *output_wav = nullptr;
+				{
+					PerfScope perf_scope(this->perf);
+					file_result->result_code = voicevox_synthesizer_synthesis_v0_16(this->dll, reinterpret_cast<const VoicevoxSynthesizer *>(synthesizer), audio_query_json.c_str(), style_id, options, &output_wav_length, &output_wav);
+					file_result->measured = perf_scope.finish("voicevoxSynthesizerSynthesisToFileAsyncV0_16", file_result->reading);
+				}
+				if (file_result->result_code != VOICEVOX_RESULT_OK)
+					return;
+				// 変換しながら書き込むため、変換後の全体はメモリに持たない
+				std::string error;
+				AudioOutputEncoder encoder;
+				auto fill = [&encoder](uint8_t *buffer, size_t capacity)
+				{
+					return encoder.read(buffer, capacity);
+				};
+				bool written = encoder.open(output_wav, output_wav_length, output_spec, error) && write_file_atomic(path, fill, file_result->written, error);
+				voicevox_wav_free_v0_12(this->dll, output_wav);
+				if (!written)
+					throw std::runtime_error(error);
+				const WavFormat &format = encoder.format();
+				file_result->duration_ms = static_cast<double>(format.data_size) / (format.channels * (format.bits_per_sample / 8)) * 1000.0 / format.sample_rate;
+			},
+			[this, synthesizer]()
+			{
+				this->release_synthesizer(synthesizer);
+			},
+			[this, audio_query_json, style_id, options, arrival_ns, capture_options, file_result](Napi::Env env)
+			{
+				this->capture.record(CAPTURE_SYNTHESIZER_SYNTHESIS_V0_16, style_id, audio_query_json, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, file_result->result_code, arrival_ns, capture_options);
+				Napi::Object obj = Napi::Object::New(env);
+				if (file_result->measured)
+					set_perf_reading(env, obj, file_result->reading);
+				obj.Set("resultCode", Napi::Number::New(env, file_result->result_code));
+				Napi::Object result = Napi::Object::New(env);
+				result.Set("bytes", Napi::Number::New(env, static_cast<double>(file_result->written)));
+				result.Set("durationMs", Napi::Number::New(env, file_result->duration_ms));
+				obj.Set("result", result);
+				return obj;
+			});
 }
 
-Napi::Value Voicevox::voicevoxSynthesizerReplaceMoraPitchV0_16(const Napi::CallbackInfo &info)
+Napi::Value Voicevox::voicevoxSynthesizerSynthesisToFdAsyncV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
-	Napi::Object obj = Napi::Object::New(env);
 	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
 	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
 	{
 		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
-		return obj;
+		return env.Undefined();
+	}
+	uintptr_t synthesizer = this->synthesizer_pointers.at(synthesizer_pointer_name);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 1);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
 	}
-	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *accent_phrases_json = load_string(info, 1);
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
-	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_replace_mora_pitch_v0_16(this->dll, synthesizer, accent_phrases_json, style_id, &output_accent_phrases_json);
-	obj.Set("resultCode", Napi::Number::New(env, resultCode));
-	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
+	VoicevoxSynthesisOptions options;
 	try
 	{
-		voicevox_json_free_v0_16(this->dll, output_accent_phrases_json);
+		options = voicevox_make_default_synthesis_options_v0_14(this->dll);
 	}
 	catch (const std::exception &e)
 	{
 		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
-		return obj;
+		return env.Undefined();
 	}
-	return obj;
+	options.enable_interrogative_upspeak = load_bool(info, 3);
+	AudioOutputSpec output_spec;
+	if (!load_audio_output_spec(info, 4, output_spec) || !load_audio_output_loudness(info, 9, output_spec) || !load_audio_post_process(info, 10, output_spec))
+		return env.Undefined();
+	int fd = static_cast<int>(load_uint32_t(info, 6));
+	uint32_t timeout_ms = load_uint32_t(info, 7);
+	bool patch_header = output_spec.format == AUDIO_OUTPUT_WAV_STREAM && load_bool(info, 8);
+	std::string audio_query_json = this->audio_queries.at(audio_query_pointer_name).to_json();
+	uint64_t arrival_ns = Capture::now();
+	CaptureOptions capture_options;
+	capture_options.variant = CAPTURE_VARIANT_FD;
+	capture_options.output = output_spec;
+	capture_options.patch_wav_header = patch_header;
+	this->acquire_synthesizer(synthesizer);
+	struct FdResult
+	{
+		VoicevoxResultCode result_code = VOICEVOX_RESULT_OK;
+		uint64_t written = 0;
+		double duration_ms = 0;
+		bool measured = false;
+		PerfReading reading;
+	};
+	auto fd_result = std::make_shared<FdResult>();
+	return ThreadJob::Start(
+			info,
+			[this, synthesizer, audio_query_json, style_id, options, output_spec, fd, timeout_ms, patch_header, fd_result]()
+			{
+				// 書き換える位置は書き始める前に決め、書き換えられない場合は合成しない
+				std::string error;
+				int64_t start = 0;
+				if (patch_header && !fd_tell(fd, start, error))
+					throw std::runtime_error(error);
+				uintptr_t output_wav_length = 0;
+				uint8_t *output_wav = nullptr;
+				{
+					PerfScope perf_scope(this->perf);
+					fd_result->result_code = voicevox_synthesizer_synthesis_v0_16(this->dll, reinterpret_cast<const VoicevoxSynthesizer *>(synthesizer), audio_query_json.c_str(), style_id, options, &output_wav_length, &output_wav);
+					fd_result->measured = perf_scope.finish("voicevoxSynthesizerSynthesisToFdAsyncV0_16", fd_result->reading);
+				}
+				if (fd_result->result_code != VOICEVOX_RESULT_OK)
+					return;
+				// 変換しながら書き込むため、変換後の全体はメモリに持たない。相手が読むのを待つ間もスレッドプールは塞がない
+				AudioOutputEncoder encoder;
+				auto fill = [&encoder](uint8_t *buffer, size_t capacity)
+				{
+					return encoder.read(buffer, capacity);
+				};
+				bool written = encoder.open(output_wav, output_wav_length, output_spec, error) && write_fd(fd, fill, timeout_ms, fd_result->written, error);
+				voicevox_wav_free_v0_12(this->dll, output_wav);
+				if (!written)
+					throw std::runtime_error(error);
+				const WavFormat &format = encoder.format();
+				if (patch_header)
+				{
+					uint8_t header[WAV_HEADER_SIZE];
+					wav_write_header(header, format.format, format.channels, format.sample_rate, format.bits_per_sample, static_cast<uint32_t>(format.data_size));
+					if (!fd_write_at(fd, start, header, sizeof(header), error))
+						throw std::runtime_error(error);
+				}
+				fd_result->duration_ms = static_cast<double>(format.data_size) / (format.channels * (format.bits_per_sample / 8)) * 1000.0 / format.sample_rate;
+			},
+			[this, synthesizer]()
+			{
+				this->release_synthesizer(synthesizer);
+			},
+			[this, audio_query_json, style_id, options, arrival_ns, capture_options, fd_result](Napi::Env env)
+			{
+				this->capture.record(CAPTURE_SYNTHESIZER_SYNTHESIS_V0_16, style_id, audio_query_json, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, fd_result->result_code, arrival_ns, capture_options);
+				Napi::Object obj = Napi::Object::New(env);
+				if (fd_result->measured)
+					set_perf_reading(env, obj, fd_result->reading);
+				obj.Set("resultCode", Napi::Number::New(env, fd_result->result_code));
+				Napi::Object result = Napi::Object::New(env);
+				result.Set("bytes", Napi::Number::New(env, static_cast<double>(fd_result->written)));
+				result.Set("durationMs", Napi::Number::New(env, fd_result->duration_ms));
+				obj.Set("result", result);
+				return obj;
+			});
 }
 
-Napi::Value Voicevox::voicevoxSynthesizerSynthesisV0_16(const Napi::CallbackInfo &info)
+Napi::Value Voicevox::voicevoxSynthesizerSynthesisStreamV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
@@ -697,8 +2424,13 @@ Napi::Value Voicevox::voicevoxSynthesizerSynthesisV0_16(const Napi::CallbackInfo
 		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
-	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *audio_query_json = load_string(info, 1);
+	uintptr_t synthesizer = this->synthesizer_pointers.at(synthesizer_pointer_name);
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 1);
+	if (!this->audio_queries.count(audio_query_pointer_name))
+	{
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
 	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
 	VoicevoxSynthesisOptions options;
 	try
@@ -711,66 +2443,140 @@ Napi::Value Voicevox::voicevoxSynthesizerSynthesisV0_16(const Napi::CallbackInfo
 		return obj;
 	}
 	options.enable_interrogative_upspeak = load_bool(info, 3);
-	uintptr_t output_wav_length;
-	uint8_t *output_wav;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_synthesis_v0_16(this->dll, synthesizer, audio_query_json, style_id, options, &output_wav_length, &output_wav);
-	obj.Set("resultCode", Napi::Number::New(env, resultCode));
-	obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_wav, output_wav_length));
+	AudioOutputSpec output_spec;
+	if (!load_audio_output_spec(info, 4, output_spec) || !load_audio_output_loudness(info, 9, output_spec) || !load_audio_post_process(info, 10, output_spec))
+		return obj;
+	uint32_t ring_bytes = load_uint32_t(info, 6);
+	uint32_t stream_pointer_name = load_uint32_t(info, 7);
+	if (ring_bytes < PCM_STREAM_MIN_RING_BYTES)
+	{
+		Napi::Error::New(env, "リングバッファが小さすぎます").ThrowAsJavaScriptException();
+		return obj;
+	}
+	std::string audio_query_json = this->audio_queries.at(audio_query_pointer_name).to_json();
+	uint64_t arrival_ns = Capture::now();
+	CaptureOptions capture_options;
+	capture_options.variant = CAPTURE_VARIANT_STREAM;
+	capture_options.output = output_spec;
+	capture_options.ring_bytes = ring_bytes;
+	this->acquire_synthesizer(synthesizer);
+	auto stream = std::make_shared<PcmStream>(ring_bytes);
+	this->pcm_streams[stream_pointer_name] = stream;
+	PcmStream::start(
+			stream, env, info.This().ToObject(), info[8].As<Napi::Function>(),
+			[this, synthesizer, audio_query_json, style_id, options, output_spec, arrival_ns, capture_options](PcmStream &stream)
+			{
+				uintptr_t output_wav_length = 0;
+				uint8_t *output_wav = nullptr;
+				VoicevoxResultCode result_code;
+				std::string error;
+				try
+				{
+					result_code = voicevox_synthesizer_synthesis_v0_16(this->dll, reinterpret_cast<const VoicevoxSynthesizer *>(synthesizer), audio_query_json.c_str(), style_id, options, &output_wav_length, &output_wav);
+				}
+				catch (const std::exception &e)
+				{
+					result_code = VOICEVOX_RESULT_OK;
+					error = e.what();
+				}
+				// シンセサイザはここで手放す。以降は変換と書き込みだけ
+				stream.post(
+						[this, synthesizer, audio_query_json, style_id, options, arrival_ns, capture_options, result_code](Napi::Env)
+						{
+							this->release_synthesizer(synthesizer);
+							this->capture.record(CAPTURE_SYNTHESIZER_SYNTHESIS_V0_16, style_id, audio_query_json, options.enable_interrogative_upspeak ? CAPTURE_FLAG_ENABLE_INTERROGATIVE_UPSPEAK : 0, result_code, arrival_ns, capture_options);
+						});
+				if (!error.empty() || result_code != VOICEVOX_RESULT_OK)
+				{
+					stream.finish(result_code, error);
+					return;
+				}
+				AudioOutputEncoder encoder;
+				if (encoder.open(output_wav, output_wav_length, output_spec, error))
+				{
+					std::vector<uint8_t> chunk(PCM_STREAM_CHUNK_BYTES);
+					while (!encoder.finished())
+					{
+						size_t size = encoder.read(chunk.data(), chunk.size());
+						if (!stream.write(chunk.data(), size))
+							break;
+					}
+				}
+				voicevox_wav_free_v0_12(this->dll, output_wav);
+				stream.finish(VOICEVOX_RESULT_OK, error);
+			});
 	return obj;
 }
 
-Napi::Value Voicevox::voicevoxSynthesizerTtsFromKanaV0_16(const Napi::CallbackInfo &info)
+Napi::Value Voicevox::voicevoxPcmStreamReadV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
-	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	uint32_t stream_pointer_name = load_uint32_t(info, 0);
+	if (!this->pcm_streams.count(stream_pointer_name))
 	{
-		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		Napi::Error::New(env, "ストリームのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
-	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *kana = load_string(info, 1);
-	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
-	VoicevoxTtsOptions options;
-	try
-	{
-		options = voicevox_make_default_tts_options_v0_16(this->dll);
+	PcmStream &stream = *this->pcm_streams.at(stream_pointer_name);
+	size_t max_bytes = load_uint32_t(info, 1);
+	obj.Set("result", env.Null());
+	obj.Set("ended", Napi::Boolean::New(env, false));
+	obj.Set("resultCode", Napi::Number::New(env, VOICEVOX_RESULT_OK));
+	// 空なら書き込みを知らせてもらうようにし、その間に書き込まれていればもう一度読む
+	while (true)
+	{
+		size_t size = std::min(stream.readable(), max_bytes);
+		if (size > 0)
+		{
+			Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(env, size);
+			stream.read(buffer.Data(), size);
+			obj.Set("result", buffer);
+			return obj;
+		}
+		if (stream.ended())
+		{
+			if (!stream.error().empty())
+			{
+				Napi::Error::New(env, stream.error()).ThrowAsJavaScriptException();
+				return obj;
+			}
+			obj.Set("ended", Napi::Boolean::New(env, true));
+			obj.Set("resultCode", Napi::Number::New(env, stream.result_code()));
+			return obj;
+		}
+		if (!stream.wait_readable())
+			return obj;
 	}
-	catch (const std::exception &e)
+}
+
+Napi::Value Voicevox::voicevoxPcmStreamDeleteV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t stream_pointer_name = load_uint32_t(info, 0);
+	if (!this->pcm_streams.count(stream_pointer_name))
 	{
-		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+		Napi::Error::New(env, "ストリームのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
-	options.enable_interrogative_upspeak = load_bool(info, 3);
-	uintptr_t output_wav_length;
-	uint8_t *output_wav;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_tts_from_kana_v0_16(this->dll, synthesizer, kana, style_id, options, &output_wav_length, &output_wav);
-	obj.Set("resultCode", Napi::Number::New(env, resultCode));
-	obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_wav, output_wav_length));
+	// 書き込みスレッドは中止を見て終わり、その後に解放される
+	this->pcm_streams.at(stream_pointer_name)->cancel();
+	this->pcm_streams.erase(stream_pointer_name);
 	return obj;
 }
 
-Napi::Value Voicevox::voicevoxSynthesizerTtsV0_16(const Napi::CallbackInfo &info)
+Napi::Value Voicevox::voicevoxAudioQueryDeleteV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	uint32_t synthesizer_pointer_name = load_uint32_t(info, 0);
-	if (!this->synthesizer_pointers.count(synthesizer_pointer_name))
+	uint32_t audio_query_pointer_name = load_uint32_t(info, 0);
+	if (!this->audio_queries.count(audio_query_pointer_name))
 	{
-		Napi::Error::New(env, "synthesizerのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		Napi::Error::New(env, "AudioQueryのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
-	const VoicevoxSynthesizer *synthesizer = reinterpret_cast<const VoicevoxSynthesizer *>(this->synthesizer_pointers.at(synthesizer_pointer_name));
-	const char *text = load_string(info, 1);
-	VoicevoxStyleId style_id = static_cast<VoicevoxStyleId>(load_uint32_t(info, 2));
-	VoicevoxTtsOptions options = voicevox_make_default_tts_options_v0_16(this->dll);
-	options.enable_interrogative_upspeak = load_bool(info, 3);
-	uintptr_t output_wav_length;
-	uint8_t *output_wav;
-	VoicevoxResultCode resultCode = voicevox_synthesizer_tts_v0_16(this->dll, synthesizer, text, style_id, options, &output_wav_length, &output_wav);
-	obj.Set("resultCode", Napi::Number::New(env, resultCode));
-	obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_wav, output_wav_length));
+	this->audio_queries.erase(audio_query_pointer_name);
 	return obj;
 }
 
@@ -809,6 +2615,7 @@ Napi::Value Voicevox::voicevoxUserDictNewV0_16(const Napi::CallbackInfo &info)
 		return obj;
 	}
 	this->user_dict_pointers.emplace(user_dict_pointer_name, reinterpret_cast<uintptr_t>(userDict));
+	this->user_dict_indexes[user_dict_pointer_name] = UserDictIndex();
 	return obj;
 }
 
@@ -823,9 +2630,22 @@ Napi::Value Voicevox::voicevoxUserDictLoadV0_16(const Napi::CallbackInfo &info)
 		return obj;
 	}
 	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
-	const char *dict_path = load_string(info, 1);
-	VoicevoxResultCode resultCode = voicevox_user_dict_load_v0_16(this->dll, user_dict, dict_path);
+	std::string dict_path = load_string(info, 1);
+	VoicevoxResultCode resultCode = voicevox_user_dict_load_v0_16(this->dll, user_dict, dict_path.c_str());
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
+	if (resultCode == VOICEVOX_RESULT_OK)
+	{
+		try
+		{
+			if (!this->rebuild_user_dict_index(user_dict_pointer_name))
+				throw std::runtime_error("ユーザー辞書の索引を作れませんでした");
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
 	return obj;
 }
 
@@ -840,12 +2660,12 @@ Napi::Value Voicevox::voicevoxUserDictAddWordV0_16(const Napi::CallbackInfo &inf
 		return obj;
 	}
 	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
-	const char *surface = load_string(info, 1);
-	const char *pronunciation = load_string(info, 2);
+	std::string surface = load_string(info, 1);
+	std::string pronunciation = load_string(info, 2);
 	VoicevoxUserDictWord word;
 	try
 	{
-		word = voicevox_user_dict_word_make_v0_16(this->dll, surface, pronunciation);
+		word = voicevox_user_dict_word_make_v0_16(this->dll, surface.c_str(), pronunciation.c_str());
 	}
 	catch (const std::exception &e)
 	{
@@ -857,6 +2677,8 @@ Napi::Value Voicevox::voicevoxUserDictAddWordV0_16(const Napi::CallbackInfo &inf
 	word.word_type = static_cast<VoicevoxUserDictWordType>(load_uint32_t(info, 5));
 	uint8_t output_word_uuid[16];
 	VoicevoxResultCode resultCode = voicevox_user_dict_add_word_v0_16(this->dll, user_dict, &word, &output_word_uuid);
+	if (resultCode == VOICEVOX_RESULT_OK)
+		this->user_dict_indexes[user_dict_pointer_name].put(output_word_uuid, surface, pronunciation, static_cast<uint32_t>(word.accent_type), word.word_type, word.priority);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(env, 16);
 	for (size_t i = 0; i < 16; i++)
@@ -867,6 +2689,83 @@ Napi::Value Voicevox::voicevoxUserDictAddWordV0_16(const Napi::CallbackInfo &inf
 	return obj;
 }
 
+Napi::Value Voicevox::voicevoxUserDictAddWordsAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_pointers.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
+	// N-APIの値はワーカースレッドから触れないため、列はここで全てコピーする
+	Napi::Array surfaces = info[1].As<Napi::Array>();
+	Napi::Array pronunciations = info[2].As<Napi::Array>();
+	Napi::Uint32Array accent_types = info[3].As<Napi::Uint32Array>();
+	Napi::Uint32Array priorities = info[4].As<Napi::Uint32Array>();
+	Napi::Uint32Array word_types = info[5].As<Napi::Uint32Array>();
+	size_t count = surfaces.Length();
+	if (pronunciations.Length() != count || accent_types.ElementLength() != count || priorities.ElementLength() != count || word_types.ElementLength() != count)
+	{
+		Napi::Error::New(env, "各列の長さが一致していません").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	auto words = std::make_shared<std::vector<std::pair<std::string, std::string>>>();
+	words->reserve(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		words->emplace_back(surfaces.Get(i).As<Napi::String>().Utf8Value(), pronunciations.Get(i).As<Napi::String>().Utf8Value());
+	}
+	std::vector<uint32_t> accent_type_values(accent_types.Data(), accent_types.Data() + count);
+	std::vector<uint32_t> priority_values(priorities.Data(), priorities.Data() + count);
+	std::vector<uint32_t> word_type_values(word_types.Data(), word_types.Data() + count);
+	acquire_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+	auto result_code = std::make_shared<VoicevoxResultCode>(VOICEVOX_RESULT_OK);
+	auto failed_index = std::make_shared<size_t>(count);
+	auto output_word_uuids = std::make_shared<std::vector<uint8_t>>(count * 16);
+	return AsyncJob::Queue(
+			info,
+			[this, user_dict, words, accent_type_values, priority_values, word_type_values, result_code, failed_index, output_word_uuids]()
+			{
+				*result_code = add_user_dict_words(
+						this->dll, user_dict, words->size(),
+						[&](size_t i, VoicevoxUserDictWord &word)
+						{
+							word = voicevox_user_dict_word_make_v0_16(this->dll, (*words)[i].first.c_str(), (*words)[i].second.c_str());
+							word.accent_type = static_cast<uintptr_t>(accent_type_values[i]);
+							word.priority = priority_values[i];
+							word.word_type = static_cast<VoicevoxUserDictWordType>(word_type_values[i]);
+						},
+						reinterpret_cast<uint8_t(*)[16]>(output_word_uuids->data()), *failed_index);
+				if (*result_code != VOICEVOX_RESULT_OK)
+					output_word_uuids->clear();
+			},
+			[this, user_dict_pointer_name]()
+			{
+				release_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+			},
+			[this, user_dict_pointer_name, words, accent_type_values, priority_values, word_type_values, result_code, failed_index, output_word_uuids](Napi::Env env)
+			{
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, *result_code));
+				if (*result_code == VOICEVOX_RESULT_OK && this->user_dict_indexes.count(user_dict_pointer_name))
+				{
+					UserDictIndex &index = this->user_dict_indexes.at(user_dict_pointer_name);
+					const uint8_t(*uuids)[16] = reinterpret_cast<const uint8_t(*)[16]>(output_word_uuids->data());
+					for (size_t i = 0; i < words->size(); i++)
+					{
+						index.put(uuids[i], (*words)[i].first, (*words)[i].second, accent_type_values[i], word_type_values[i], priority_values[i]);
+					}
+				}
+				if (*result_code == VOICEVOX_RESULT_OK)
+					obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_word_uuids->data(), output_word_uuids->size()));
+				else
+					obj.Set("failedIndex", Napi::Number::New(env, static_cast<double>(*failed_index)));
+				return obj;
+			});
+}
+
 Napi::Value Voicevox::voicevoxUserDictUpdateWordV0_16(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
@@ -878,12 +2777,12 @@ Napi::Value Voicevox::voicevoxUserDictUpdateWordV0_16(const Napi::CallbackInfo &
 		return obj;
 	}
 	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
-	const char *surface = load_string(info, 1);
-	const char *pronunciation = load_string(info, 2);
+	std::string surface = load_string(info, 1);
+	std::string pronunciation = load_string(info, 2);
 	VoicevoxUserDictWord word;
 	try
 	{
-		word = voicevox_user_dict_word_make_v0_16(this->dll, surface, pronunciation);
+		word = voicevox_user_dict_word_make_v0_16(this->dll, surface.c_str(), pronunciation.c_str());
 	}
 	catch (const std::exception &e)
 	{
@@ -900,6 +2799,8 @@ Napi::Value Voicevox::voicevoxUserDictUpdateWordV0_16(const Napi::CallbackInfo &
 		word_uuid[i] = uuid[i];
 	}
 	VoicevoxResultCode resultCode = voicevox_user_dict_update_word_v0_16(this->dll, user_dict, &word_uuid, &word);
+	if (resultCode == VOICEVOX_RESULT_OK)
+		this->user_dict_indexes[user_dict_pointer_name].put(word_uuid, surface, pronunciation, static_cast<uint32_t>(word.accent_type), word.word_type, word.priority);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -922,6 +2823,8 @@ Napi::Value Voicevox::voicevoxUserDictRemoveWordV0_16(const Napi::CallbackInfo &
 		word_uuid[i] = uuid[i];
 	}
 	VoicevoxResultCode resultCode = voicevox_user_dict_remove_word_v0_16(this->dll, user_dict, &word_uuid);
+	if (resultCode == VOICEVOX_RESULT_OK)
+		this->user_dict_indexes[user_dict_pointer_name].remove(word_uuid);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -972,6 +2875,8 @@ Napi::Value Voicevox::voicevoxUserDictImportV0_16(const Napi::CallbackInfo &info
 	}
 	const VoicevoxUserDict *other_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(other_dict_pointer_name));
 	VoicevoxResultCode resultCode = voicevox_user_dict_import_v0_16(this->dll, user_dict, other_dict);
+	if (resultCode == VOICEVOX_RESULT_OK)
+		this->user_dict_indexes[user_dict_pointer_name].merge(this->user_dict_indexes[other_dict_pointer_name]);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -987,8 +2892,8 @@ Napi::Value Voicevox::voicevoxUserDictSaveV0_16(const Napi::CallbackInfo &info)
 		return obj;
 	}
 	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
-	const char *path = load_string(info, 1);
-	VoicevoxResultCode resultCode = voicevox_user_dict_save_v0_16(this->dll, user_dict, path);
+	std::string path = load_string(info, 1);
+	VoicevoxResultCode resultCode = voicevox_user_dict_save_v0_16(this->dll, user_dict, path.c_str());
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -1003,6 +2908,11 @@ Napi::Value Voicevox::voicevoxUserDictDeleteV0_16(const Napi::CallbackInfo &info
 		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
 		return obj;
 	}
+	if (this->user_dict_in_flight.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictは処理中のため解放できません").ThrowAsJavaScriptException();
+		return obj;
+	}
 	VoicevoxUserDict *user_dict = reinterpret_cast<VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
 	try
 	{
@@ -1014,9 +2924,305 @@ Napi::Value Voicevox::voicevoxUserDictDeleteV0_16(const Napi::CallbackInfo &info
 		return obj;
 	}
 	this->user_dict_pointers.erase(user_dict_pointer_name);
+	this->user_dict_indexes.erase(user_dict_pointer_name);
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxUserDictFindWordV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_indexes.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	uint8_t word_uuid[16];
+	Napi::Buffer<uint8_t> uuid = info[1].As<Napi::Buffer<uint8_t>>();
+	for (size_t i = 0; i < 16; i++)
+	{
+		word_uuid[i] = uuid[i];
+	}
+	const UserDictIndexWord *word = this->user_dict_indexes.at(user_dict_pointer_name).find_uuid(word_uuid);
+	if (word != nullptr)
+		obj.Set("result", user_dict_index_word_to_object(env, *word));
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxUserDictFindWordsBySurfaceV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_indexes.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	std::string surface = load_string(info, 1);
+	obj.Set("result", user_dict_index_words_to_array(env, this->user_dict_indexes.at(user_dict_pointer_name).find_surface(surface)));
+	return obj;
+}
+
+Napi::Value Voicevox::voicevoxUserDictFindWordsByPrefixV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_indexes.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return obj;
+	}
+	std::string prefix = load_string(info, 1);
+	uint32_t limit = load_uint32_t(info, 2);
+	obj.Set("result", user_dict_index_words_to_array(env, this->user_dict_indexes.at(user_dict_pointer_name).find_prefix(prefix, limit)));
 	return obj;
 }
 
+Napi::Value Voicevox::voicevoxUserDictSaveSnapshotAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_indexes.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	std::string path = load_string(info, 1);
+	// 呼び出した時点の内容で書き出す(以降の変更は含まない)。JSONは経由せず、索引から直接組み立てる
+	auto snapshot = std::make_shared<std::string>(user_dict_snapshot_build(this->user_dict_indexes.at(user_dict_pointer_name)));
+	return AsyncJob::Queue(
+			info,
+			[path, snapshot]()
+			{
+				std::string error;
+				if (!write_file_atomic(path, snapshot->data(), snapshot->size(), error))
+					throw std::runtime_error(error);
+			},
+			nullptr,
+			[](Napi::Env env)
+			{
+				return Napi::Object::New(env);
+			});
+}
+
+Napi::Value Voicevox::voicevoxUserDictLoadSnapshotAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_pointers.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
+	std::string path = load_string(info, 1);
+	acquire_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+	struct LoadResult
+	{
+		VoicevoxResultCode result_code = VOICEVOX_RESULT_OK;
+		size_t failed_index = 0;
+		std::vector<uint8_t> word_uuids;
+		std::vector<uint8_t> snapshot_word_uuids;
+		UserDictIndex index;
+	};
+	auto load_result = std::make_shared<LoadResult>();
+	return AsyncJob::Queue(
+			info,
+			[this, user_dict, path, load_result]()
+			{
+				UserDictSnapshotReader reader;
+				std::string error;
+				if (!reader.open(path, error))
+					throw std::runtime_error(error);
+				uint32_t count = reader.size();
+				load_result->word_uuids.resize(static_cast<size_t>(count) * 16);
+				uint8_t(*uuids)[16] = reinterpret_cast<uint8_t(*)[16]>(load_result->word_uuids.data());
+				// 文字列はmmapした領域をそのまま渡す
+				load_result->result_code = add_user_dict_words(
+						this->dll, user_dict, count,
+						[&](size_t i, VoicevoxUserDictWord &word)
+						{
+							uint32_t n = static_cast<uint32_t>(i);
+							word = voicevox_user_dict_word_make_v0_16(this->dll, reader.surface(n), reader.pronunciation(n));
+							word.accent_type = static_cast<uintptr_t>(reader.accent_type(n));
+							word.priority = reader.priority(n);
+							word.word_type = static_cast<VoicevoxUserDictWordType>(reader.word_type(n));
+						},
+						uuids, load_result->failed_index);
+				if (load_result->result_code != VOICEVOX_RESULT_OK)
+					return;
+				// 索引もここで作っておき、メインスレッドでは取り込むだけにする
+				load_result->snapshot_word_uuids.resize(static_cast<size_t>(count) * 16);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					std::memcpy(&load_result->snapshot_word_uuids[static_cast<size_t>(i) * 16], reader.uuid(i), 16);
+					load_result->index.put(uuids[i], reader.surface(i), reader.pronunciation(i), reader.accent_type(i), reader.word_type(i), reader.priority(i));
+				}
+			},
+			[this, user_dict_pointer_name]()
+			{
+				release_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+			},
+			[this, user_dict_pointer_name, load_result](Napi::Env env)
+			{
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, load_result->result_code));
+				if (load_result->result_code != VOICEVOX_RESULT_OK)
+				{
+					obj.Set("failedIndex", Napi::Number::New(env, static_cast<double>(load_result->failed_index)));
+					return obj;
+				}
+				UserDictIndex &index = this->user_dict_indexes[user_dict_pointer_name];
+				if (index.size() == 0)
+					index.replace(std::move(load_result->index));
+				else
+					index.merge(load_result->index);
+				obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, load_result->word_uuids.data(), load_result->word_uuids.size()));
+				obj.Set("snapshotWordUuids", Napi::Buffer<uint8_t>::Copy(env, load_result->snapshot_word_uuids.data(), load_result->snapshot_word_uuids.size()));
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::voicevoxUserDictLoadAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_pointers.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
+	std::string dict_path = load_string(info, 1);
+	acquire_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+	struct LoadResult
+	{
+		VoicevoxResultCode result_code = VOICEVOX_RESULT_OK;
+		bool indexed = false;
+		uint64_t generation = 0;
+		UserDictIndex index;
+	};
+	auto load_result = std::make_shared<LoadResult>();
+	load_result->generation = this->user_dict_indexes[user_dict_pointer_name].generation();
+	return AsyncJob::Queue(
+			info,
+			[this, user_dict, dict_path, load_result]()
+			{
+				load_result->result_code = voicevox_user_dict_load_v0_16(this->dll, user_dict, dict_path.c_str());
+				if (load_result->result_code != VOICEVOX_RESULT_OK)
+					return;
+				// 索引もここで作っておき、メインスレッドでは差し替えるだけにする
+				char *output_json = nullptr;
+				if (voicevox_user_dict_to_json_v0_16(this->dll, user_dict, &output_json) != VOICEVOX_RESULT_OK)
+					return;
+				load_result->indexed = load_result->index.rebuild(output_json);
+				voicevox_json_free_v0_16(this->dll, output_json);
+			},
+			[this, user_dict_pointer_name]()
+			{
+				release_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+			},
+			[this, user_dict_pointer_name, load_result](Napi::Env env)
+			{
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, load_result->result_code));
+				if (load_result->result_code != VOICEVOX_RESULT_OK)
+					return obj;
+				UserDictIndex &index = this->user_dict_indexes[user_dict_pointer_name];
+				// 読み込み中に単語が追加・削除されていれば、作った索引には含まれないため作り直す
+				if (load_result->indexed && index.generation() == load_result->generation)
+					index.replace(std::move(load_result->index));
+				else if (!this->rebuild_user_dict_index(user_dict_pointer_name))
+					throw Napi::Error::New(env, "ユーザー辞書の索引を作れませんでした");
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::voicevoxUserDictSaveAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_pointers.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
+	std::string path = load_string(info, 1);
+	acquire_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+	auto result_code = std::make_shared<VoicevoxResultCode>(VOICEVOX_RESULT_OK);
+	return AsyncJob::Queue(
+			info,
+			[this, user_dict, path, result_code]()
+			{
+				// voicevox_coreには一時ファイルへ書かせ、書き終えてから置き換える(途中で落ちても元のファイルが残る)
+				std::string tmp = temporary_path(path);
+				*result_code = voicevox_user_dict_save_v0_16(this->dll, user_dict, tmp.c_str());
+				if (*result_code != VOICEVOX_RESULT_OK)
+				{
+					std::remove(tmp.c_str());
+					return;
+				}
+				std::string error;
+				if (!replace_file(tmp, path, error))
+					throw std::runtime_error(error);
+			},
+			[this, user_dict_pointer_name]()
+			{
+				release_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+			},
+			[result_code](Napi::Env env)
+			{
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, *result_code));
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::voicevoxUserDictImportAsyncV0_16(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	uint32_t user_dict_pointer_name = load_uint32_t(info, 0);
+	if (!this->user_dict_pointers.count(user_dict_pointer_name))
+	{
+		Napi::Error::New(env, "user_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const VoicevoxUserDict *user_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(user_dict_pointer_name));
+	uint32_t other_dict_pointer_name = load_uint32_t(info, 1);
+	if (!this->user_dict_pointers.count(other_dict_pointer_name))
+	{
+		Napi::Error::New(env, "other_dictのポインタが見つかりませんでした").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	const VoicevoxUserDict *other_dict = reinterpret_cast<const VoicevoxUserDict *>(this->user_dict_pointers.at(other_dict_pointer_name));
+	acquire_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+	acquire_in_flight(this->user_dict_in_flight, other_dict_pointer_name);
+	auto result_code = std::make_shared<VoicevoxResultCode>(VOICEVOX_RESULT_OK);
+	return AsyncJob::Queue(
+			info,
+			[this, user_dict, other_dict, result_code]()
+			{
+				*result_code = voicevox_user_dict_import_v0_16(this->dll, user_dict, other_dict);
+			},
+			[this, user_dict_pointer_name, other_dict_pointer_name]()
+			{
+				release_in_flight(this->user_dict_in_flight, user_dict_pointer_name);
+				release_in_flight(this->user_dict_in_flight, other_dict_pointer_name);
+			},
+			[this, user_dict_pointer_name, other_dict_pointer_name, result_code](Napi::Env env)
+			{
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("resultCode", Napi::Number::New(env, *result_code));
+				if (*result_code == VOICEVOX_RESULT_OK)
+					this->user_dict_indexes[user_dict_pointer_name].merge(this->user_dict_indexes[other_dict_pointer_name]);
+				return obj;
+			});
+}
+
 Napi::Value Voicevox::voicevoxInitializeV0_14(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
@@ -1034,7 +3240,8 @@ Napi::Value Voicevox::voicevoxInitializeV0_14(const Napi::CallbackInfo &info)
 	options.acceleration_mode = static_cast<VoicevoxAccelerationMode>(load_uint32_t(info, 0));
 	options.cpu_num_threads = static_cast<uint16_t>(load_uint32_t(info, 1));
 	options.load_all_models = load_bool(info, 2);
-	options.open_jtalk_dict_dir = load_string(info, 3);
+	std::string open_jtalk_dict_dir = load_string(info, 3);
+	options.open_jtalk_dict_dir = open_jtalk_dict_dir.c_str();
 	VoicevoxResultCode resultCode = voicevox_initialize_v0_14(this->dll, options);
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
@@ -1288,11 +3495,11 @@ Napi::Value Voicevox::voicevoxAudioQueryV0_14(const Napi::CallbackInfo &info)
 		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
 		return obj;
 	}
-	const char *text = load_string(info, 0);
+	std::string text = load_string(info, 0);
 	uint32_t speaker_id = load_uint32_t(info, 1);
 	options.kana = load_bool(info, 2);
 	char *output_audio_query_json;
-	VoicevoxResultCode resultCode = voicevox_audio_query_v0_14(this->dll, text, speaker_id, options, &output_audio_query_json);
+	VoicevoxResultCode resultCode = voicevox_audio_query_v0_14(this->dll, text.c_str(), speaker_id, options, &output_audio_query_json);
 	obj.Set("result", Napi::String::New(env, copy_str(output_audio_query_json)));
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	try
@@ -1321,11 +3528,11 @@ Napi::Value Voicevox::voicevoxAccentPhrasesV0_15(const Napi::CallbackInfo &info)
 		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
 		return obj;
 	}
-	const char *text = load_string(info, 0);
+	std::string text = load_string(info, 0);
 	uint32_t speaker_id = load_uint32_t(info, 1);
 	options.kana = load_bool(info, 2);
 	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_accent_phrases_v0_15(this->dll, text, speaker_id, options, &output_accent_phrases_json);
+	VoicevoxResultCode resultCode = voicevox_accent_phrases_v0_15(this->dll, text.c_str(), speaker_id, options, &output_accent_phrases_json);
 	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	try
@@ -1344,10 +3551,10 @@ Napi::Value Voicevox::voicevoxMoraLengthV0_15(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *accent_phrases_json = load_string(info, 0);
+	std::string accent_phrases_json = load_string(info, 0);
 	uint32_t speaker_id = load_uint32_t(info, 1);
 	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_mora_length_v0_15(this->dll, accent_phrases_json, speaker_id, &output_accent_phrases_json);
+	VoicevoxResultCode resultCode = voicevox_mora_length_v0_15(this->dll, accent_phrases_json.c_str(), speaker_id, &output_accent_phrases_json);
 	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	try
@@ -1366,10 +3573,10 @@ Napi::Value Voicevox::voicevoxMoraPitchV0_15(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *accent_phrases_json = load_string(info, 0);
+	std::string accent_phrases_json = load_string(info, 0);
 	uint32_t speaker_id = load_uint32_t(info, 1);
 	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_mora_pitch_v0_15(this->dll, accent_phrases_json, speaker_id, &output_accent_phrases_json);
+	VoicevoxResultCode resultCode = voicevox_mora_pitch_v0_15(this->dll, accent_phrases_json.c_str(), speaker_id, &output_accent_phrases_json);
 	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	try
@@ -1388,10 +3595,10 @@ Napi::Value Voicevox::voicevoxMoraDataV0_15(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *accent_phrases_json = load_string(info, 0);
+	std::string accent_phrases_json = load_string(info, 0);
 	uint32_t speaker_id = load_uint32_t(info, 1);
 	char *output_accent_phrases_json;
-	VoicevoxResultCode resultCode = voicevox_mora_data_v0_15(this->dll, accent_phrases_json, speaker_id, &output_accent_phrases_json);
+	VoicevoxResultCode resultCode = voicevox_mora_data_v0_15(this->dll, accent_phrases_json.c_str(), speaker_id, &output_accent_phrases_json);
 	obj.Set("result", Napi::String::New(env, copy_str(output_accent_phrases_json)));
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	try
@@ -1420,13 +3627,25 @@ Napi::Value Voicevox::voicevoxSynthesisV0_14(const Napi::CallbackInfo &info)
 		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
 		return obj;
 	}
-	const char *audio_query_json = load_string(info, 0);
+	std::string audio_query_json = load_string(info, 0);
 	uint32_t speaker_id = load_uint32_t(info, 1);
 	options.enable_interrogative_upspeak = load_bool(info, 2);
-	uintptr_t output_wav_length;
-	uint8_t *output_wav;
-	VoicevoxResultCode resultCode = voicevox_synthesis_v0_14(this->dll, audio_query_json, speaker_id, options, &output_wav_length, &output_wav);
+	uintptr_t output_wav_length = 0;
+	uint8_t *output_wav = nullptr;
+	VoicevoxResultCode resultCode = voicevox_synthesis_v0_14(this->dll, audio_query_json.c_str(), speaker_id, options, &output_wav_length, &output_wav);
 	obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_wav, output_wav_length));
+	if (output_wav != nullptr)
+	{
+		try
+		{
+			voicevox_wav_free_v0_12(this->dll, output_wav);
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -1445,14 +3664,26 @@ Napi::Value Voicevox::voicevoxTtsV0_14(const Napi::CallbackInfo &info)
 		Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
 		return obj;
 	}
-	const char *text = load_string(info, 0);
+	std::string text = load_string(info, 0);
 	uint32_t speaker_id = load_uint32_t(info, 1);
 	options.enable_interrogative_upspeak = load_bool(info, 2);
 	options.kana = load_bool(info, 3);
-	uintptr_t output_wav_length;
-	uint8_t *output_wav;
-	VoicevoxResultCode resultCode = voicevox_tts_v0_14(this->dll, text, speaker_id, options, &output_wav_length, &output_wav);
+	uintptr_t output_wav_length = 0;
+	uint8_t *output_wav = nullptr;
+	VoicevoxResultCode resultCode = voicevox_tts_v0_14(this->dll, text.c_str(), speaker_id, options, &output_wav_length, &output_wav);
 	obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_wav, output_wav_length));
+	if (output_wav != nullptr)
+	{
+		try
+		{
+			voicevox_wav_free_v0_12(this->dll, output_wav);
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -1723,8 +3954,8 @@ Napi::Value Voicevox::voicevoxLoadOpenjtalkDictV0_12(const Napi::CallbackInfo &i
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *dict_path = load_string(info, 0);
-	VoicevoxResultCode resultCode = voicevox_load_openjtalk_dict_v0_12(this->dll, dict_path);
+	std::string dict_path = load_string(info, 0);
+	VoicevoxResultCode resultCode = voicevox_load_openjtalk_dict_v0_12(this->dll, dict_path.c_str());
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -1733,12 +3964,24 @@ Napi::Value Voicevox::voicevoxTtsV0_12(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *text = load_string(info, 0);
+	std::string text = load_string(info, 0);
 	int64_t speaker_id = static_cast<int64_t>(load_uint32_t(info, 1));
-	int output_binary_size;
-	uint8_t *output_wav;
-	VoicevoxResultCode resultCode = voicevox_tts_v0_12(this->dll, text, speaker_id, &output_binary_size, &output_wav);
+	int output_binary_size = 0;
+	uint8_t *output_wav = nullptr;
+	VoicevoxResultCode resultCode = voicevox_tts_v0_12(this->dll, text.c_str(), speaker_id, &output_binary_size, &output_wav);
 	obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_wav, output_binary_size));
+	if (output_wav != nullptr)
+	{
+		try
+		{
+			voicevox_wav_free_v0_12(this->dll, output_wav);
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -1747,12 +3990,24 @@ Napi::Value Voicevox::voicevoxTtsFromKanaV0_12(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *text = load_string(info, 0);
+	std::string text = load_string(info, 0);
 	int64_t speaker_id = static_cast<int64_t>(load_uint32_t(info, 1));
-	int output_binary_size;
-	uint8_t *output_wav;
-	VoicevoxResultCode resultCode = voicevox_tts_from_kana_v0_12(this->dll, text, speaker_id, &output_binary_size, &output_wav);
+	int output_binary_size = 0;
+	uint8_t *output_wav = nullptr;
+	VoicevoxResultCode resultCode = voicevox_tts_from_kana_v0_12(this->dll, text.c_str(), speaker_id, &output_binary_size, &output_wav);
 	obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, output_wav, output_binary_size));
+	if (output_wav != nullptr)
+	{
+		try
+		{
+			voicevox_wav_free_v0_12(this->dll, output_wav);
+		}
+		catch (const std::exception &e)
+		{
+			Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+			return obj;
+		}
+	}
 	obj.Set("resultCode", Napi::Number::New(env, resultCode));
 	return obj;
 }
@@ -1761,13 +4016,13 @@ Napi::Value Voicevox::initializeV0_10(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *root_dir_path = load_string(info, 0);
+	std::string root_dir_path = load_string(info, 0);
 	bool use_gpu = load_bool(info, 1);
 	int cpu_num_threads = static_cast<int>(load_uint32_t(info, 2));
 	bool result;
 	try
 	{
-		result = initialize_v0_10(this->dll, root_dir_path, use_gpu, cpu_num_threads);
+		result = initialize_v0_10(this->dll, root_dir_path.c_str(), use_gpu, cpu_num_threads);
 	}
 	catch (const std::exception &e)
 	{
@@ -1782,12 +4037,12 @@ Napi::Value Voicevox::initializeV0_5(const Napi::CallbackInfo &info)
 {
 	Napi::Env env = info.Env();
 	Napi::Object obj = Napi::Object::New(env);
-	const char *root_dir_path = load_string(info, 0);
+	std::string root_dir_path = load_string(info, 0);
 	bool use_gpu = load_bool(info, 1);
 	bool result;
 	try
 	{
-		result = initialize_v0_5(this->dll, root_dir_path, use_gpu);
+		result = initialize_v0_5(this->dll, root_dir_path.c_str(), use_gpu);
 	}
 	catch (const std::exception &e)
 	{
@@ -1930,3 +4185,209 @@ Napi::Value Voicevox::decodeForwardV0_5(const Napi::CallbackInfo &info)
 	obj.Set("result2", Napi::Boolean::New(env, result));
 	return obj;
 }
+
+Napi::Value Voicevox::nativeHeapUsage(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	// mallocで確保されている(coreの確保分も含む)バイト数。取得できない環境では-1
+	double result = -1;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 mi = mallinfo2();
+	result = static_cast<double>(mi.uordblks + mi.hblkhd);
+#elif defined(__GLIBC__)
+	struct mallinfo mi = mallinfo();
+	result = static_cast<double>(static_cast<unsigned int>(mi.uordblks) + static_cast<unsigned int>(mi.hblkhd));
+#elif defined(__APPLE__)
+	malloc_statistics_t stats;
+	malloc_zone_statistics(NULL, &stats);
+	result = static_cast<double>(stats.size_in_use);
+#endif
+	obj.Set("result", Napi::Number::New(env, result));
+	return obj;
+}
+
+Napi::Value Voicevox::resamplePcmAsync(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Buffer<uint8_t> pcm = info[0].As<Napi::Buffer<uint8_t>>();
+	uint32_t input_rate = load_uint32_t(info, 1);
+	uint32_t output_rate = load_uint32_t(info, 2);
+	uint32_t channels = load_uint32_t(info, 3);
+	if (channels == 0 || channels > 0xffff || pcm.Length() % (2 * channels) != 0)
+	{
+		Napi::Error::New(env, "PCMの長さがチャンネル数と合いません").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	std::shared_ptr<const Resampler> resampler = Resampler::get(input_rate, output_rate);
+	if (!resampler)
+	{
+		Napi::Error::New(env, "対応していないサンプリングレートの組です").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
+	// Bufferはワーカースレッドから触れないため写しておく
+	auto samples = std::make_shared<std::vector<int16_t>>(pcm.Length() / 2);
+	std::memcpy(samples->data(), pcm.Data(), pcm.Length());
+	auto resampled = std::make_shared<std::vector<int16_t>>();
+	return AsyncJob::Queue(
+			info,
+			[resampler, samples, channels, resampled]()
+			{
+				size_t frames = samples->size() / channels;
+				resampled->resize(resampler->output_frames(frames) * channels);
+				resampler->process(samples->data(), frames, static_cast<uint16_t>(channels), resampled->data());
+			},
+			[]() {},
+			[resampled](Napi::Env env)
+			{
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, reinterpret_cast<const uint8_t *>(resampled->data()), resampled->size() * 2));
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::resampleWavAsync(const Napi::CallbackInfo &info)
+{
+	Napi::Buffer<uint8_t> wav = info[0].As<Napi::Buffer<uint8_t>>();
+	uint32_t output_rate = load_uint32_t(info, 1);
+	auto input = std::make_shared<std::vector<uint8_t>>(wav.Data(), wav.Data() + wav.Length());
+	auto resampled = std::make_shared<std::vector<uint8_t>>();
+	return AsyncJob::Queue(
+			info,
+			[input, output_rate, resampled]()
+			{
+				std::string error;
+				if (!resample_wav(input->data(), input->size(), output_rate, *resampled, error))
+					throw std::runtime_error(error);
+			},
+			[]() {},
+			[resampled](Napi::Env env)
+			{
+				Napi::Object obj = Napi::Object::New(env);
+				obj.Set("result", Napi::Buffer<uint8_t>::Copy(env, resampled->data(), resampled->size()));
+				return obj;
+			});
+}
+
+Napi::Value Voicevox::captureStart(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	std::string path = load_string(info, 0);
+	size_t max_queue_bytes = static_cast<size_t>(info[1].As<Napi::Number>().DoubleValue());
+	std::string error;
+	if (!this->capture.start(path, max_queue_bytes, error))
+	{
+		Napi::Error::New(env, error).ThrowAsJavaScriptException();
+		return obj;
+	}
+	return obj;
+}
+
+Napi::Value Voicevox::captureStop(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	CaptureStats stats = this->capture.stop();
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("recorded", Napi::Number::New(env, static_cast<double>(stats.recorded)));
+	result.Set("dropped", Napi::Number::New(env, static_cast<double>(stats.dropped)));
+	result.Set("writtenBytes", Napi::Number::New(env, static_cast<double>(stats.written_bytes)));
+	obj.Set("result", result);
+	return obj;
+}
+
+Napi::Value Voicevox::perfCountersEnable(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	bool enabled = load_bool(info, 0);
+	obj.Set("result", Napi::Boolean::New(env, this->perf.enable(enabled)));
+	return obj;
+}
+
+Napi::Value Voicevox::accentPhraseCacheSetCapacity(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	this->accent_phrase_cache.set_capacity(load_uint32_t(info, 0));
+	return obj;
+}
+
+Napi::Value Voicevox::kanaCacheSetCapacity(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	this->kana_cache.set_capacity(load_uint32_t(info, 0));
+	return obj;
+}
+
+Napi::Value Voicevox::bufferPoolSetCapacity(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	this->buffer_pool->set_capacity(load_uint32_t(info, 0));
+	return obj;
+}
+
+Napi::Value Voicevox::bufferPoolRelease(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	obj.Set("result", Napi::Boolean::New(env, this->buffer_pool->release(info[0].As<Napi::Buffer<uint8_t>>())));
+	return obj;
+}
+
+Napi::Value Voicevox::getStats(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	Napi::Object obj = Napi::Object::New(env);
+	Napi::Object result = Napi::Object::New(env);
+	Napi::Object perf = Napi::Object::New(env);
+	Napi::Object bindings = Napi::Object::New(env);
+	for (const auto &entry : this->perf.totals())
+	{
+		const PerfTotals &totals = entry.second;
+		Napi::Object binding = Napi::Object::New(env);
+		binding.Set("calls", Napi::Number::New(env, static_cast<double>(totals.calls)));
+		binding.Set("counterCalls", Napi::Number::New(env, static_cast<double>(totals.counter_calls)));
+		binding.Set("wallNs", Napi::Number::New(env, static_cast<double>(totals.wall_ns)));
+		binding.Set("cycles", Napi::Number::New(env, static_cast<double>(totals.cycles)));
+		binding.Set("instructions", Napi::Number::New(env, static_cast<double>(totals.instructions)));
+		binding.Set("cacheMisses", Napi::Number::New(env, static_cast<double>(totals.cache_misses)));
+		binding.Set("contextSwitches", Napi::Number::New(env, static_cast<double>(totals.context_switches)));
+		bindings.Set(entry.first, binding);
+	}
+	perf.Set("enabled", Napi::Boolean::New(env, this->perf.enabled()));
+	perf.Set("bindings", bindings);
+	result.Set("perf", perf);
+	Napi::Object accent_phrase_cache = Napi::Object::New(env);
+	accent_phrase_cache.Set("capacity", Napi::Number::New(env, static_cast<double>(this->accent_phrase_cache.capacity())));
+	accent_phrase_cache.Set("entries", Napi::Number::New(env, static_cast<double>(this->accent_phrase_cache.size())));
+	accent_phrase_cache.Set("hits", Napi::Number::New(env, static_cast<double>(this->accent_phrase_cache.hits())));
+	accent_phrase_cache.Set("misses", Napi::Number::New(env, static_cast<double>(this->accent_phrase_cache.misses())));
+	accent_phrase_cache.Set("evictions", Napi::Number::New(env, static_cast<double>(this->accent_phrase_cache.evictions())));
+	result.Set("accentPhraseCache", accent_phrase_cache);
+	Napi::Object kana_cache = Napi::Object::New(env);
+	kana_cache.Set("capacity", Napi::Number::New(env, static_cast<double>(this->kana_cache.capacity())));
+	kana_cache.Set("entries", Napi::Number::New(env, static_cast<double>(this->kana_cache.size())));
+	kana_cache.Set("hits", Napi::Number::New(env, static_cast<double>(this->kana_cache.hits())));
+	kana_cache.Set("misses", Napi::Number::New(env, static_cast<double>(this->kana_cache.misses())));
+	kana_cache.Set("evictions", Napi::Number::New(env, static_cast<double>(this->kana_cache.evictions())));
+	kana_cache.Set("savedNs", Napi::Number::New(env, static_cast<double>(this->kana_cache_saved_ns)));
+	result.Set("kanaCache", kana_cache);
+	BufferPoolStats buffer_pool_stats = this->buffer_pool->stats();
+	Napi::Object buffer_pool = Napi::Object::New(env);
+	buffer_pool.Set("capacity", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.capacity)));
+	buffer_pool.Set("idleBytes", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.idle_bytes)));
+	buffer_pool.Set("idleSlabs", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.idle_slabs)));
+	buffer_pool.Set("outstandingBytes", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.outstanding_bytes)));
+	buffer_pool.Set("outstandingSlabs", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.outstanding_slabs)));
+	buffer_pool.Set("hits", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.hits)));
+	buffer_pool.Set("misses", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.misses)));
+	buffer_pool.Set("oversize", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.oversize)));
+	buffer_pool.Set("released", Napi::Number::New(env, static_cast<double>(buffer_pool_stats.released)));
+	result.Set("bufferPool", buffer_pool);
+	obj.Set("result", result);
+	return obj;
+}
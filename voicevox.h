@@ -3,7 +3,41 @@
 
 #include <napi.h>
 #include "voicevox_core.h"
+#include "capture.h"
+#include "perf_counters.h"
+#include "user_dict_index.h"
+#include "lru_cache.h"
+#include "audio_query.h"
+#include "pcm_stream.h"
+#include "buffer_pool.h"
 #include <map>
+#include <unordered_set>
+
+// テキスト解析の結果を保持する件数の既定値
+#define ACCENT_PHRASE_CACHE_DEFAULT_CAPACITY 1024
+
+// voicevoxSynthesizerAudioQueryReplaceV0_16で作り直す値
+#define AUDIO_QUERY_REPLACE_MORA_DATA 0
+#define AUDIO_QUERY_REPLACE_PHONEME_LENGTH 1
+#define AUDIO_QUERY_REPLACE_MORA_PITCH 2
+
+struct AccentPhraseCacheEntry
+{
+  /** 最初に作ったときのスタイルでのアクセント句のJSON(`replace_mora_data`で別のスタイルに置き換えて使う) */
+  std::string accent_phrases;
+  /** AudioQueryのJSONのうち、`accent_phrases`の値より後ろの部分。アクセント句だけを作った場合は空 */
+  std::string audio_query_rest;
+  /** テキストからのAudioQueryの作成にかかった時間(`audio_query_rest`がある場合のみ) */
+  uint64_t text_query_ns;
+};
+
+struct KanaCacheEntry
+{
+  /** AudioQueryの`kana`(AquesTalk風記法) */
+  std::string kana;
+  /** 記録したときの、テキストからのAudioQueryの作成にかかった時間 */
+  uint64_t text_query_ns;
+};
 
 class Voicevox : public Napi::ObjectWrap<Voicevox>
 {
@@ -16,6 +50,8 @@ public:
 
   Napi::Value voicevoxOpenJtalkRcNewV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxOpenJtalkRcUseUserDictV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxOpenJtalkRcNewAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxOpenJtalkRcUseUserDictAsyncV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxOpenJtalkRcDeleteV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxGetVersionV0_14(const Napi::CallbackInfo &info);
   Napi::Value voicevoxVoiceModelNewFromPathV0_16(const Napi::CallbackInfo &info);
@@ -24,6 +60,7 @@ public:
   Napi::Value voicevoxVoiceModelDeleteV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxSynthesizerNewV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxSynthesizerDeleteV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerSwapOpenJtalkAsyncV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxSynthesizerLoadVoiceModelV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxSynthesizerUnloadVoiceModelV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxSynthesizerIsGpuModeV0_16(const Napi::CallbackInfo &info);
@@ -40,16 +77,43 @@ public:
   Napi::Value voicevoxSynthesizerSynthesisV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxSynthesizerTtsFromKanaV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxSynthesizerTtsV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerTtsAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQueryNewV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerCreateAudioQueryHandleV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQueryToJsonV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQueryGetMorasV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQuerySetMoraPitchV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQuerySetMoraLengthV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQuerySetPitchesV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQuerySetScaleV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerAudioQueryReplaceV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerSynthesisFramesAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerSynthesisToFileAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerSynthesisToFdAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxSynthesizerSynthesisStreamV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxPcmStreamReadV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxPcmStreamDeleteV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxAudioQueryDeleteV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxErrorResultToMessageV0_12(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictNewV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictLoadV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictAddWordV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictAddWordsAsyncV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictUpdateWordV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictRemoveWordV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictToJsonV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictImportV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictSaveV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxUserDictDeleteV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictFindWordV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictFindWordsBySurfaceV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictFindWordsByPrefixV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictSaveSnapshotAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictLoadSnapshotAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictLoadAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictSaveAsyncV0_16(const Napi::CallbackInfo &info);
+  Napi::Value voicevoxUserDictImportAsyncV0_16(const Napi::CallbackInfo &info);
   Napi::Value voicevoxInitializeV0_14(const Napi::CallbackInfo &info);
   Napi::Value voicevoxLoadModelV0_14(const Napi::CallbackInfo &info);
   Napi::Value voicevoxIsGpuModeV0_14(const Napi::CallbackInfo &info);
@@ -85,13 +149,68 @@ public:
   Napi::Value yukarinSForwardV0_5(const Napi::CallbackInfo &info);
   Napi::Value yukarinSaForwardV0_5(const Napi::CallbackInfo &info);
   Napi::Value decodeForwardV0_5(const Napi::CallbackInfo &info);
+  Napi::Value nativeHeapUsage(const Napi::CallbackInfo &info);
+  Napi::Value captureStart(const Napi::CallbackInfo &info);
+  Napi::Value captureStop(const Napi::CallbackInfo &info);
+  Napi::Value perfCountersEnable(const Napi::CallbackInfo &info);
+  Napi::Value getStats(const Napi::CallbackInfo &info);
+  Napi::Value accentPhraseCacheSetCapacity(const Napi::CallbackInfo &info);
+  Napi::Value kanaCacheSetCapacity(const Napi::CallbackInfo &info);
+  Napi::Value bufferPoolSetCapacity(const Napi::CallbackInfo &info);
+  Napi::Value bufferPoolRelease(const Napi::CallbackInfo &info);
+  Napi::Value resamplePcmAsync(const Napi::CallbackInfo &info);
+  Napi::Value resampleWavAsync(const Napi::CallbackInfo &info);
 
 private:
+  void acquire_synthesizer(uintptr_t synthesizer);
+  void release_synthesizer(uintptr_t synthesizer);
+  void retire_synthesizer(uintptr_t synthesizer);
+  bool rebuild_user_dict_index(uint32_t user_dict_pointer_name);
+  std::string text_analysis_cache_key(uint32_t synthesizer_pointer_name, const std::string &text);
+  const KanaCacheEntry *find_kana(uint32_t synthesizer_pointer_name, const std::string &text);
+  VoicevoxResultCode create_audio_query_json(uint32_t synthesizer_pointer_name, const std::string &text, VoicevoxStyleId style_id, std::string &audio_query_json);
+
   DLL dll;
   std::unordered_map<uint32_t, uintptr_t> open_jtalk_pointers;
   std::unordered_map<uint32_t, uintptr_t> user_dict_pointers;
   std::unordered_map<uint32_t, uintptr_t> model_pointers;
   std::unordered_map<uint32_t, uintptr_t> synthesizer_pointers;
+  // ネイティブ側で保持するAudioQuery(JSにはポインタ名だけを渡す)
+  std::unordered_map<uint32_t, AudioQuery> audio_queries;
+  // 読み出し中のストリーム。破棄しても書き込みスレッドが終わるまでは生存する
+  std::unordered_map<uint32_t, std::shared_ptr<PcmStream>> pcm_streams;
+  // user_dict_pointersと同じポインタ名で、その辞書の単語の索引
+  std::unordered_map<uint32_t, UserDictIndex> user_dict_indexes;
+  // 非同期ジョブが使用中のポインタ名と、その数
+  std::unordered_map<uint32_t, uint32_t> open_jtalk_in_flight;
+  std::unordered_map<uint32_t, uint32_t> user_dict_in_flight;
+  std::unordered_map<uint32_t, uint32_t> synthesizer_swap_in_flight;
+  // シンセサイザはポインタ名の指す先が切り替わるため、ポインタそのもので数える
+  std::unordered_map<uintptr_t, uint32_t> synthesizer_in_flight;
+  // 解放・切り替え済みだが、非同期ジョブの完了を待っているシンセサイザ
+  std::unordered_set<uintptr_t> retired_synthesizers;
+  std::unordered_map<uint32_t, VoicevoxInitializeOptions> synthesizer_options;
+  // シンセサイザのポインタ名 -> そのシンセサイザが使っているOpenJtalkRcのポインタ名
+  std::unordered_map<uint32_t, uint32_t> synthesizer_open_jtalks;
+  // 音声モデルのポインタ名 -> 開いたファイルのパス
+  std::unordered_map<uint32_t, std::string> model_paths;
+  // シンセサイザのポインタ名 -> 読み込んだ音声モデルのID -> そのファイルのパス。
+  // OpenJtalkRcの切り替え時は、音声モデルを既に閉じていてもここから開き直して読み込む
+  std::unordered_map<uint32_t, std::map<std::string, std::string>> synthesizer_model_paths;
+  // OpenJtalkRcのポインタ名 -> 作成・ユーザー辞書の設定ごとに`open_jtalk_revision_counter`から取る番号。テキスト解析の結果はこれが同じ間だけ使い回せる。
+  // 番号は全てのOpenJtalkRcで重ならないため、破棄したポインタ名が使い回されても以前の解析結果とは一致しない
+  std::unordered_map<uint32_t, uint64_t> open_jtalk_revisions;
+  uint64_t open_jtalk_revision_counter = 0;
+  // テキスト解析の結果(スタイルに依らないアクセント句)。キーは`text_analysis_cache_key`
+  LruCache<AccentPhraseCacheEntry> accent_phrase_cache;
+  // テキスト -> AquesTalk風記法。上限が0(既定)の間は使わない。キーは`text_analysis_cache_key`
+  LruCache<KanaCacheEntry> kana_cache;
+  // kana_cacheを使ったことで省けたと見積もられる時間の合計
+  uint64_t kana_cache_saved_ns = 0;
+  // 合成結果のBufferの領域。上限が0(既定)の間は使い回さない
+  std::shared_ptr<BufferPool> buffer_pool = std::make_shared<BufferPool>();
+  Capture capture;
+  PerfCounters perf;
 };
 
 #endif
\ No newline at end of file
@@ -283,7 +283,7 @@ void voicevox_json_free_v0_16(DLL &dll,
 void voicevox_wav_free_v0_12(DLL &dll,
                              uint8_t *wav)
 {
-  return load_func<void (*)(uint8_t *)>(dll, "voicevox_json_free")(wav);
+  return load_func<void (*)(uint8_t *)>(dll, "voicevox_wav_free")(wav);
 }
 
 const char *voicevox_error_result_to_message_v0_12(DLL &dll,
@@ -87,6 +87,38 @@ export declare class VoicevoxCore {
    */
   voicevoxOpenJtalkRcUseUserDictV0_16(openJtalkPointerName: number, userDictPointerName: number): ResultCodeV0_16;
 
+  /**
+   * `voicevoxOpenJtalkRcNewV0_16`をスレッドプールで実行する。辞書の読み込み中もイベントループを止めない。
+   *
+   * ポインタは成功した場合のみ設定され、完了するまでは他の関数から使えない。
+   *
+   * @param {string} openJtalkDicDir 辞書ディレクトリを指すUTF-8のパス
+   * @param {number} openJtalkPointerName Open JTalkポインタ名
+   * @returns 結果コード
+   *
+   * \safety{
+   *  - `openJtalkPointerName`は他の`OpenJtalkRc`とかぶってはいけない(実行中のものを含む)。かぶった場合は例外が発生する。
+   *
+   * }
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxOpenJtalkRcNewAsyncV0_16(openJtalkDicDir: string, openJtalkPointerName: number): Promise<ResultCodeV0_16>;
+
+  /**
+   * `voicevoxOpenJtalkRcUseUserDictV0_16`をスレッドプールで実行する。辞書の再構築中もイベントループを止めない。
+   *
+   * 完了するまで、`openJtalkPointerName`と`userDictPointerName`は解放できない(`voicevoxOpenJtalkRcDeleteV0_16`などが例外を発生する)。
+   * 実行中に同じOpenJtalkRcを使う合成系の関数を呼び出してもよい(voicevox_core側で排他される)。
+   *
+   * @param {number} openJtalkPointerName Open JTalkポインタ名
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @returns 結果コード
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxOpenJtalkRcUseUserDictAsyncV0_16(openJtalkPointerName: number, userDictPointerName: number): Promise<ResultCodeV0_16>;
+
   /**
    * OpenJtalkRc を<b>破棄</b>(_destruct_)する。
    *
@@ -201,6 +233,9 @@ export declare class VoicevoxCore {
   /**
    * VoicevoxSynthesizer を<b>破棄</b>(_destruct_)する。
    *
+   * `voicevoxSynthesizerTtsAsyncV0_16`の実行中であれば、ポインタ名はすぐに使えなくなり、シンセサイザ自体は実行中のものが全て完了した時点で破棄される。
+   * `voicevoxSynthesizerSwapOpenJtalkAsyncV0_16`の実行中は例外を発生する。
+   *
    * @param {number} synthesizerPointerName 破棄対象音声シンセサイザポインタ名
    *
    * \safety{
@@ -212,9 +247,36 @@ export declare class VoicevoxCore {
    */
   voicevoxSynthesizerDeleteV0_16(synthesizerPointerName: number): {};
 
+  /**
+   * 音声シンセサイザの使うOpenJtalkRcを切り替える。ユーザー辞書を反映したOpenJtalkRcに切り替えることで、合成を止めずに辞書を更新できる。
+   *
+   * 新しいOpenJtalkRcで音声シンセサイザを作り直し、今の音声シンセサイザに`voicevoxSynthesizerLoadVoiceModelV0_16`で読み込んだ音声モデルを全て読み込む。これらはスレッドプールで行う。
+   * 音声モデルは読み込んだときのファイルから開き直すため、`voicevoxVoiceModelDeleteV0_16`で閉じていてもよい(ファイルは残しておくこと)。
+   * 成功した場合は、完了時に`synthesizerPointerName`の指す先を新しい音声シンセサイザに差し替え、古い音声シンセサイザを破棄する。
+   * 古い音声シンセサイザで`voicevoxSynthesizerTtsAsyncV0_16`を実行中であれば、それらが全て完了した時点で破棄する。
+   * 失敗した場合は何も変わらない。
+   *
+   * 完了するまで、`synthesizerPointerName`と`openJtalkPointerName`は解放できず、`synthesizerPointerName`への音声モデルの読み込み・解除もできない(`voicevoxSynthesizerDeleteV0_16`・`voicevoxSynthesizerLoadVoiceModelV0_16`などが例外を発生する)。
+   * 音声モデルは古いものと新しいものの両方に読み込まれるため、完了するまで音声モデルのメモリが2倍になる。また、切り替えのたびに全ての音声モデルをファイルから読み込む時間がかかる。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {number} openJtalkPointerName 新しく使うOpen JTalkポインタ名
+   * @returns 結果コード
+   *
+   * \safety{
+   * - `synthesizerPointerName`は`voicevoxSynthesizerNewV0_16`で設定したものでなければならず、また`voicevoxSynthesizerDeleteV0_16`で解放されていてはいけない。
+   *
+   * }
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerSwapOpenJtalkAsyncV0_16(synthesizerPointerName: number, openJtalkPointerName: number): Promise<ResultCodeV0_16>;
+
   /**
    * 音声モデルを読み込む。
    *
+   * `voicevoxSynthesizerSwapOpenJtalkAsyncV0_16`の実行中は例外を発生する。
+   *
    * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
    * @param {number} modelPointerName 音声モデルポインタ名
    *
@@ -233,6 +295,8 @@ export declare class VoicevoxCore {
   /**
    * 音声モデルの読み込みを解除する。
    *
+   * `voicevoxSynthesizerSwapOpenJtalkAsyncV0_16`の実行中は例外を発生する。
+   *
    * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
    * @param {string} modelId 音声モデルID
    *
@@ -341,7 +405,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerCreateAudioQueryFromKanaV0_16(synthesizerPointerName: number, kana: string, styleId: number): ResultCodeV0_16 & Result<string>;
+  voicevoxSynthesizerCreateAudioQueryFromKanaV0_16(synthesizerPointerName: number, kana: string, styleId: number): ResultCodeV0_16 & Result<string> & PerfResult;
 
   /**
    * 日本語テキストから、AudioQueryをJSONとして生成する。
@@ -369,7 +433,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerCreateAudioQueryV0_16(synthesizerPointerName: number, text: string, styleId: number): ResultCodeV0_16 & Result<string>;
+  voicevoxSynthesizerCreateAudioQueryV0_16(synthesizerPointerName: number, text: string, styleId: number): ResultCodeV0_16 & Result<string> & PerfResult;
 
   /**
    * AquesTalk風記法から、AccentPhrase (アクセント句)の配列をJSON形式で生成する。
@@ -397,7 +461,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerCreateAccentPhrasesFromKanaV0_16(synthesizerPointerName: number, kana: string, styleId: number): ResultCodeV0_16 & Result<string>;
+  voicevoxSynthesizerCreateAccentPhrasesFromKanaV0_16(synthesizerPointerName: number, kana: string, styleId: number): ResultCodeV0_16 & Result<string> & PerfResult;
 
   /**
    * 日本語テキストから、AccentPhrase (アクセント句)の配列をJSON形式で生成する。
@@ -425,7 +489,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerCreateAccentPhrasesV0_16(synthesizerPointerName: number, text: string, styleId: number): ResultCodeV0_16 & Result<string>;
+  voicevoxSynthesizerCreateAccentPhrasesV0_16(synthesizerPointerName: number, text: string, styleId: number): ResultCodeV0_16 & Result<string> & PerfResult;
 
   /**
    * AccentPhraseの配列の音高・音素長を、特定の声で生成しなおす。
@@ -443,7 +507,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerReplaceMoraDataV0_16(synthesizerPointerName: number, accentPhrasesJson: string, styleId: number): ResultCodeV0_16 & Result<string>;
+  voicevoxSynthesizerReplaceMoraDataV0_16(synthesizerPointerName: number, accentPhrasesJson: string, styleId: number): ResultCodeV0_16 & Result<string> & PerfResult;
 
   /**
    * AccentPhraseの配列の音素長を、特定の声で生成しなおす。
@@ -461,7 +525,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerReplacePhonemeLengthV0_16(synthesizerPointerName: number, accentPhrasesJson: string, styleId: number): ResultCodeV0_16 & Result<string>;
+  voicevoxSynthesizerReplacePhonemeLengthV0_16(synthesizerPointerName: number, accentPhrasesJson: string, styleId: number): ResultCodeV0_16 & Result<string> & PerfResult;
 
   /**
    * AccentPhraseの配列の音高を、特定の声で生成しなおす。
@@ -479,7 +543,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerReplaceMoraPitchV0_16(synthesizerPointerName: number, accentPhrasesJson: string, styleId: number): ResultCodeV0_16 & Result<string>;
+  voicevoxSynthesizerReplaceMoraPitchV0_16(synthesizerPointerName: number, accentPhrasesJson: string, styleId: number): ResultCodeV0_16 & Result<string> & PerfResult;
 
   /**
    * AudioQueryから音声合成を行う。
@@ -498,7 +562,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerSynthesisV0_16(synthesizerPointerName: number, audioQueryJson: string, styleId: number, enableInterrogativeUpspeak: boolean): ResultCodeV0_16 & Result<Buffer>;
+  voicevoxSynthesizerSynthesisV0_16(synthesizerPointerName: number, audioQueryJson: string, styleId: number, enableInterrogativeUpspeak: boolean): ResultCodeV0_16 & Result<Buffer> & PerfResult;
 
   /**
    * AquesTalk風記法から音声合成を行う。
@@ -517,7 +581,7 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerTtsFromKanaV0_16(synthesizerPointerName: number, kana: string, styleId: number, enableInterrogativeUpspeak: boolean): ResultCodeV0_16 & Result<Buffer>;
+  voicevoxSynthesizerTtsFromKanaV0_16(synthesizerPointerName: number, kana: string, styleId: number, enableInterrogativeUpspeak: boolean): ResultCodeV0_16 & Result<Buffer> & PerfResult;
 
   /**
    * 日本語テキストから音声合成を行う。
@@ -536,7 +600,336 @@ export declare class VoicevoxCore {
    *
    * この関数はv0.16.xで利用できます
    */
-  voicevoxSynthesizerTtsV0_16(synthesizerPointerName: number, text: string, styleId: number, enableInterrogativeUpspeak: boolean): ResultCodeV0_16 & Result<Buffer>;
+  voicevoxSynthesizerTtsV0_16(synthesizerPointerName: number, text: string, styleId: number, enableInterrogativeUpspeak: boolean): ResultCodeV0_16 & Result<Buffer> & PerfResult;
+
+  /**
+   * `voicevoxSynthesizerTtsV0_16`をスレッドプールで実行する。
+   *
+   * 呼び出した時点で`synthesizerPointerName`が指している音声シンセサイザを使う。実行中に`voicevoxSynthesizerSwapOpenJtalkAsyncV0_16`で切り替わっても影響を受けない。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {string} text UTF-8の日本語テキスト
+   * @param {number} styleId スタイルID
+   * @param {boolean} enableInterrogativeUpspeak 疑問文の調整を有効にする
+   * @param {number} outputSamplingRate 0以外を指定すると、合成したWAVをワーカースレッドでこのサンプリングレートに変換してから返す(`resampleWavAsync`と同じ)
+   * @param {number} outputFormat 0: WAV, 1: G.711 μ-law, 2: G.711 A-law, 3: ヘッダの無い16ビットリニアPCM, 4: 大きさの欄が長さ未定(0xFFFFFFFF)のWAV。G.711ではヘッダの無いモノラルのバイト列を返し、`outputSamplingRate`が0なら8000Hzとする
+   * @param {number} targetLoudness 指定すると、ラウドネス(LUFS、-70から0)をこの値に揃える(EBU R128のIntegrated Loudnessを測り、利得と-1dBFSのピークリミッタをかける)
+   * @param {AudioPostProcess} postProcess 後処理(無音の切り詰め・フェード・無音の追加)。出力形式の変換と同じ1回の走査で、切り詰め→サンプリングレートの変換→正規化→フェード→無音の追加の順にかける
+   *
+   * @returns 結果コード, WAVデータ(`outputFormat`がG.711の場合はそのバイト列)
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerTtsAsyncV0_16(synthesizerPointerName: number, text: string, styleId: number, enableInterrogativeUpspeak: boolean, outputSamplingRate?: number, outputFormat?: number, targetLoudness?: number, postProcess?: AudioPostProcess): Promise<ResultCodeV0_16 & Result<Buffer> & PerfResult>;
+
+  /**
+   * AudioQueryのJSONを読み込み、ネイティブ側で保持する。
+   *
+   * 保持したAudioQueryは`voicevoxAudioQuerySetMoraPitchV0_16`などで書き換え、`voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16`で合成する。JSONにするのは合成するときと`voicevoxAudioQueryToJsonV0_16`を呼んだときだけ。
+   * 解放は`voicevoxAudioQueryDeleteV0_16`で行う。
+   *
+   * @param {string} audioQueryJson AudioQueryのJSON
+   * @param {number} audioQueryPointerName 設定するポインタ名
+   *
+   * 解釈できないJSONの場合は例外を発生する。
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQueryNewV0_16(audioQueryJson: string, audioQueryPointerName: number): {};
+
+  /**
+   * 日本語テキストからAudioQueryを生成し、ネイティブ側で保持する(`voicevoxSynthesizerCreateAudioQueryV0_16`と同じくテキスト解析の結果を使い回す)。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {string} text UTF-8の日本語テキスト
+   * @param {number} styleId スタイルID
+   * @param {number} audioQueryPointerName 設定するポインタ名。失敗した場合は設定しない
+   *
+   * @returns 結果コード
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerCreateAudioQueryHandleV0_16(synthesizerPointerName: number, text: string, styleId: number, audioQueryPointerName: number): ResultCodeV0_16 & PerfResult;
+
+  /**
+   * 保持しているAudioQueryをJSONにする。
+   *
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   *
+   * @returns AudioQueryのJSON
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQueryToJsonV0_16(audioQueryPointerName: number): Result<string>;
+
+  /**
+   * 保持しているAudioQueryのモーラを、項目ごとの配列で取得する。
+   *
+   * モーラはアクセント句の順に並び、句読点のモーラ(`pause_mora`)はそのアクセント句の最後に置かれる。
+   *
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   *
+   * @returns モーラ
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQueryGetMorasV0_16(audioQueryPointerName: number): Result<AudioQueryMoras>;
+
+  /**
+   * 保持しているAudioQueryのモーラの音高を設定する。
+   *
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} moraIndex `voicevoxAudioQueryGetMorasV0_16`でのモーラの位置
+   * @param {number} pitch 音高
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQuerySetMoraPitchV0_16(audioQueryPointerName: number, moraIndex: number, pitch: number): {};
+
+  /**
+   * 保持しているAudioQueryのモーラの長さを設定する。
+   *
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} moraIndex `voicevoxAudioQueryGetMorasV0_16`でのモーラの位置
+   * @param {number} consonantLength 子音の長さ。`NaN`なら変更しない。子音の無いモーラでは無視する
+   * @param {number} vowelLength 母音の長さ。`NaN`なら変更しない
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQuerySetMoraLengthV0_16(audioQueryPointerName: number, moraIndex: number, consonantLength: number, vowelLength: number): {};
+
+  /**
+   * 保持しているAudioQueryの全てのモーラの音高を設定する。
+   *
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {Float64Array} pitches モーラの数と同じ長さの音高
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQuerySetPitchesV0_16(audioQueryPointerName: number, pitches: Float64Array): {};
+
+  /**
+   * 保持しているAudioQueryの全体の値を設定する。
+   *
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {string} key `speedScale`, `pitchScale`, `intonationScale`, `volumeScale`, `prePhonemeLength`, `postPhonemeLength`, `outputSamplingRate`のいずれか
+   * @param {number} value 値
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQuerySetScaleV0_16(audioQueryPointerName: number, key: string, value: number): {};
+
+  /**
+   * 保持しているAudioQueryのアクセント句の音高・音素長を、特定の声で生成しなおす。結果はJSにせず、そのまま保持する。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} styleId スタイルID
+   * @param {number} kind `0`なら音高と音素長(`voicevoxSynthesizerReplaceMoraDataV0_16`)、`1`なら音素長(`voicevoxSynthesizerReplacePhonemeLengthV0_16`)、`2`なら音高(`voicevoxSynthesizerReplaceMoraPitchV0_16`)
+   *
+   * @returns 結果コード。失敗した場合は元のまま
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerAudioQueryReplaceV0_16(synthesizerPointerName: number, audioQueryPointerName: number, styleId: number, kind: number): ResultCodeV0_16 & PerfResult;
+
+  /**
+   * 保持しているAudioQueryから、スレッドプールで音声合成を行う。
+   *
+   * 呼び出した時点のAudioQueryをJSONにして合成するため、完了を待たずにAudioQueryを変更・破棄してよい。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} styleId スタイルID
+   * @param {boolean} enableInterrogativeUpspeak 疑問文の調整を有効にする
+   * @param {number} outputSamplingRate 0以外を指定すると、合成したWAVをワーカースレッドでこのサンプリングレートに変換してから返す(`resampleWavAsync`と同じ)
+   * @param {number} outputFormat 0: WAV, 1: G.711 μ-law, 2: G.711 A-law, 3: ヘッダの無い16ビットリニアPCM, 4: 大きさの欄が長さ未定(0xFFFFFFFF)のWAV。G.711ではヘッダの無いモノラルのバイト列を返し、`outputSamplingRate`が0なら8000Hzとする
+   * @param {number} targetLoudness 指定すると、ラウドネス(LUFS、-70から0)をこの値に揃える(EBU R128のIntegrated Loudnessを測り、利得と-1dBFSのピークリミッタをかける)
+   * @param {AudioPostProcess} postProcess 後処理(無音の切り詰め・フェード・無音の追加)。出力形式の変換と同じ1回の走査で、切り詰め→サンプリングレートの変換→正規化→フェード→無音の追加の順にかける
+   *
+   * @returns 結果コード, WAVデータ(`outputFormat`がG.711の場合はそのバイト列)
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16(synthesizerPointerName: number, audioQueryPointerName: number, styleId: number, enableInterrogativeUpspeak: boolean, outputSamplingRate?: number, outputFormat?: number, targetLoudness?: number, postProcess?: AudioPostProcess): Promise<ResultCodeV0_16 & Result<Buffer> & PerfResult>;
+
+  /**
+   * 保持しているAudioQueryから、スレッドプールで音声合成を行い、決まった長さのフレームに区切って`onFrames`に渡す。
+   *
+   * 合成・変換の後、専用のスレッドが`framesPerBatch`フレームずつ1つのBufferにまとめて`onFrames`を呼ぶ。最後のフレームは無音で埋める。
+   * `pace`が`true`の場合は、各バッチをその最初のフレームの再生時刻(最初のバッチを渡した時点から数える)まで待ってから渡す。
+   * `onFrames`が`false`を返すと以降は渡さず、例外を投げた場合はその例外でPromiseがrejectされる。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} styleId スタイルID
+   * @param {boolean} enableInterrogativeUpspeak 疑問文の調整を有効にする
+   * @param {number} outputSamplingRate 0以外を指定すると、このサンプリングレートに変換する
+   * @param {number} outputFormat 1: G.711 μ-law, 2: G.711 A-law, 3: 16ビットリニアPCM(0と4のWAVは使えない)
+   * @param {number} frameMs 1フレームの長さ(ミリ秒)。サンプリングレートとの積が1000の倍数でない場合はPromiseがrejectされる
+   * @param {number} framesPerBatch 1回の呼び出しで渡すフレームの数
+   * @param {boolean} pace 実時間で送出する
+   * @param onFrames フレームを受け取るコールバック
+   * @param {number} targetLoudness 指定すると、ラウドネス(LUFS、-70から0)をこの値に揃える(EBU R128のIntegrated Loudnessを測り、利得と-1dBFSのピークリミッタをかける)
+   * @param {AudioPostProcess} postProcess 後処理(無音の切り詰め・フェード・無音の追加)。出力形式の変換と同じ1回の走査で、切り詰め→サンプリングレートの変換→正規化→フェード→無音の追加の順にかける
+   *
+   * @returns 結果コード, 渡したフレームの数と中止したかどうか。全て渡し終えるか中止した時点で解決される
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerSynthesisFramesAsyncV0_16(
+    synthesizerPointerName: number,
+    audioQueryPointerName: number,
+    styleId: number,
+    enableInterrogativeUpspeak: boolean,
+    outputSamplingRate: number,
+    outputFormat: number,
+    frameMs: number,
+    framesPerBatch: number,
+    pace: boolean,
+    onFrames: (batch: Buffer, frames: number) => boolean | void,
+    targetLoudness?: number,
+    postProcess?: AudioPostProcess
+  ): Promise<ResultCodeV0_16 & Result<{ frames: number; cancelled: boolean }> & PerfResult>;
+
+  /**
+   * 保持しているAudioQueryから、スレッドプールで音声合成を行い、ファイルに書き込む。
+   *
+   * 変換しながら64KiBずつ同じディレクトリの一時ファイル(`path + ".<pid>.<連番>.tmp"`)に書き込み、最後に`path`を置き換える。音声のBufferは作らない。
+   * 書き込みに失敗した場合はPromiseがrejectされ、`path`は元のまま残る。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} styleId スタイルID
+   * @param {boolean} enableInterrogativeUpspeak 疑問文の調整を有効にする
+   * @param {number} outputSamplingRate 0以外を指定すると、このサンプリングレートに変換する
+   * @param {number} outputFormat 0: WAV, 1: G.711 μ-law, 2: G.711 A-law, 3: 16ビットリニアPCM(1から3はヘッダ無し), 4: 大きさの欄が長さ未定(0xFFFFFFFF)のWAV
+   * @param {string} path 書き込むファイル
+   * @param {boolean} patchWavHeader `outputFormat`が4の場合に、大きさの欄を本当の値にする
+   * @param {number} targetLoudness 指定すると、ラウドネス(LUFS、-70から0)をこの値に揃える(EBU R128のIntegrated Loudnessを測り、利得と-1dBFSのピークリミッタをかける)
+   * @param {AudioPostProcess} postProcess 後処理(無音の切り詰め・フェード・無音の追加)。出力形式の変換と同じ1回の走査で、切り詰め→サンプリングレートの変換→正規化→フェード→無音の追加の順にかける
+   *
+   * @returns 結果コード, 書き込んだバイト数と音声の長さ(ミリ秒)
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerSynthesisToFileAsyncV0_16(
+    synthesizerPointerName: number,
+    audioQueryPointerName: number,
+    styleId: number,
+    enableInterrogativeUpspeak: boolean,
+    outputSamplingRate: number,
+    outputFormat: number,
+    path: string,
+    patchWavHeader: boolean,
+    targetLoudness?: number,
+    postProcess?: AudioPostProcess
+  ): Promise<ResultCodeV0_16 & Result<{ bytes: number; durationMs: number }> & PerfResult>;
+
+  /**
+   * 保持しているAudioQueryから音声合成を行い、ファイルディスクリプタ(ファイル・パイプ・ソケット)へ直接書き込む。
+   *
+   * 合成・変換・書き込みは専用のスレッドで行い、16KiBのチャンクを最大8個ずつ`writev`で書く。音声のBufferは作らない。
+   * 非ブロッキングのディスクリプタで書き込めない間は`poll`で待つ(相手が読むまで待つ間もスレッドプールは塞がない)。
+   * 書き込みに失敗した場合(相手が閉じた・待ち時間が上限を超えたなど)はPromiseがrejectされる。`fd`は閉じない。
+   * Windowsではファイルのディスクリプタにのみ書き込める。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} styleId スタイルID
+   * @param {boolean} enableInterrogativeUpspeak 疑問文の調整を有効にする
+   * @param {number} outputSamplingRate 0以外を指定すると、このサンプリングレートに変換する
+   * @param {number} outputFormat 0: WAV, 1: G.711 μ-law, 2: G.711 A-law, 3: 16ビットリニアPCM(1から3はヘッダ無し), 4: 大きさの欄が長さ未定(0xFFFFFFFF)のWAV
+   * @param {number} fd 書き込むファイルディスクリプタ
+   * @param {number} timeoutMs 書き込めるようになるまで待つ時間の上限(ミリ秒)。0の場合は無制限
+   * @param {boolean} patchWavHeader `outputFormat`が4の場合に、書き終えてから`fd`の書き始めの位置にあるヘッダの大きさの欄を書き換える(シークできない場合はreject)
+   * @param {number} targetLoudness 指定すると、ラウドネス(LUFS、-70から0)をこの値に揃える(EBU R128のIntegrated Loudnessを測り、利得と-1dBFSのピークリミッタをかける)
+   * @param {AudioPostProcess} postProcess 後処理(無音の切り詰め・フェード・無音の追加)。出力形式の変換と同じ1回の走査で、切り詰め→サンプリングレートの変換→正規化→フェード→無音の追加の順にかける
+   *
+   * @returns 結果コード, 書き込んだバイト数と音声の長さ(ミリ秒)
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerSynthesisToFdAsyncV0_16(
+    synthesizerPointerName: number,
+    audioQueryPointerName: number,
+    styleId: number,
+    enableInterrogativeUpspeak: boolean,
+    outputSamplingRate: number,
+    outputFormat: number,
+    fd: number,
+    timeoutMs: number,
+    patchWavHeader: boolean,
+    targetLoudness?: number,
+    postProcess?: AudioPostProcess
+  ): Promise<ResultCodeV0_16 & Result<{ bytes: number; durationMs: number }> & PerfResult>;
+
+  /**
+   * 保持しているAudioQueryから音声合成を行い、容量の決まったリングバッファに少しずつ書き込む。`voicevoxPcmStreamReadV0_16`で読み出す。
+   *
+   * 合成・変換・書き込みは専用のスレッドで行う。リングバッファが一杯の間は、読み出されるまで変換・書き込みを止める。
+   * 読み出しが空を返した後に書き込まれると`onReadable`が呼ばれる(書き込みを終えたときも呼ばれる)。
+   * 読み出しを終えたら、途中でも`voicevoxPcmStreamDeleteV0_16`で破棄すること。
+   *
+   * @param {number} synthesizerPointerName 音声シンセサイザポインタ名
+   * @param {number} audioQueryPointerName AudioQueryポインタ名
+   * @param {number} styleId スタイルID
+   * @param {boolean} enableInterrogativeUpspeak 疑問文の調整を有効にする
+   * @param {number} outputSamplingRate 0以外を指定すると、このサンプリングレートに変換する
+   * @param {number} outputFormat 0: WAV(全体の長さ入りのヘッダを最初に書く), 1: G.711 μ-law, 2: G.711 A-law, 3: 16ビットリニアPCM, 4: WAV(長さ未定のヘッダを最初のPCMと一緒に書く)
+   * @param {number} ringBytes リングバッファの容量。2のべき乗に切り上げる(4096以上)
+   * @param {number} streamPointerName 作成するストリームのポインタ名
+   * @param onReadable 読み出せるようになったときに呼ばれる
+   * @param {number} targetLoudness 指定すると、ラウドネス(LUFS、-70から0)をこの値に揃える(EBU R128のIntegrated Loudnessを測り、利得と-1dBFSのピークリミッタをかける)
+   * @param {AudioPostProcess} postProcess 後処理(無音の切り詰め・フェード・無音の追加)。出力形式の変換と同じ1回の走査で、切り詰め→サンプリングレートの変換→正規化→フェード→無音の追加の順にかける
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxSynthesizerSynthesisStreamV0_16(
+    synthesizerPointerName: number,
+    audioQueryPointerName: number,
+    styleId: number,
+    enableInterrogativeUpspeak: boolean,
+    outputSamplingRate: number,
+    outputFormat: number,
+    ringBytes: number,
+    streamPointerName: number,
+    onReadable: () => void,
+    targetLoudness?: number,
+    postProcess?: AudioPostProcess
+  ): {};
+
+  /**
+   * ストリームから最大`maxBytes`バイト読み出す。
+   *
+   * @param {number} streamPointerName ストリームのポインタ名
+   * @param {number} maxBytes 読み出す最大のバイト数
+   *
+   * @returns `result`: 読み出したデータ。空の場合は`null`で、書き込まれると`onReadable`が呼ばれる。
+   * `ended`: 全て読み出し終えたかどうか。終えた場合の`resultCode`は合成の結果コード。
+   * 変換に失敗していた場合は例外が発生する。
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxPcmStreamReadV0_16(streamPointerName: number, maxBytes: number): ResultCodeV0_16 & Result<Buffer | null> & { ended: boolean };
+
+  /**
+   * ストリームを破棄する。書き込み中であれば中止する。
+   *
+   * @param {number} streamPointerName ストリームのポインタ名
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxPcmStreamDeleteV0_16(streamPointerName: number): {};
+
+  /**
+   * 保持しているAudioQueryを破棄する。
+   *
+   * @param {number} audioQueryPointerName 破棄対象AudioQueryポインタ名
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxAudioQueryDeleteV0_16(audioQueryPointerName: number): {};
 
   /**
    * 結果コードに対応したメッセージ文字列を取得する。
@@ -615,6 +1008,30 @@ export declare class VoicevoxCore {
    */
   voicevoxUserDictAddWordV0_16(userDictPointerName: number, surface: string, pronunciation: string, accentType: number, priority: number, wordType: number): ResultCodeV0_16 & Result<Buffer>;
 
+  /**
+   * ユーザー辞書に複数の単語を追加する。`voicevoxUserDictAddWordV0_16`を列の長さの分だけスレッドプールでまとめて実行する。
+   *
+   * 各列の長さは揃えること。途中で失敗した場合は、それまでに追加した単語を取り除いてから結果を返す。
+   * 完了するまで、`userDictPointerName`は解放できない(`voicevoxUserDictDeleteV0_16`が例外を発生する)。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {Array<string>} surfaces 表記
+   * @param {Array<string>} pronunciations 読み
+   * @param {Uint32Array} accentTypes アクセント型
+   * @param {Uint32Array} priorities 優先度
+   * @param {Uint32Array} wordTypes 単語の種類
+   *
+   * @returns 結果コード, 追加した単語のUUIDを順に並べたもの(16バイト×単語数), 失敗した場合はその単語の位置
+   *
+   * \safety{
+   * - `userDictPointerName`は`voicevoxUserDictNewV0_16`で設定したものでなければならず、また`voicevoxUserDictDeleteV0_16`で解放されていてはいけない。
+   *
+   * }
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictAddWordsAsyncV0_16(userDictPointerName: number, surfaces: Array<string>, pronunciations: Array<string>, accentTypes: Uint32Array, priorities: Uint32Array, wordTypes: Uint32Array): Promise<ResultCodeV0_16 & Result<Buffer> & { failedIndex?: number }>;
+
   /**
    * ユーザー辞書の単語を更新する。
    *
@@ -718,6 +1135,114 @@ export declare class VoicevoxCore {
    */
   voicevoxUserDictDeleteV0_16(userDictPointerName: number): {};
 
+  /**
+   * ユーザー辞書の単語をUUIDで探す。
+   *
+   * `voicevoxUserDictToJsonV0_16`を使わず、このライブラリが辞書と並行して持つ索引から探す。索引は単語の追加・更新・削除と辞書の読み込み・インポートの度に更新される。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {Buffer} wordUuid 単語のUUID
+   * @returns 単語。見つからない場合は`result`が無い
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictFindWordV0_16(userDictPointerName: number, wordUuid: Buffer): Partial<Result<UserDictIndexWord>>;
+
+  /**
+   * ユーザー辞書から表記が一致する単語を探す。
+   *
+   * 表記はvoicevox_coreと同じく全角に変換してから比べる。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {string} surface 表記
+   * @returns 一致した単語
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictFindWordsBySurfaceV0_16(userDictPointerName: number, surface: string): Result<Array<UserDictIndexWord>>;
+
+  /**
+   * ユーザー辞書から表記が前方一致する単語を、表記の昇順(UTF-8のバイト順)に探す。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {string} prefix 表記の先頭
+   * @param {number} limit 最大件数
+   * @returns 一致した単語
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictFindWordsByPrefixV0_16(userDictPointerName: number, prefix: string, limit: number): Result<Array<UserDictIndexWord>>;
+
+  /**
+   * ユーザー辞書をバイナリのスナップショットとして保存する。
+   *
+   * JSONを経由せず、このライブラリが持つ索引から呼び出した時点の内容を組み立て、スレッドプールで書き込む。
+   * 一時ファイルに書き込んでから置き換えるため、途中で失敗しても`path`が壊れることはない。
+   * 書き込めなかった場合はrejectする。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {string} path 保存先のパス
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictSaveSnapshotAsyncV0_16(userDictPointerName: number, path: string): Promise<{}>;
+
+  /**
+   * `voicevoxUserDictSaveSnapshotAsyncV0_16`で保存したスナップショットの単語をユーザー辞書に追加する。
+   *
+   * ファイルをmmapしてチェックサムを確かめ、スレッドプールで単語をまとめて追加する(`voicevoxUserDictAddWordsAsyncV0_16`と同じく、失敗した場合は追加した単語を取り除く)。
+   * 単語のUUIDはvoicevox_coreが新しく割り当てるため、スナップショットでのUUIDとは異なる。
+   * ファイルを読めない・形式が違う・チェックサムが合わない場合はrejectする。
+   * 完了するまで、`userDictPointerName`は解放できない。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {string} path スナップショットのパス
+   * @returns 結果コード, 追加した単語のUUIDを順に並べたもの, それぞれのスナップショットでのUUIDを同じ順に並べたもの, 失敗した場合はその単語の位置
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictLoadSnapshotAsyncV0_16(userDictPointerName: number, path: string): Promise<ResultCodeV0_16 & Partial<Result<Buffer>> & { snapshotWordUuids?: Buffer; failedIndex?: number }>;
+
+  /**
+   * `voicevoxUserDictLoadV0_16`をスレッドプールで行う。
+   *
+   * 索引の作り直しもスレッドプールで行う。完了するまで、`userDictPointerName`は解放できない。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {string} dictPath 読み込む辞書ファイルのパス
+   * @returns 結果コード
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictLoadAsyncV0_16(userDictPointerName: number, dictPath: string): Promise<ResultCodeV0_16>;
+
+  /**
+   * `voicevoxUserDictSaveV0_16`をスレッドプールで行う。
+   *
+   * 同じディレクトリの一時ファイル(`path + ".<pid>.<連番>.tmp"`)に書き込んでから置き換えるため、途中で失敗しても`path`が書きかけになることはない。
+   * 置き換えられなかった場合はrejectする。完了するまで、`userDictPointerName`は解放できない。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {string} path 保存先のファイルパス
+   * @returns 結果コード
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictSaveAsyncV0_16(userDictPointerName: number, path: string): Promise<ResultCodeV0_16>;
+
+  /**
+   * `voicevoxUserDictImportV0_16`をスレッドプールで行う。
+   *
+   * 完了するまで、`userDictPointerName`と`otherDictPointerName`は解放できない。
+   *
+   * @param {number} userDictPointerName ユーザー辞書ポインタ名
+   * @param {number} otherDictPointerName インポートするユーザー辞書ポインタ名
+   * @returns 結果コード
+   *
+   * この関数はv0.16.xで利用できます
+   */
+  voicevoxUserDictImportAsyncV0_16(userDictPointerName: number, otherDictPointerName: number): Promise<ResultCodeV0_16>;
+
   /**
    * 初期化する
    * @param accelerationMode ハードウェアアクセラレーションモード
@@ -1092,12 +1617,237 @@ export declare class VoicevoxCore {
    * この関数はv0.5.x, v0.6.x, v0.7.xで利用できます
    */
   decodeForwardV0_5(f0: Array<number>, phoneme: Array<number>, speakerId: number): Result<Array<number>> & Result2;
+
+  /**
+   * このプロセスでmallocにより確保されているバイト数を取得する。voicevox_coreが確保したものも含む。
+   * @returns バイト数。取得できない環境(Windowsなど)では`-1`
+   *
+   * リーク検出用。voicevox_coreのバージョンに関係なく利用できます
+   */
+  nativeHeapUsage(): Result<number>;
+
+  /**
+   * 合成系のバインディング(`voicevoxSynthesizerTtsV0_16`など)の呼び出しの記録を開始する。
+   * 記録は別スレッドで書き込まれ、書き込み待ちが`maxQueueBytes`を超えた分は捨てられる。
+   * 引数・オプション(出力形式・ラウドネス・後処理など)と、どの版(同期版・スレッドプール版・ファイルへの書き込みなど)で呼ばれたかを記録する。
+   * 記録を開始する前に呼び出され、開始した後に完了したものは記録しない。
+   * 記録したファイルは`bench/replay.js`で再生できる。
+   * @param path 書き込むファイル。既にある場合は上書きする
+   * @param maxQueueBytes 書き込み待ちにできる最大のバイト数
+   *
+   * 既に記録中の場合やファイルを開けない場合は例外が発生する。
+   *
+   * voicevox_coreのバージョンに関係なく利用できます(記録されるのはv0.16.xの関数のみ)
+   */
+  captureStart(path: string, maxQueueBytes: number): {};
+
+  /**
+   * 呼び出しの記録を停止する。書き込み待ちの記録は全て書き込んでから戻る。
+   * @returns 記録した件数、捨てた件数、書き込んだバイト数
+   */
+  captureStop(): Result<{ recorded: number; dropped: number; writtenBytes: number }>;
+
+  /**
+   * 合成系のバインディングの計測を有効・無効にする。
+   * 有効にすると、呼び出し毎の計測値が結果の`perf`に設定され、`getStats`で集計を取得できる。有効にした時点で集計は消去される。
+   * Linuxではperf_event_openでサイクル数・命令数・キャッシュミスを計測する。
+   * カーネルが許可しない場合やLinux以外では、経過時間とコンテキストスイッチ数(Linuxのみ)のみを計測する。
+   * @param enabled 有効にするかどうか
+   * @returns ハードウェアカウンタが使えるかどうか
+   */
+  perfCountersEnable(enabled: boolean): Result<boolean>;
+
+  /**
+   * 統計情報を取得する。
+   * @returns `perf`: `perfCountersEnable`で有効にした計測のバインディング毎の集計
+   */
+  getStats(): Result<Stats>;
+
+  /**
+   * テキスト解析の結果(アクセント句)を保持する件数を設定する。既定は1024件で、0にすると保持しない。
+   *
+   * `voicevoxSynthesizerCreateAudioQueryV0_16`と`voicevoxSynthesizerCreateAccentPhrasesV0_16`は、同じOpenJtalkRc・同じユーザー辞書で解析済みのテキストであれば、
+   * テキスト解析を省き、保持したアクセント句の音高・長さを`voicevox_synthesizer_replace_mora_data`で指定したスタイルのものに置き換えて返す。
+   * ユーザー辞書を設定し直す(`voicevoxOpenJtalkRcUseUserDictV0_16`など)と、そのOpenJtalkRcの解析結果は使われなくなる。
+   * @param capacity 保持する件数
+   */
+  accentPhraseCacheSetCapacity(capacity: number): {};
+
+  /**
+   * テキストとAquesTalk風記法の対応を記録する件数を設定する。既定は0(記録しない)。
+   *
+   * 有効にすると、`voicevoxSynthesizerCreateAudioQueryV0_16`の結果の`kana`を記録し、
+   * 以降の同じテキストの`voicevoxSynthesizerTtsV0_16`・`voicevoxSynthesizerTtsAsyncV0_16`はテキスト解析を省き、AquesTalk風記法から合成する(`voicevox_synthesizer_tts_from_kana`と同じ)。
+   * 記録はOpenJtalkRcとそのユーザー辞書ごとで、ユーザー辞書を設定し直すと使われなくなる。
+   * 省けた時間は`getStats`の`kanaCache.savedNs`で確認できる。
+   * @param capacity 記録する件数
+   */
+  kanaCacheSetCapacity(capacity: number): {};
+
+  /**
+   * 合成結果のBufferの領域を使い回す、戻った領域の合計の上限(バイト)を設定する。既定は0(使い回さない)。
+   *
+   * 有効にすると、`voicevoxSynthesizerSynthesisV0_16`・`voicevoxSynthesizerTtsV0_16`・`voicevoxSynthesizerTtsFromKanaV0_16`・
+   * `voicevoxSynthesizerTtsAsyncV0_16`・`voicevoxSynthesizerSynthesisAudioQueryAsyncV0_16`の結果は、大きさの区分(4KiBから2MiBまでの2のべき乗)ごとの領域に写した外部のBufferになる。
+   * Bufferが回収されるか`bufferPoolRelease`で手放されると、領域は区分に戻って次の結果に使われる。
+   * 上限を下げると、超えた分の戻った領域はすぐに解放する。
+   * @param capacity 戻った領域を保持するバイト数の上限
+   */
+  bufferPoolSetCapacity(capacity: number): {};
+
+  /**
+   * `bufferPoolSetCapacity`で有効にしたプールの結果のBufferを手放し、領域をすぐに区分に戻す。
+   * Bufferの下にあるArrayBufferを切り離すため、そのBufferと、そこから作った`subarray`などは長さ0になる。
+   * @param buffer 手放すBuffer
+   * @returns プールが作ったBufferを手放した場合は`true`(それ以外・手放し済みなら何もせず`false`)
+   */
+  bufferPoolRelease(buffer: Buffer): Result<boolean>;
+
+  /**
+   * 16ビットリニアPCM(リトルエンディアン、チャンネルごとにインターリーブ)のサンプリングレートをスレッドプールで変換する。
+   * ポリフェーズのFIRフィルタ(カイザー窓、片側16零点)で、積和はAVX2+FMA・NEONが使えればそれを使う。
+   * 変換比を既約分数にしたときの分子が1024を超える組は扱えない。
+   * @param pcm PCM。呼び出した時点で複製するため、完了を待たずに書き換えてよい
+   * @param inputRate 入力のサンプリングレート
+   * @param outputRate 出力のサンプリングレート
+   * @param channels チャンネル数
+   * @returns 変換後のPCM
+   *
+   * 扱えないレートの組や、長さがチャンネル数と合わない場合は例外が発生する。
+   *
+   * voicevox_coreのバージョンに関係なく利用できます
+   */
+  resamplePcmAsync(pcm: Buffer, inputRate: number, outputRate: number, channels: number): Promise<Result<Buffer>>;
+
+  /**
+   * 16ビットリニアPCMのWAVのサンプリングレートをスレッドプールで変換する。変換は`resamplePcmAsync`と同じ。
+   * 既に`outputRate`の場合は、ヘッダを書き直して写すだけとなる。
+   * @param wav WAV
+   * @param outputRate 出力のサンプリングレート
+   * @returns 変換後のWAV(44バイトのヘッダ)
+   *
+   * 16ビットリニアPCMのWAVでない場合や、扱えないレートの組の場合はPromiseがrejectされる。
+   *
+   * voicevox_coreのバージョンに関係なく利用できます
+   */
+  resampleWavAsync(wav: Buffer, outputRate: number): Promise<Result<Buffer>>;
 }
 
 interface Result<T> {
   result: T;
 }
 
+interface PerfReading {
+  /** `cycles`, `instructions`, `cacheMisses`が有効かどうか */
+  counters: boolean;
+  wallNs: number;
+  cycles: number;
+  instructions: number;
+  cacheMisses: number;
+  contextSwitches: number;
+}
+
+/**
+ * `perfCountersEnable`で計測を有効にしている場合のみ`perf`が設定される
+ */
+interface PerfResult {
+  perf?: PerfReading;
+}
+
+interface PerfTotals {
+  calls: number;
+  /** ハードウェアカウンタを計測できた呼び出しの数 */
+  counterCalls: number;
+  wallNs: number;
+  cycles: number;
+  instructions: number;
+  cacheMisses: number;
+  contextSwitches: number;
+}
+
+interface Stats {
+  perf: {
+    enabled: boolean;
+    bindings: { [binding: string]: PerfTotals };
+  };
+  /** `accentPhraseCacheSetCapacity`で設定したテキスト解析の結果の保持 */
+  accentPhraseCache: CacheStats;
+  /** `kanaCacheSetCapacity`で設定したAquesTalk風記法の記録。`savedNs`は、記録したときのテキストからのAudioQueryの作成時間と、AquesTalk風記法からの作成時間の差の合計 */
+  kanaCache: CacheStats & { savedNs: number };
+  /** `bufferPoolSetCapacity`で設定した合成結果のBufferの領域の使い回し */
+  bufferPool: BufferPoolStats;
+}
+
+interface BufferPoolStats {
+  capacity: number;
+  /** 戻って保持している領域 */
+  idleBytes: number;
+  idleSlabs: number;
+  /** Bufferとして渡している領域 */
+  outstandingBytes: number;
+  outstandingSlabs: number;
+  /** 戻った領域を使えた数 */
+  hits: number;
+  /** 新しく確保した数 */
+  misses: number;
+  /** 2MiBを超えるため使い回さなかった数 */
+  oversize: number;
+  /** `bufferPoolRelease`で手放された数 */
+  released: number;
+}
+
+interface CacheStats {
+  capacity: number;
+  entries: number;
+  hits: number;
+  misses: number;
+  evictions: number;
+}
+
+/**
+ * ネイティブ側で保持しているAudioQueryのモーラ。添字はモーラの位置
+ */
+interface AudioQueryMoras {
+  text: Array<string>;
+  consonant: Array<string | null>;
+  vowel: Array<string>;
+  /** 子音の無いモーラは`NaN` */
+  consonantLength: Float64Array;
+  vowelLength: Float64Array;
+  pitch: Float64Array;
+  /** 句読点のモーラなら1 */
+  isPause: Uint8Array;
+  /** アクセント句ごとの、そのアクセント句のモーラの終わり(句読点のモーラを含む) */
+  accentPhraseEnds: Uint32Array;
+  /** アクセント句ごとのアクセント位置 */
+  accent: Uint32Array;
+  /** アクセント句ごとの、疑問文かどうか(1なら疑問文) */
+  isInterrogative: Uint8Array;
+}
+
+/**
+ * ユーザー辞書の索引にある単語。表記は全角に変換済み
+ */
+/**
+ * 非同期の合成の後処理(`thresholdDb`はdBFS、長さはミリ秒)
+ */
+interface AudioPostProcess {
+  trim?: { thresholdDb?: number; marginMs?: number };
+  fadeInMs?: number;
+  fadeOutMs?: number;
+  padStartMs?: number;
+  padEndMs?: number;
+}
+
+interface UserDictIndexWord {
+  uuid: Buffer;
+  surface: string;
+  pronunciation: string;
+  accentType: number;
+  wordType: number;
+  priority: number;
+}
+
 type Result2 = { result2: boolean };
 
 interface ResultCodeV0_16 {
@@ -0,0 +1,92 @@
+#include "wav.h"
+#include <cstring>
+
+namespace
+{
+  uint16_t get_u16(const uint8_t *p)
+  {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+  }
+
+  uint32_t get_u32(const uint8_t *p)
+  {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  void set_u16(uint8_t *p, uint16_t value)
+  {
+    p[0] = static_cast<uint8_t>(value & 0xff);
+    p[1] = static_cast<uint8_t>(value >> 8);
+  }
+
+  void set_u32(uint8_t *p, uint32_t value)
+  {
+    for (int i = 0; i < 4; i++)
+      p[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xff);
+  }
+}
+
+bool wav_parse(const uint8_t *wav, size_t size, WavFormat &format, std::string &error)
+{
+  if (size < 12 || std::memcmp(wav, "RIFF", 4) != 0 || std::memcmp(wav + 8, "WAVE", 4) != 0)
+  {
+    error = "WAVではありません";
+    return false;
+  }
+  bool has_fmt = false;
+  size_t offset = 12;
+  while (offset + 8 <= size)
+  {
+    const uint8_t *chunk = wav + offset;
+    size_t chunk_size = get_u32(chunk + 4);
+    size_t body = offset + 8;
+    if (std::memcmp(chunk, "fmt ", 4) == 0)
+    {
+      if (chunk_size < 16 || body + 16 > size)
+        break;
+      format.format = get_u16(wav + body);
+      format.channels = get_u16(wav + body + 2);
+      format.sample_rate = get_u32(wav + body + 4);
+      format.bits_per_sample = get_u16(wav + body + 14);
+      has_fmt = true;
+    }
+    else if (std::memcmp(chunk, "data", 4) == 0)
+    {
+      if (!has_fmt)
+        break;
+      format.data_offset = body;
+      // 書き込み途中などで大きさが実際より大きい場合は、あるところまでとする
+      format.data_size = chunk_size <= size - body ? chunk_size : size - body;
+      return true;
+    }
+    // チャンクは2バイト境界に揃う
+    offset = body + chunk_size + (chunk_size & 1);
+  }
+  error = has_fmt ? "WAVにdataチャンクがありません" : "WAVにfmtチャンクがありません";
+  return false;
+}
+
+void wav_write_header(uint8_t *out, uint16_t format, uint16_t channels, uint32_t sample_rate, uint16_t bits_per_sample, uint32_t data_size)
+{
+  uint16_t block_align = static_cast<uint16_t>(channels * (bits_per_sample / 8));
+  std::memcpy(out, "RIFF", 4);
+  set_u32(out + 4, 36 + data_size);
+  std::memcpy(out + 8, "WAVE", 4);
+  std::memcpy(out + 12, "fmt ", 4);
+  set_u32(out + 16, 16);
+  set_u16(out + 20, format);
+  set_u16(out + 22, channels);
+  set_u32(out + 24, sample_rate);
+  set_u32(out + 28, sample_rate * block_align);
+  set_u16(out + 32, block_align);
+  set_u16(out + 34, bits_per_sample);
+  std::memcpy(out + 36, "data", 4);
+  set_u32(out + 40, data_size);
+}
+
+void wav_write_streaming_header(uint8_t *out, uint16_t format, uint16_t channels, uint32_t sample_rate, uint16_t bits_per_sample)
+{
+  wav_write_header(out, format, channels, sample_rate, bits_per_sample, 0);
+  set_u32(out + 4, WAV_STREAMING_SIZE);
+  set_u32(out + 40, WAV_STREAMING_SIZE);
+}
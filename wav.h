@@ -0,0 +1,51 @@
+/**
+ * @file wav.h
+ *
+ * voicevox_coreが出力するWAV(リニアPCM)の読み書き。
+ *
+ * 読む側は`fmt `と`data`のチャンクだけを見て、それ以外のチャンクは読み飛ばす。
+ * 書く側は常に44バイトの標準的なヘッダを書く。リトルエンディアンの環境でのみ使えること。
+ * 全体の長さが決まる前に流し始める場合は、大きさの欄を::WAV_STREAMING_SIZE にしたヘッダを書く(多くのプレーヤーは終わりまで読む)。
+ */
+#ifndef VOICEVOX_WAV
+#define VOICEVOX_WAV
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define WAV_HEADER_SIZE 44
+#define WAV_FORMAT_PCM 1
+#define WAV_FORMAT_ALAW 6
+#define WAV_FORMAT_MULAW 7
+// 長さが決まっていないことを表す、RIFFとdataチャンクの大きさ
+#define WAV_STREAMING_SIZE 0xFFFFFFFFu
+
+struct WavFormat
+{
+  uint16_t format;
+  uint16_t channels;
+  uint32_t sample_rate;
+  uint16_t bits_per_sample;
+  /** `data`チャンクの中身の位置とバイト数 */
+  size_t data_offset;
+  size_t data_size;
+};
+
+/**
+ * WAVのヘッダを解釈する
+ * @return RIFF/WAVEでない・`fmt `か`data`が無い場合は`false`を返し、`error`に理由を設定する
+ */
+bool wav_parse(const uint8_t *wav, size_t size, WavFormat &format, std::string &error);
+
+/**
+ * `out`に::WAV_HEADER_SIZE バイトのヘッダを書く
+ */
+void wav_write_header(uint8_t *out, uint16_t format, uint16_t channels, uint32_t sample_rate, uint16_t bits_per_sample, uint32_t data_size);
+
+/**
+ * `out`に、大きさの欄を::WAV_STREAMING_SIZE にした::WAV_HEADER_SIZE バイトのヘッダを書く
+ */
+void wav_write_streaming_header(uint8_t *out, uint16_t format, uint16_t channels, uint32_t sample_rate, uint16_t bits_per_sample);
+
+#endif /* VOICEVOX_WAV */